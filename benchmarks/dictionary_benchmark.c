@@ -0,0 +1,179 @@
+/**
+ * @file dictionary_benchmark.c
+ * @author chcp (cmewhou@yandex.ru)
+ * @brief Dictionary benchmarks.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#include "utils/timer.h"
+
+#include <dictionary.h>
+#include <unrolled_dictionary.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ **********************************************************************************************/
+
+/**
+ * @brief Create dictionary filled with pseudo-random values.
+ *
+ * @param size Count of records.
+ * @return Dictionary.
+ */
+static p_dictionary create_random_dictionary(int size);
+
+/**
+ * @brief Compare records by value.
+ *
+ * @param record1 Record 1.
+ * @param record2 Record 2.
+ * @return 1 if first value is greater, 0 otherwise.
+ */
+static int sort_by_value_callback(const p_record record1, const p_record record2);
+
+/**
+ * @brief Sum values.
+ *
+ * @param value Record value.
+ * @param args Sum.
+ */
+static void sum_values_callback(void *value, void *args);
+
+/*********************************************************************************************
+ * FUNCTIONS DECLARATIONS
+ ********************************************************************************************/
+
+/** @brief Sort scaling benchmark. */
+void dictionary_sort_benchmark(void);
+
+/** @brief Positional access benchmark. */
+void dictionary_position_benchmark(void);
+
+/** @brief Append and iterate benchmark. */
+void dictionary_append_benchmark(void);
+
+/*********************************************************************************************
+ * FUNCTIONS DEFINITIONS
+ ********************************************************************************************/
+
+int dictionary_benchmark(int argc, char *argv[]) {
+    dictionary_sort_benchmark();
+    dictionary_position_benchmark();
+    dictionary_append_benchmark();
+
+    return 0;
+}
+
+void dictionary_sort_benchmark(void) {
+    const int sizes[] = {1000, 10000, 100000, 1000000};
+
+    printf("%-24s %10s %12s %12s\n", "algorithm", "records", "copy, ms", "in place, ms");
+    for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++) {
+        p_dictionary dict = create_random_dictionary(sizes[i]);
+
+        uint64_t start = get_time_ns();
+        p_dictionary sorted = sort_dictionary(dict, sort_by_value_callback);
+        double copy_ms = get_elapsed_ms(start);
+
+        start = get_time_ns();
+        sort_dictionary_in_place(dict, sort_by_value_callback);
+        double in_place_ms = get_elapsed_ms(start);
+
+        printf("%-24s %10d %12.2f %12.2f\n", "merge sort", sizes[i], copy_ms, in_place_ms);
+        delete_dictionary(sorted);
+        delete_dictionary(dict);
+    }
+}
+
+void dictionary_position_benchmark(void) {
+    const int sizes[] = {1000, 10000, 20000};
+    const int modes[] = {DICTIONARY_MODE_DEFAULT, DICTIONARY_MODE_POSITION_INDEX};
+    const char *names[] = {"linked list", "position index"};
+
+    printf("%-24s %10s %12s %12s\n", "mode", "records", "insert, ms", "lookup, ms");
+    for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++) {
+        for (int j = 0; j < (int)(sizeof(modes) / sizeof(modes[0])); j++) {
+            p_dictionary dict = create_dictionary_with_mode(modes[j], NULL);
+
+            uint64_t start = get_time_ns();
+            for (int k = 0; k < sizes[i]; k++)
+                add_record_to_dictionary_by_index(dict, k / 2, "key", (void *)(intptr_t)k);
+            double insert_ms = get_elapsed_ms(start);
+
+            start = get_time_ns();
+            for (int k = 0; k < sizes[i]; k++)
+                get_record_from_dictionary_by_index(dict, (k * 7919) % sizes[i]);
+            double lookup_ms = get_elapsed_ms(start);
+
+            printf("%-24s %10d %12.2f %12.2f\n", names[j], sizes[i], insert_ms, lookup_ms);
+            delete_dictionary(dict);
+        }
+    }
+}
+
+void dictionary_append_benchmark(void) {
+    const int sizes[] = {1000, 100000, 1000000};
+    const int modes[] = {DICTIONARY_MODE_DEFAULT, DICTIONARY_MODE_RECORD_POOL};
+    const char *names[] = {"linked list", "record pool", "unrolled list"};
+
+    printf("%-24s %10s %12s %12s\n", "storage", "records", "append, ms", "iterate, ms");
+    for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++) {
+        for (int j = 0; j < (int)(sizeof(names) / sizeof(names[0])); j++) {
+            int is_unrolled = j == (int)(sizeof(modes) / sizeof(modes[0]));
+            p_dictionary dict = is_unrolled ? NULL : create_dictionary_with_mode(modes[j], NULL);
+            p_unrolled_dictionary unrolled = is_unrolled ? create_unrolled_dictionary() : NULL;
+
+            uint64_t start = get_time_ns();
+            for (int k = 0; k < sizes[i]; k++) {
+                if (is_unrolled)
+                    add_record_to_unrolled_dictionary(unrolled, "key", (void *)(intptr_t)k);
+                else
+                    add_record_to_dictionary(dict, "key", (void *)(intptr_t)k);
+            }
+            double append_ms = get_elapsed_ms(start);
+
+            intptr_t sum = 0;
+            start = get_time_ns();
+            if (is_unrolled)
+                iterate_over_unrolled_dictionary_values_with_args(unrolled, sum_values_callback, &sum);
+            else
+                iterate_over_dictionary_values_with_args(dict, sum_values_callback, &sum);
+            double iterate_ms = get_elapsed_ms(start);
+
+            printf("%-24s %10d %12.2f %12.2f\n", names[j], sizes[i], append_ms, iterate_ms);
+            delete_dictionary(dict);
+            delete_unrolled_dictionary(unrolled);
+        }
+    }
+}
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DEFINITIONS
+ **********************************************************************************************/
+
+static p_dictionary create_random_dictionary(int size) {
+    p_dictionary dict = create_dictionary();
+    uint32_t seed = 2463534242u;
+    for (int i = 0; i < size; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        add_record_to_dictionary(dict, "key", (void *)(intptr_t)seed);
+    }
+    return dict;
+}
+
+static int sort_by_value_callback(const p_record record1, const p_record record2) {
+    return (intptr_t)record1->value > (intptr_t)record2->value;
+}
+
+static void sum_values_callback(void *value, void *args) {
+    *(intptr_t *)args += (intptr_t)value;
+}
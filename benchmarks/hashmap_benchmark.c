@@ -0,0 +1,229 @@
+/**
+ * @file hashmap_benchmark.c
+ * @author chcp (cmewhou@yandex.ru)
+ * @brief Hashmap benchmarks.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#include "utils/timer.h"
+
+#include <hashmap.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*********************************************************************************************
+ * MACROS DECLARATIONS
+ ********************************************************************************************/
+
+#define HASHMAP_BENCHMARK_KEY_SIZE 16
+#define HASHMAP_BENCHMARK_RUNS 5
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ **********************************************************************************************/
+
+/**
+ * @brief Create keys "key0", "key1", ... in one block.
+ *
+ * @param count Count of keys.
+ * @return Keys block, key i starts at i * HASHMAP_BENCHMARK_KEY_SIZE.
+ */
+static char *create_keys(int count);
+
+/**
+ * @brief Create scattered visiting order of keys.
+ *
+ * @details
+ * Order is computed up front, so timed loops do not divide per lookup.
+ *
+ * @param count Count of lookups.
+ * @param range Count of keys.
+ * @return Key indexes, each below range.
+ */
+static int *create_order(int count, int range);
+
+/**
+ * @brief Measure string key lookups.
+ *
+ * @param map Hashmap.
+ * @param keys Keys block.
+ * @param order Key indexes to look up.
+ * @param count Count of lookups.
+ * @return Best time of HASHMAP_BENCHMARK_RUNS runs in milliseconds.
+ */
+static double measure_lookups(p_hashmap map, const char *keys, const int *order, int count);
+
+/**
+ * @brief Measure integer key lookups.
+ *
+ * @param map Hashmap.
+ * @param order Keys to look up.
+ * @param count Count of lookups.
+ * @return Best time of HASHMAP_BENCHMARK_RUNS runs in milliseconds.
+ */
+static double measure_u64_lookups(p_hashmap_u64 map, const int *order, int count);
+
+/*********************************************************************************************
+ * FUNCTIONS DECLARATIONS
+ ********************************************************************************************/
+
+/** @brief Insert and lookup throughput benchmark. */
+void hashmap_lookup_benchmark(void);
+
+/** @brief String and integer key lookup throughput benchmark on the same ids. */
+void hashmap_integer_key_benchmark(void);
+
+/*********************************************************************************************
+ * FUNCTIONS DEFINITIONS
+ ********************************************************************************************/
+
+int hashmap_benchmark(int argc, char *argv[]) {
+    hashmap_lookup_benchmark();
+    hashmap_integer_key_benchmark();
+
+    return 0;
+}
+
+void hashmap_lookup_benchmark(void) {
+    const int sizes[] = {1000, 100000, 1000000, 10000000};
+    const int lookups = 10000000;
+    const int max_missing = 1000000;
+
+    printf("%-24s %10s %12s %12s %12s\n", "hashmap", "keys", "insert, ms", "hit, Mops/s", "miss, Mops/s");
+    for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++) {
+        const int missing_count = sizes[i] < max_missing ? sizes[i] : max_missing;
+        char *keys = create_keys(sizes[i]);
+        char *missing = create_keys(missing_count);
+        int *hit_order = create_order(lookups, sizes[i]);
+        int *miss_order = create_order(lookups, missing_count);
+        p_hashmap map = hashmap_create();
+        if (!keys || !missing || !hit_order || !miss_order || !map) {
+            free(keys);
+            free(missing);
+            free(hit_order);
+            free(miss_order);
+            hashmap_remove(&map);
+            return;
+        }
+
+        // Missing keys differ from present ones by the first letter.
+        for (int k = 0; k < missing_count; k++)
+            missing[k * HASHMAP_BENCHMARK_KEY_SIZE] = 'm';
+
+        uint64_t start = get_time_ns();
+        for (int k = 0; k < sizes[i]; k++)
+            hashmap_set_entry(map, &keys[k * HASHMAP_BENCHMARK_KEY_SIZE], (void *)(intptr_t)(k + 1));
+        double insert_ms = get_elapsed_ms(start);
+
+        // Keys are visited in a scattered order, so large maps miss the cache.
+        double hit_ms = measure_lookups(map, keys, hit_order, lookups);
+        double miss_ms = measure_lookups(map, missing, miss_order, lookups);
+
+        printf("%-24s %10d %12.2f %12.2f %12.2f\n", "open addressing", sizes[i], insert_ms,
+               lookups / hit_ms / 1000.0, lookups / miss_ms / 1000.0);
+        hashmap_remove(&map);
+        free(keys);
+        free(missing);
+        free(hit_order);
+        free(miss_order);
+    }
+}
+
+void hashmap_integer_key_benchmark(void) {
+    const int sizes[] = {1000, 1000000};
+    const int lookups = 10000000;
+
+    printf("\n%-24s %10s %12s %12s\n", "hashmap", "keys", "insert, ms", "hit, Mops/s");
+    for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++) {
+        char *keys = create_keys(sizes[i]);
+        int *order = create_order(lookups, sizes[i]);
+        p_hashmap map = hashmap_create();
+        p_hashmap_u64 u64_map = hashmap_u64_create();
+        if (!keys || !order || !map || !u64_map) {
+            free(keys);
+            free(order);
+            hashmap_remove(&map);
+            hashmap_u64_remove(&u64_map);
+            return;
+        }
+
+        // Id k is the string key "key<k>" for one map and the integer k for the other.
+        uint64_t start = get_time_ns();
+        for (int k = 0; k < sizes[i]; k++)
+            hashmap_set_entry(map, &keys[k * HASHMAP_BENCHMARK_KEY_SIZE], (void *)(intptr_t)(k + 1));
+        double string_insert_ms = get_elapsed_ms(start);
+        double string_hit_ms = measure_lookups(map, keys, order, lookups);
+
+        start = get_time_ns();
+        for (int k = 0; k < sizes[i]; k++)
+            hashmap_u64_set_entry(u64_map, (uint64_t)k, (void *)(intptr_t)(k + 1));
+        double u64_insert_ms = get_elapsed_ms(start);
+        double u64_hit_ms = measure_u64_lookups(u64_map, order, lookups);
+
+        printf("%-24s %10d %12.2f %12.2f\n", "string keys", sizes[i], string_insert_ms,
+               lookups / string_hit_ms / 1000.0);
+        printf("%-24s %10d %12.2f %12.2f\n", "u64 keys", sizes[i], u64_insert_ms,
+               lookups / u64_hit_ms / 1000.0);
+        hashmap_remove(&map);
+        hashmap_u64_remove(&u64_map);
+        free(keys);
+        free(order);
+    }
+}
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DEFINITIONS
+ **********************************************************************************************/
+
+static char *create_keys(int count) {
+    char *keys = malloc((size_t)count * HASHMAP_BENCHMARK_KEY_SIZE);
+    if (!keys)
+        return NULL;
+
+    for (int i = 0; i < count; i++)
+        snprintf(&keys[(size_t)i * HASHMAP_BENCHMARK_KEY_SIZE], HASHMAP_BENCHMARK_KEY_SIZE, "key%d", i);
+    return keys;
+}
+
+static int *create_order(int count, int range) {
+    int *order = malloc((size_t)count * sizeof(int));
+    if (!order)
+        return NULL;
+
+    for (int i = 0; i < count; i++)
+        order[i] = (int)(((uint64_t)i * 2654435761u) % range);
+    return order;
+}
+
+static double measure_lookups(p_hashmap map, const char *keys, const int *order, int count) {
+    double best_ms = 0;
+    for (int run = 0; run < HASHMAP_BENCHMARK_RUNS; run++) {
+        uint64_t start = get_time_ns();
+        for (int k = 0; k < count; k++)
+            hashmap_get_entry(map, &keys[(size_t)order[k] * HASHMAP_BENCHMARK_KEY_SIZE]);
+        double elapsed_ms = get_elapsed_ms(start);
+
+        if (!run || elapsed_ms < best_ms)
+            best_ms = elapsed_ms;
+    }
+    return best_ms;
+}
+
+static double measure_u64_lookups(p_hashmap_u64 map, const int *order, int count) {
+    double best_ms = 0;
+    for (int run = 0; run < HASHMAP_BENCHMARK_RUNS; run++) {
+        uint64_t start = get_time_ns();
+        for (int k = 0; k < count; k++)
+            hashmap_u64_get_entry(map, (uint64_t)order[k]);
+        double elapsed_ms = get_elapsed_ms(start);
+
+        if (!run || elapsed_ms < best_ms)
+            best_ms = elapsed_ms;
+    }
+    return best_ms;
+}
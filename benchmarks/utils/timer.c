@@ -0,0 +1,17 @@
+#include "timer.h"
+
+#include <time.h>
+
+/*********************************************************************************************
+ * FUNCTIONS DEFINITIONS
+ ********************************************************************************************/
+
+uint64_t get_time_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+double get_elapsed_ms(uint64_t start) {
+    return (double)(get_time_ns() - start) / 1000000.0;
+}
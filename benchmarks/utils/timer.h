@@ -0,0 +1,31 @@
+/**
+ * @file timer.h
+ * @author chcp (cmewhou@yandex.ru)
+ * @brief Benchmark timer.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#ifndef IPEE_BENCHMARK_TIMER_H
+#define IPEE_BENCHMARK_TIMER_H
+
+#include <stdint.h>
+
+/**
+ * @brief Get monotonic time.
+ *
+ * @return Time in nanoseconds.
+ */
+extern uint64_t get_time_ns(void);
+
+/**
+ * @brief Get elapsed time.
+ *
+ * @param start Start time in nanoseconds.
+ * @return Elapsed time in milliseconds.
+ */
+extern double get_elapsed_ms(uint64_t start);
+
+#endif // IPEE_BENCHMARK_TIMER_H
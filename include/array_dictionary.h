@@ -0,0 +1,471 @@
+/*********************************************************************************************
+ * @file array_dictionary.h
+ * @author chcp (cmewhou@yandex.ru)
+ * @brief Ordered <key:value> pair collection based on contiguous arrays.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ ********************************************************************************************/
+
+#ifndef IPEE_ARRAY_DICTIONARY_H
+#define IPEE_ARRAY_DICTIONARY_H
+
+#include <stdint.h>
+
+#include <dictionary.h>
+
+/*********************************************************************************************
+ * ERROR CODES
+ ********************************************************************************************/
+
+typedef enum ipee_array_dictionary_error_code_e {
+    IPEE_ERROR_CODE__ARRAY_DICTIONARY__NOT_EXISTS         = -1, // Dictionary does not exist.
+    IPEE_ERROR_CODE__ARRAY_DICTIONARY__INDEX_OUT_OF_RANGE = -2, // Index is out of valid range.
+    IPEE_ERROR_CODE__ARRAY_DICTIONARY__ALLOCATION_ERROR   = -3, // Failed to grow storage.
+} ipee_array_dictionary_error_code_t, *p_array_dictionary_error_code;
+
+/*********************************************************************************************
+ * STRUCTS DECLARATIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Array dictionary collection.
+ *
+ * @details
+ * Ordered collection of records stored as structure of arrays: keys, values
+ * and metadata of records live in separate contiguous arrays, so iteration
+ * is a linear scan instead of pointer chasing. Records are not unique.
+ * Removed records are marked in tombstones array and storage is compacted
+ * later, so removal never shifts the arrays. Only writes compact: reads by
+ * index skip removed slots and never change the dictionary.
+ * keys - records keys.
+ * values - records values.
+ * records_metadata - records metadata.
+ * tombstones - nonzero for removed slots.
+ * length - count of used slots including removed ones.
+ * capacity - count of allocated slots.
+ * size - count of records.
+ *
+ * @warning
+ * The implementation is mutable, not thread-safe and not reentrant.
+ * Adding records while iterating is not supported.
+ */
+typedef struct array_dictionary_s {
+    char **keys;             // Records keys.
+    void **values;           // Records values.
+    void **records_metadata; // Records metadata.
+    uint8_t *tombstones;     // Removed slots marks.
+    int length;              // Count of used slots.
+    int capacity;            // Count of allocated slots.
+    int size;                // Count of records.
+    void *metadata;          // Dictionary metadata.
+} array_dictionary_t, *p_array_dictionary;
+
+/***********************************************************************************************
+ * FUNCTION TYPEDEFS
+ **********************************************************************************************/
+
+/**
+ * @brief Callback function for mapping records of array dictionary.
+ *
+ * @details
+ * Record is a temporary view of a slot, it is valid only during the call.
+ *
+ * @param record Record.
+ * @param index Record index.
+ * @param dict Array dictionary.
+ * @return Mapped record.
+ */
+typedef p_record (*array_dictionary_iteration_callback_map)(
+    const p_record record, int index, const p_array_dictionary dict);
+
+/**
+ * @brief Callback function for mapping records of array dictionary.
+ *
+ * @param record Record.
+ * @param index Record index.
+ * @param dict Array dictionary.
+ * @param args Arguments for callback function.
+ * @return Mapped record.
+ */
+typedef p_record (*array_dictionary_iteration_callback_map_with_args)(
+    const p_record record, int index, const p_array_dictionary dict, void *args);
+
+/**
+ * @brief Callback function for filtering records of array dictionary.
+ *
+ * @param record Record.
+ * @param index Record index.
+ * @param dict Array dictionary.
+ * @return Result of comparison.
+ */
+typedef int (*array_dictionary_iteration_callback_filter)(
+    const p_record record, int index, const p_array_dictionary dict);
+
+/**
+ * @brief Callback function for filtering records of array dictionary.
+ *
+ * @param record Record.
+ * @param index Record index.
+ * @param dict Array dictionary.
+ * @param args Arguments for callback function.
+ * @return Result of comparison.
+ */
+typedef int (*array_dictionary_iteration_callback_filter_with_args)(
+    const p_record record, int index, const p_array_dictionary dict, void *args);
+
+/**
+ * @brief Callback function for reducing records of array dictionary.
+ *
+ * @param acc Accumulator.
+ * @param record Record.
+ * @param index Record index.
+ * @param dict Array dictionary.
+ */
+typedef void (*array_dictionary_iteration_callback_reduce)(
+    void *acc, const p_record record, int index, const p_array_dictionary dict);
+
+/**
+ * @brief Callback function for reducing records of array dictionary.
+ *
+ * @param acc Accumulator.
+ * @param record Record.
+ * @param index Record index.
+ * @param dict Array dictionary.
+ * @param args Arguments for callback function.
+ */
+typedef void (*array_dictionary_iteration_callback_reduce_with_args)(
+    void *acc, const p_record record, int index, const p_array_dictionary dict, void *args);
+
+/*********************************************************************************************
+ * FUNCTIONS DECLARATIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Create array dictionary.
+ *
+ * @return Array dictionary.
+ */
+extern p_array_dictionary create_array_dictionary(void);
+
+/**
+ * @brief Create array dictionary.
+ *
+ * @param metadata Metadata.
+ * @return Array dictionary.
+ */
+extern p_array_dictionary create_array_dictionary_with_metadata(void *metadata);
+
+/**
+ * @brief Delete array dictionary.
+ *
+ * @param dict Array dictionary.
+ * @return 0 on success, or a negative error code.
+ */
+extern int delete_array_dictionary(p_array_dictionary dict);
+
+/**
+ * @brief Compact array dictionary.
+ *
+ * @details
+ * Drop removed slots and move records to the start of arrays keeping order.
+ *
+ * @param dict Array dictionary.
+ * @return 0 on success, or a negative error code.
+ */
+extern int compact_array_dictionary(const p_array_dictionary dict);
+
+/**
+ * @brief Add record to array dictionary.
+ *
+ * @param dict Array dictionary.
+ * @param key Record key.
+ * @param value Record value.
+ * @return 0 on success, or a negative error code.
+ */
+extern int add_record_to_array_dictionary(const p_array_dictionary dict, char *key, void *value);
+
+/**
+ * @brief Add record to array dictionary.
+ *
+ * @param dict Array dictionary.
+ * @param key Record key.
+ * @param value Record value.
+ * @param metadata Record metadata.
+ * @return 0 on success, or a negative error code.
+ */
+extern int add_record_to_array_dictionary_with_metadata(
+    const p_array_dictionary dict, char *key, void *value, void *metadata);
+
+/**
+ * @brief Add record to begin of array dictionary.
+ *
+ * @param dict Array dictionary.
+ * @param key Record key.
+ * @param value Record value.
+ * @return 0 on success, or a negative error code.
+ */
+extern int emplace_record_to_array_dictionary(const p_array_dictionary dict, char *key, void *value);
+
+/**
+ * @brief Add record to array dictionary by index.
+ *
+ * @details
+ * Records after the index are shifted, complexity is O(n).
+ *
+ * @param dict Array dictionary.
+ * @param index Record index.
+ * @param key Record key.
+ * @param value Record value.
+ * @return 0 on success, or a negative error code.
+ */
+extern int add_record_to_array_dictionary_by_index(
+    const p_array_dictionary dict, int index, char *key, void *value);
+
+/**
+ * @brief Add record to array dictionary by index.
+ *
+ * @details
+ * Records after the index are shifted, complexity is O(n).
+ *
+ * @param dict Array dictionary.
+ * @param index Record index.
+ * @param key Record key.
+ * @param value Record value.
+ * @param metadata Record metadata.
+ * @return 0 on success, or a negative error code.
+ */
+extern int add_record_to_array_dictionary_by_index_with_metadata(
+    const p_array_dictionary dict, int index, char *key, void *value, void *metadata);
+
+/**
+ * @brief Remove record from array dictionary.
+ *
+ * @details
+ * Remove first matching record. The slot is marked as removed.
+ *
+ * @param dict Array dictionary.
+ * @param key Record key.
+ * @return Value of removed record.
+ */
+extern void *remove_record_from_array_dictionary(const p_array_dictionary dict, char *key);
+
+/**
+ * @brief Remove record from array dictionary by index.
+ *
+ * @param dict Array dictionary.
+ * @param index Record index.
+ * @return Value of removed record.
+ */
+extern void *remove_record_from_array_dictionary_by_index(const p_array_dictionary dict, int index);
+
+/**
+ * @brief Update record in array dictionary.
+ *
+ * @param dict Array dictionary.
+ * @param key Record key.
+ * @param value Record value.
+ * @return Previous value of updated record.
+ */
+extern void *update_record_in_array_dictionary(
+    const p_array_dictionary dict, char *key, void *value);
+
+/**
+ * @brief Update record in array dictionary by index.
+ *
+ * @param dict Array dictionary.
+ * @param index Record index.
+ * @param value Record value.
+ * @return Previous value of updated record.
+ */
+extern void *update_record_in_array_dictionary_by_index(
+    const p_array_dictionary dict, int index, void *value);
+
+/**
+ * @brief Check if array dictionary contains specified key.
+ *
+ * @param dict Array dictionary.
+ * @param key Record key.
+ * @return 1 if dictionary contains key, 0 otherwise.
+ */
+extern int contains_key_in_array_dictionary(const p_array_dictionary dict, char *key);
+
+/**
+ * @brief Check if array dictionary contains specified value.
+ *
+ * @param dict Array dictionary.
+ * @param value Record value.
+ * @return 1 if dictionary contains value, 0 otherwise.
+ */
+extern int contains_value_in_array_dictionary(const p_array_dictionary dict, void *value);
+
+/**
+ * @brief Get value from array dictionary by key.
+ *
+ * @param dict Array dictionary.
+ * @param key Record key.
+ * @return Value of first matching record, or NULL.
+ */
+extern void *get_value_from_array_dictionary(const p_array_dictionary dict, char *key);
+
+/**
+ * @brief Get value from array dictionary by index.
+ *
+ * @param dict Array dictionary.
+ * @param index Record index.
+ * @return Record value, or NULL.
+ */
+extern void *get_value_from_array_dictionary_by_index(const p_array_dictionary dict, int index);
+
+/**
+ * @brief Get key from array dictionary by index.
+ *
+ * @param dict Array dictionary.
+ * @param index Record index.
+ * @return Record key, or NULL.
+ */
+extern char *get_key_from_array_dictionary_by_index(const p_array_dictionary dict, int index);
+
+/**
+ * @brief Get index from array dictionary by key.
+ *
+ * @param dict Array dictionary.
+ * @param key Record key.
+ * @return Index of first matching record, or -1.
+ */
+extern int get_index_from_array_dictionary_by_key(const p_array_dictionary dict, char *key);
+
+/**
+ * @brief Iterate over array dictionary.
+ *
+ * @param dict Array dictionary.
+ * @param callback Callback function.
+ * @return 0 on success, or a negative error code.
+ */
+extern int iterate_over_array_dictionary(
+    const p_array_dictionary dict, dictionary_iteration_callback callback);
+
+/**
+ * @brief Iterate over array dictionary with arguments.
+ *
+ * @param dict Array dictionary.
+ * @param callback Callback function.
+ * @param args Arguments for callback function.
+ * @return 0 on success, or a negative error code.
+ */
+extern int iterate_over_array_dictionary_with_args(
+    const p_array_dictionary dict, dictionary_iteration_callback_with_args callback, void *args);
+
+/**
+ * @brief Iterate over keys of array dictionary.
+ *
+ * @param dict Array dictionary.
+ * @param callback Callback function.
+ * @return 0 on success, or a negative error code.
+ */
+extern int iterate_over_array_dictionary_keys(
+    const p_array_dictionary dict, dictionary_iteration_keys_callback callback);
+
+/**
+ * @brief Iterate over keys of array dictionary with arguments.
+ *
+ * @param dict Array dictionary.
+ * @param callback Callback function.
+ * @param args Arguments for callback function.
+ * @return 0 on success, or a negative error code.
+ */
+extern int iterate_over_array_dictionary_keys_with_args(
+    const p_array_dictionary dict, dictionary_iteration_keys_callback_with_args callback, void *args);
+
+/**
+ * @brief Iterate over values of array dictionary.
+ *
+ * @param dict Array dictionary.
+ * @param callback Callback function.
+ * @return 0 on success, or a negative error code.
+ */
+extern int iterate_over_array_dictionary_values(
+    const p_array_dictionary dict, dictionary_iteration_values_callback callback);
+
+/**
+ * @brief Iterate over values of array dictionary with arguments.
+ *
+ * @param dict Array dictionary.
+ * @param callback Callback function.
+ * @param args Arguments for callback function.
+ * @return 0 on success, or a negative error code.
+ */
+extern int iterate_over_array_dictionary_values_with_args(
+    const p_array_dictionary dict, dictionary_iteration_values_callback_with_args callback, void *args);
+
+/**
+ * @brief Map array dictionary records.
+ *
+ * @param dict Array dictionary.
+ * @param callback Callback function.
+ * @return Mapped array dictionary.
+ */
+extern p_array_dictionary map_array_dictionary(
+    const p_array_dictionary dict, array_dictionary_iteration_callback_map callback);
+
+/**
+ * @brief Map array dictionary records with arguments.
+ *
+ * @param dict Array dictionary.
+ * @param callback Callback function.
+ * @param args Arguments for callback function.
+ * @return Mapped array dictionary.
+ */
+extern p_array_dictionary map_array_dictionary_with_args(
+    const p_array_dictionary dict,
+    array_dictionary_iteration_callback_map_with_args callback, void *args);
+
+/**
+ * @brief Filter array dictionary records.
+ *
+ * @param dict Array dictionary.
+ * @param callback Callback function.
+ * @return Filtered array dictionary.
+ */
+extern p_array_dictionary filter_array_dictionary(
+    const p_array_dictionary dict, array_dictionary_iteration_callback_filter callback);
+
+/**
+ * @brief Filter array dictionary records with arguments.
+ *
+ * @param dict Array dictionary.
+ * @param callback Callback function.
+ * @param args Arguments for callback function.
+ * @return Filtered array dictionary.
+ */
+extern p_array_dictionary filter_array_dictionary_with_args(
+    const p_array_dictionary dict,
+    array_dictionary_iteration_callback_filter_with_args callback, void *args);
+
+/**
+ * @brief Reduce array dictionary records.
+ *
+ * @param dict Array dictionary.
+ * @param callback Callback function.
+ * @param acc Initial accumulator value.
+ * @return Accumulator.
+ */
+extern void *reduce_array_dictionary(
+    const p_array_dictionary dict, array_dictionary_iteration_callback_reduce callback, void *acc);
+
+/**
+ * @brief Reduce array dictionary records with arguments.
+ *
+ * @param dict Array dictionary.
+ * @param callback Callback function.
+ * @param acc Initial accumulator value.
+ * @param args Arguments for callback function.
+ * @return Accumulator.
+ */
+extern void *reduce_array_dictionary_with_args(
+    const p_array_dictionary dict,
+    array_dictionary_iteration_callback_reduce_with_args callback,
+    void *acc, void *args);
+
+#endif // IPEE_ARRAY_DICTIONARY_H
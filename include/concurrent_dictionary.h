@@ -0,0 +1,189 @@
+/*********************************************************************************************
+ * @file concurrent_dictionary.h
+ * @author chcp (cmewhou@yandex.ru)
+ * @brief Read-mostly <key:value> pair collection with lock-free readers.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ ********************************************************************************************/
+
+#ifndef IPEE_CONCURRENT_DICTIONARY_H
+#define IPEE_CONCURRENT_DICTIONARY_H
+
+#include <dictionary.h>
+
+/*********************************************************************************************
+ * ERROR CODES
+ ********************************************************************************************/
+
+typedef enum ipee_concurrent_dictionary_error_code_e {
+    IPEE_ERROR_CODE__CONCURRENT_DICTIONARY__NOT_EXISTS            = -1, // Dictionary does not exist.
+    IPEE_ERROR_CODE__CONCURRENT_DICTIONARY__RECORD_CREATION_ERROR = -2, // Failed to allocate a record.
+} ipee_concurrent_dictionary_error_code_t, *p_concurrent_dictionary_error_code;
+
+/*********************************************************************************************
+ * STRUCTS DECLARATIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Concurrent dictionary collection.
+ *
+ * @details
+ * Ordered collection of records, records are not unique. Readers traverse
+ * records without locks, writers are serialized by a mutex. Removed records
+ * are retired and freed only after every reader that could still see them
+ * has left its read section (epoch-based reclamation), so lookups and
+ * iteration never touch freed memory.
+ *
+ * @warning
+ * Keys are not copied, they have to outlive their records.
+ * The dictionary can be deleted only when no thread uses it.
+ */
+typedef struct concurrent_dictionary_s concurrent_dictionary_t, *p_concurrent_dictionary;
+
+/*********************************************************************************************
+ * FUNCTIONS DECLARATIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Create concurrent dictionary.
+ *
+ * @return Dictionary, or NULL on allocation failure.
+ */
+extern p_concurrent_dictionary create_concurrent_dictionary(void);
+
+/**
+ * @brief Delete concurrent dictionary.
+ *
+ * @details
+ * Delete dictionary with all its records, including retired ones.
+ *
+ * @param dict Dictionary.
+ * @return 0 on success, error code otherwise.
+ */
+extern int delete_concurrent_dictionary(p_concurrent_dictionary dict);
+
+/**
+ * @brief Begin read section.
+ *
+ * @details
+ * Records reached inside a read section are not freed until the section
+ * ends. Sections can be nested and have to be ended by the same thread.
+ * While a thread is inside a read section of any concurrent dictionary,
+ * its writes to every concurrent dictionary only retire records, they are
+ * freed by a later writer or synchronize call outside of read sections.
+ *
+ * @param dict Dictionary.
+ * @return Section token for end_concurrent_dictionary_read, error code otherwise.
+ */
+extern int begin_concurrent_dictionary_read(const p_concurrent_dictionary dict);
+
+/**
+ * @brief End read section.
+ *
+ * @param dict Dictionary.
+ * @param token Section token returned by begin_concurrent_dictionary_read.
+ */
+extern void end_concurrent_dictionary_read(const p_concurrent_dictionary dict, int token);
+
+/**
+ * @brief Add record to concurrent dictionary.
+ *
+ * @details
+ * Append a record to the tail of dictionary.
+ *
+ * @param dict Dictionary.
+ * @param key Record key.
+ * @param value Record value.
+ * @return 0 on success, error code otherwise.
+ */
+extern int add_record_to_concurrent_dictionary(const p_concurrent_dictionary dict, char *key, void *value);
+
+/**
+ * @brief Remove record from concurrent dictionary.
+ *
+ * @details
+ * Remove first matching record. The record is retired and freed once
+ * concurrent readers have left their read sections.
+ *
+ * @param dict Dictionary.
+ * @param key Record key.
+ * @return Value of removed record.
+ */
+extern void *remove_record_from_concurrent_dictionary(const p_concurrent_dictionary dict, char *key);
+
+/**
+ * @brief Update record in concurrent dictionary.
+ *
+ * @details
+ * Update value of first matching record. Readers see either the old or
+ * the new value.
+ *
+ * @param dict Dictionary.
+ * @param key Record key.
+ * @param value Record value.
+ * @return Previous value of updated record, NULL if there is no record.
+ */
+extern void *update_record_in_concurrent_dictionary(const p_concurrent_dictionary dict, char *key, void *value);
+
+/**
+ * @brief Get value from concurrent dictionary by key.
+ *
+ * @details
+ * Lock-free lookup of first matching record.
+ *
+ * @param dict Dictionary.
+ * @param key Record key.
+ * @return Record value, NULL if there is no record.
+ */
+extern void *get_value_from_concurrent_dictionary(const p_concurrent_dictionary dict, char *key);
+
+/**
+ * @brief Check if concurrent dictionary contains specified key.
+ *
+ * @param dict Dictionary.
+ * @param key Record key.
+ * @return 1 if dictionary contains key, 0 otherwise.
+ */
+extern int contains_key_in_concurrent_dictionary(const p_concurrent_dictionary dict, char *key);
+
+/**
+ * @brief Get count of records in concurrent dictionary.
+ *
+ * @param dict Dictionary.
+ * @return Count of records, error code otherwise.
+ */
+extern int get_concurrent_dictionary_size(const p_concurrent_dictionary dict);
+
+/**
+ * @brief Iterate over concurrent dictionary.
+ *
+ * @details
+ * Lock-free iteration from head to tail inside a read section. Records
+ * added during iteration may or may not be visited. The callback may
+ * modify the dictionary.
+ *
+ * @param dict Dictionary.
+ * @param callback Callback function.
+ * @param args Arguments for callback function.
+ * @return 0 on success, error code otherwise.
+ */
+extern int iterate_over_concurrent_dictionary_with_args(
+    const p_concurrent_dictionary dict, dictionary_iteration_callback_with_args callback, void *args);
+
+/**
+ * @brief Free retired records of concurrent dictionary.
+ *
+ * @details
+ * Wait until readers that could see retired records leave their read
+ * sections and free those records. Writers do it on their own once enough
+ * records are retired. Does nothing when called inside a read section of
+ * any concurrent dictionary.
+ *
+ * @param dict Dictionary.
+ * @return 0 on success, error code otherwise.
+ */
+extern int synchronize_concurrent_dictionary(const p_concurrent_dictionary dict);
+
+#endif // IPEE_CONCURRENT_DICTIONARY_H
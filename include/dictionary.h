@@ -11,6 +11,9 @@
 #ifndef IPEE_DICTIONARY_H
 #define IPEE_DICTIONARY_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 /*********************************************************************************************
  * ERROR CODES
  ********************************************************************************************/
@@ -19,12 +22,87 @@ typedef enum ipee_dictionary_error_code_e {
     IPEE_ERROR_CODE__DICTIONARY__NOT_EXISTS            = -1, // Dictionary does not exist.
     IPEE_ERROR_CODE__DICTIONARY__INDEX_OUT_OF_RANGE    = -2, // Index is out of valid range.
     IPEE_ERROR_CODE__DICTIONARY__RECORD_CREATION_ERROR = -3, // Failed to allocate a record.
+    IPEE_ERROR_CODE__DICTIONARY__POOL_NOT_EXISTS       = -4, // Record pool does not exist.
+    IPEE_ERROR_CODE__DICTIONARY__INCOMPATIBLE_MODE     = -5, // Dictionaries store records differently.
 } ipee_dictionary_error_code_t, *p_dictionary_error_code;
 
 /*********************************************************************************************
  * STRUCTS DECLARATIONS
  ********************************************************************************************/
 
+/**
+ * @brief Dictionary mode.
+ *
+ * @details
+ * Flags which enable optional behaviour of a dictionary. Flags can be combined.
+ * Default - plain linked list, every keyed operation is a linear scan.
+ * Key index - hash side-index over keys, keyed lookup and removal are O(1) average.
+ * Record pool - records are allocated from a private slab pool released in bulk.
+ * Position index - order statistic tree over records, positional operations are O(log n).
+ * Value index - hash side-index over value pointers, lookup by value is O(1) average.
+ * Key hash - records cache hash and length of string keys, keyed scans compare
+ * them before the strings. Implied by key index. Keys must be valid strings.
+ * Owned keys - records copy their keys, short keys are stored inside the record,
+ * long ones in key chunks of the record pool. Implies key hash and a record pool,
+ * a private one unless a shared pool is given.
+ * Int keys - keys are integers stored in key pointers, they are hashed and
+ * compared as integers. Excludes key hash and owned keys.
+ * Key trie - key index is a compressed radix trie, keys sharing a prefix store
+ * it once and records can be enumerated by key prefix. Implies key index
+ * without key hash, unless owned keys need it. Excluded by int keys.
+ *
+ * Indexes keep one entry per distinct key or value and chain its records in
+ * dictionary order, so the k records sharing it are reached in O(k) and
+ * appending or removing a duplicate is O(1). Inserting a duplicate in the
+ * middle of the dictionary finds its place by the nearest duplicate around
+ * it, or by ranks of the chained records with a position index.
+ */
+typedef enum dictionary_mode_e {
+    DICTIONARY_MODE_DEFAULT        = 0,      // Plain linked list.
+    DICTIONARY_MODE_KEY_INDEX      = 1 << 0, // Hash side-index over record keys.
+    DICTIONARY_MODE_RECORD_POOL    = 1 << 1, // Private slab pool for records.
+    DICTIONARY_MODE_POSITION_INDEX = 1 << 2, // Order statistic tree over records.
+    DICTIONARY_MODE_VALUE_INDEX    = 1 << 3, // Hash side-index over record values.
+    DICTIONARY_MODE_KEY_HASH       = 1 << 4, // Cached hash and length of record keys.
+    DICTIONARY_MODE_OWNED_KEYS     = 1 << 5, // Keys copied into records or the record pool.
+    DICTIONARY_MODE_INT_KEYS       = 1 << 6, // Integer keys compared by value.
+    DICTIONARY_MODE_KEY_TRIE       = 1 << 7, // Radix trie key index.
+} dictionary_mode_t, *p_dictionary_mode;
+
+/**
+ * @brief Merge conflict policy.
+ *
+ * @details
+ * Resolution of a merged record whose key is already in the dictionary.
+ * Keep - existing record is left untouched, the merged one is skipped.
+ * Replace - value of the existing record is replaced by the merged one.
+ * Append - merged record is appended as a duplicate.
+ */
+typedef enum dictionary_merge_policy_e {
+    DICTIONARY_MERGE_KEEP    = 0, // Keep existing value.
+    DICTIONARY_MERGE_REPLACE = 1, // Replace existing value.
+    DICTIONARY_MERGE_APPEND  = 2, // Append duplicate record.
+} dictionary_merge_policy_t, *p_dictionary_merge_policy;
+
+typedef struct dictionary_index_s dictionary_index_t, *p_dictionary_index;
+typedef struct dictionary_position_index_s dictionary_position_index_t, *p_dictionary_position_index;
+typedef struct record_position_s record_position_t, *p_record_position;
+
+/**
+ * @brief Record pool.
+ *
+ * @details
+ * Allocator of records. Records are carved from cache-line aligned slabs,
+ * removed records are recycled via a free list and all slabs are released
+ * at once when the pool is deleted. Long owned keys are carved from key
+ * chunks and recycled by size class the same way. A pool may be shared by
+ * several dictionaries.
+ *
+ * @warning
+ * The implementation is mutable, not thread-safe and not reentrant.
+ */
+typedef struct record_pool_s record_pool_t, *p_record_pool;
+
 /**
  * @brief Record.
  *
@@ -35,17 +113,41 @@ typedef enum ipee_dictionary_error_code_e {
  * next - reference to next node.
  * prev - reference to previous node.
  *
+ * Records of a dictionary are followed by the optional fields of its mode in
+ * the same allocation: cached key hash and length, short owned key storage,
+ * position index node, links of records sharing an indexed key or value and,
+ * for pooled records, the storage generation.
+ * Dictionaries pay only for the fields they use, see record_size.
+ *
  * @warning
  * The implementation is mutable, not thread-safe and not reentrant.
  */
 typedef struct record_s {
-    struct record_s *next; // Next node reference.
-    struct record_s *prev; // Previous node reference.
-    char *key;             // String key.
-    void *value;           // Any type value.
-    void *metadata;        // Record metadata.
+    struct record_s *next;      // Next node reference.
+    struct record_s *prev;      // Previous node reference.
+    char *key;                  // String key.
+    void *value;                // Any type value.
+    void *metadata;             // Record metadata.
 } record_t, *p_record;
 
+/**
+ * @brief Record reference.
+ *
+ * @details
+ * Handle of a record taken at some point of time. Records released since
+ * then have a different generation, so a stale handle is detected instead
+ * of touching a record reused for another key.
+ * record - referenced record.
+ * generation - generation of the record when the handle was taken.
+ *
+ * Only records of pooled dictionaries have a generation, other records
+ * return to the heap and cannot be referenced.
+ */
+typedef struct record_ref_s {
+    p_record record;     // Referenced record.
+    uint32_t generation; // Record generation.
+} record_ref_t, *p_record_ref;
+
 /**
  * @brief Dictionary collection.
  *
@@ -55,15 +157,35 @@ typedef struct record_s {
  * head - pointer to the head record.
  * tail - pointer to the tail record.
  * size - count of records in collection.
+ * mode - dictionary mode flags.
+ * key_index - hash side-index over keys, if DICTIONARY_MODE_KEY_INDEX is set.
+ * value_index - hash side-index over values, if DICTIONARY_MODE_VALUE_INDEX is set.
+ * pool - record pool, if records are not allocated one by one.
+ * position_index - order statistic tree, if DICTIONARY_MODE_POSITION_INDEX is set.
+ * record_size - size of records, record_t and the optional fields, pooled records may be larger.
+ * hash_offset - offset of cached key hash and length in records, if any.
+ * position_offset - offset of position index node in records, if any.
+ * key_chain_offset - offset of key index links in records, if any.
+ * value_chain_offset - offset of value index links in records, if any.
  *
  * @warning
  * The implementation is mutable, not thread-safe and not reentrant.
  */
 typedef struct dictionary_s {
-    p_record head;  // Head of the dictionary.
-    p_record tail;  // Tail of the dictionary.
-    int size;       // Size of the dictionary.
-    void *metadata; // Dictionary metadata.
+    p_record head;                              // Head of the dictionary.
+    p_record tail;                              // Tail of the dictionary.
+    int size;                                   // Size of the dictionary.
+    void *metadata;                             // Dictionary metadata.
+    int mode;                                   // Dictionary mode flags.
+    p_dictionary_index key_index;               // Hash side-index over keys.
+    p_dictionary_index value_index;             // Hash side-index over values.
+    p_record_pool pool;                         // Record pool.
+    p_dictionary_position_index position_index; // Order statistic tree over records.
+    int record_size;                            // Allocation size of records.
+    int hash_offset;                            // Offset of cached key hash.
+    int position_offset;                        // Offset of position index node.
+    int key_chain_offset;                       // Offset of key index links.
+    int value_chain_offset;                     // Offset of value index links.
 } dictionary_t, *p_dictionary;
 
 /***********************************************************************************************
@@ -216,7 +338,7 @@ typedef void (*dictionary_iteration_callback_reduce_with_args)(
  *
  * @param record1 Record 1.
  * @param record2 Record 2.
- * @return Result of comparison.
+ * @return Nonzero if record1 must be placed after record2, 0 otherwise.
  */
 typedef int (*dictionary_iteration_callback_sort)(
     const p_record record1, const p_record record2);
@@ -227,11 +349,91 @@ typedef int (*dictionary_iteration_callback_sort)(
  * @param record1 Record 1.
  * @param record2 Record 2.
  * @param args Arguments for callback function.
- * @return Result of comparison.
+ * @return Nonzero if record1 must be placed after record2, 0 otherwise.
  */
 typedef int (*dictionary_iteration_callback_sort_with_args)(
     const p_record record1, const p_record record2, void *args);
 
+/*********************************************************************************************
+ * QUERY STRUCTS DECLARATIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Maximum count of stages in a dictionary query.
+ */
+#define DICTIONARY_QUERY_MAX_STAGES 8
+
+/**
+ * @brief Dictionary query stage type.
+ */
+typedef enum dictionary_query_stage_type_e {
+    DICTIONARY_QUERY_STAGE_FILTER = 0, // Drop records rejected by callback.
+    DICTIONARY_QUERY_STAGE_MAP    = 1, // Replace records by callback result.
+} dictionary_query_stage_type_t, *p_dictionary_query_stage_type;
+
+/**
+ * @brief Dictionary query stage.
+ *
+ * @details
+ * Exactly one of callbacks is set depending on stage type and arguments.
+ * index - count of records which entered the stage in the current run.
+ */
+typedef struct dictionary_query_stage_s {
+    dictionary_query_stage_type_t type;                              // Stage type.
+    dictionary_iteration_callback_filter filter;                     // Filter callback.
+    dictionary_iteration_callback_filter_with_args filter_with_args; // Filter callback with arguments.
+    dictionary_iteration_callback_map map;                           // Map callback.
+    dictionary_iteration_callback_map_with_args map_with_args;       // Map callback with arguments.
+    void *args;                                                      // Arguments for callback function.
+    int index;                                                       // Index of record in stage.
+} dictionary_query_stage_t, *p_dictionary_query_stage;
+
+/**
+ * @brief Dictionary query.
+ *
+ * @details
+ * Lazy pipeline of filter and map stages over a dictionary. Building a query
+ * allocates nothing, the query is usually placed on the stack. Records are
+ * streamed from the source dictionary through all stages at once only when
+ * a terminal operation (first, count, any, reduce, collect) is invoked,
+ * so no intermediate dictionary is created. A query may be run many times.
+ *
+ * @warning
+ * The implementation is mutable, not thread-safe and not reentrant.
+ */
+typedef struct dictionary_query_s {
+    p_dictionary dict;                                            // Source dictionary.
+    int stages_count;                                             // Count of stages.
+    dictionary_query_stage_t stages[DICTIONARY_QUERY_MAX_STAGES]; // Query stages.
+} dictionary_query_t, *p_dictionary_query;
+
+/*********************************************************************************************
+ * CURSOR STRUCTS DECLARATIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Dictionary cursor.
+ *
+ * @details
+ * External iterator over records of a dictionary, placed on the stack.
+ * The following record is fetched before the current one is visited, so
+ * the current record may be removed while iterating.
+ * record - current record, NULL when iteration is done.
+ * next - record the cursor moves to.
+ * reverse - nonzero if the cursor moves from tail to head.
+ *
+ * @example
+ * for (dictionary_cursor_t cursor = begin_dictionary_cursor(dict);
+ *      !is_dictionary_cursor_done(&cursor); next_dictionary_cursor(&cursor)) {
+ *     p_record record = cursor.record;
+ * }
+ */
+typedef struct dictionary_cursor_s {
+    p_record record; // Current record.
+    p_record next;   // Record to move to.
+    int reverse;     // Iteration direction.
+} dictionary_cursor_t, *p_dictionary_cursor;
+
 /*********************************************************************************************
  * FUNCTIONS DECLARATIONS
  ********************************************************************************************/
@@ -260,6 +462,73 @@ extern p_dictionary create_dictionary(void);
  */
 extern p_dictionary create_dictionary_with_metadata(void *metadata);
 
+/**
+ * @brief Create dictionary with specified mode.
+ *
+ * @details
+ * Create a new empty dictionary with optional behaviour enabled by mode flags.
+ *
+ * @param mode Combination of dictionary_mode_t flags.
+ * @param metadata Metadata.
+ *
+ * @return Dictionary.
+ */
+extern p_dictionary create_dictionary_with_mode(int mode, void *metadata);
+
+/**
+ * @brief Create dictionary with shared record pool.
+ *
+ * @details
+ * Create a new empty dictionary which allocates its records from the
+ * specified pool. Deleting the dictionary returns its records to the pool,
+ * the pool itself must be deleted by the owner after all its dictionaries.
+ *
+ * @param mode Combination of dictionary_mode_t flags.
+ * @param pool Record pool.
+ * @param metadata Metadata.
+ *
+ * @return Dictionary.
+ */
+extern p_dictionary create_dictionary_with_pool(int mode, p_record_pool pool, void *metadata);
+
+/**
+ * @brief Create indexed dictionary.
+ *
+ * @details
+ * Create a new empty dictionary which maintains a hash side-index over keys.
+ * Records keep insertion order, but lookup, containment check and removal
+ * by key are O(1) average. Keys must be valid strings.
+ *
+ * @return Dictionary.
+ */
+extern p_dictionary create_indexed_dictionary(void);
+
+/**
+ * @brief Create indexed dictionary.
+ *
+ * @details
+ * Create a new empty dictionary which maintains a hash side-index over keys.
+ * Records keep insertion order, but lookup, containment check and removal
+ * by key are O(1) average. Keys must be valid strings.
+ *
+ * @param metadata Metadata.
+ *
+ * @return Dictionary.
+ */
+extern p_dictionary create_indexed_dictionary_with_metadata(void *metadata);
+
+/**
+ * @brief Create integer keyed dictionary.
+ *
+ * @details
+ * Create a new empty dictionary with integer keys and a hash side-index
+ * over them. Lookup, containment check and removal by key are O(1) average
+ * and never touch keys as strings.
+ *
+ * @return Dictionary.
+ */
+extern p_dictionary create_int_dictionary(void);
+
 /**
  * @brief Delete dictionary.
  *
@@ -270,6 +539,42 @@ extern p_dictionary create_dictionary_with_metadata(void *metadata);
  */
 extern int delete_dictionary(p_dictionary dict);
 
+/**
+ * @brief Create record pool.
+ *
+ * @details
+ * Pooled records are as large as the largest mode of the pool
+ * dictionaries needs. Records size grows only while the pool is empty, so
+ * a dictionary which needs larger records than the pool already hands
+ * out cannot be created on it.
+ *
+ * @return Record pool.
+ */
+extern p_record_pool create_record_pool(void);
+
+/**
+ * @brief Create record pool for dictionaries of specified mode.
+ *
+ * @details
+ * Records are sized up front for dictionaries of the mode, so they can be
+ * created on the pool after it is used by dictionaries of smaller records.
+ *
+ * @param mode Combined dictionary mode flags of the pool dictionaries.
+ * @return Record pool.
+ */
+extern p_record_pool create_record_pool_with_mode(int mode);
+
+/**
+ * @brief Delete record pool.
+ *
+ * @details
+ * Release all slabs of the pool at once. Dictionaries which use the pool
+ * must not be used afterwards.
+ *
+ * @param pool Record pool.
+ */
+extern int delete_record_pool(p_record_pool pool);
+
 /**
  * @brief Add record to dictionary.
  *
@@ -357,6 +662,60 @@ extern int add_record_to_dictionary_by_index(
 extern int add_record_to_dictionary_by_index_with_metadata(
     const p_dictionary dict, int index, char *key, void *value, void *metadata);
 
+/**
+ * @brief Append records to dictionary.
+ *
+ * @details
+ * Append keys, values and metadata of records array to the dictionary tail.
+ * Pool storage and index capacity for the whole batch are reserved up front,
+ * so a pooled dictionary allocates at most one slab. Batch is appended
+ * entirely or not at all.
+ *
+ * @param dict Dictionary object.
+ * @param records Records to copy, only key, value and metadata are read.
+ * @param count Count of records.
+ *
+ * @return 0 on success, error code otherwise.
+ */
+extern int append_records_to_dictionary(const p_dictionary dict, const record_t *records, int count);
+
+/**
+ * @brief Move all records of a dictionary onto the tail of another.
+ *
+ * @details
+ * Records are relinked, not copied, and the source dictionary is left empty.
+ * Lists without side-indexes are joined in O(1), indexed records are moved
+ * one by one. Heap records are reallocated if the destination mode needs
+ * larger ones. Both dictionaries have to share the record pool, or have none,
+ * and agree on owned and int keys.
+ * On failure the records not moved yet stay in the source dictionary.
+ *
+ * @param dict Destination dictionary.
+ * @param source Source dictionary.
+ *
+ * @return 0 on success, error code otherwise.
+ */
+extern int splice_dictionary(const p_dictionary dict, const p_dictionary source);
+
+/**
+ * @brief Merge records of a dictionary into another.
+ *
+ * @details
+ * Records of the source are added in order, a record whose key is already
+ * present is resolved by the policy. Source dictionary is not changed.
+ * Keyed policies look keys up, so they are linear per record unless the
+ * destination has a key index.
+ * On failure the destination keeps the records merged so far.
+ *
+ * @param dict Destination dictionary.
+ * @param source Source dictionary.
+ * @param policy Conflict policy.
+ *
+ * @return 0 on success, error code otherwise.
+ */
+extern int merge_dictionaries(
+    const p_dictionary dict, const p_dictionary source, dictionary_merge_policy_t policy);
+
 /**
  * @brief Remove record from dictionary.
  *
@@ -383,6 +742,21 @@ extern void *remove_record_from_dictionary(const p_dictionary dict, char *key);
  */
 extern void *remove_record_from_dictionary_by_index(const p_dictionary dict, int index);
 
+/**
+ * @brief Remove record from dictionary by reference.
+ *
+ * @details
+ * Unlink the referenced record in O(1) without searching the dictionary.
+ * Record has to belong to the specified dictionary.
+ *
+ * @param dict Dictionary object.
+ * @param ref Record reference.
+ *
+ * @return Value of removed record, NULL if the reference is stale or the
+ * dictionary has no record pool.
+ */
+extern void *remove_record_from_dictionary_by_ref(const p_dictionary dict, record_ref_t ref);
+
 /**
  * @brief Update record in dictionary.
  *
@@ -411,6 +785,40 @@ extern void *update_record_in_dictionary(const p_dictionary dict, char *key, voi
  */
 extern void *update_record_in_dictionary_by_index(const p_dictionary dict, int index, void *value);
 
+/**
+ * @brief Update record in dictionary by reference.
+ *
+ * @details
+ * Update the referenced record in O(1) without searching the dictionary.
+ * Record has to belong to the specified dictionary.
+ *
+ * @param dict Dictionary object.
+ * @param ref Record reference.
+ * @param value Record value.
+ *
+ * @return Value of updated record, NULL if the reference is stale or the
+ * dictionary has no record pool.
+ */
+extern void *update_record_in_dictionary_by_ref(const p_dictionary dict, record_ref_t ref, void *value);
+
+/**
+ * @brief Take reference to record.
+ *
+ * @param dict Dictionary of the record.
+ * @param record Record.
+ * @return Record reference, empty if the dictionary has no record pool.
+ */
+extern record_ref_t get_record_ref(const p_dictionary dict, const p_record record);
+
+/**
+ * @brief Check whether record reference is still valid.
+ *
+ * @param dict Dictionary of the record.
+ * @param ref Record reference.
+ * @return 1 if the record was not released since the reference was taken, 0 otherwise.
+ */
+extern int is_record_ref_valid(const p_dictionary dict, const record_ref_t ref);
+
 /**
  * @brief Check if dictionary contains specified key.
  *
@@ -557,12 +965,93 @@ extern char *get_prev_key_from_dictionary(const p_dictionary dict, char *key);
  */
 extern p_record get_record_from_dictionary(const p_dictionary dict, char *key);
 
+/**
+ * @brief Get record from dictionary by key with precomputed hash.
+ *
+ * @details
+ * Same as get_record_from_dictionary, but the key is not hashed again.
+ * The hash must be computed by hash_dictionary_key. Not supported by
+ * DICTIONARY_MODE_INT_KEYS dictionaries, use get_record_from_int_dictionary.
+ *
+ * @param dict Dictionary.
+ * @param key Record key.
+ * @param hash Key hash.
+ * @return Record, NULL if it does not exist or dictionary has integer keys.
+ */
+extern p_record get_record_from_dictionary_hashed(const p_dictionary dict, char *key, uint32_t hash);
+
+/**
+ * @brief Hash record key.
+ *
+ * @param key Record key.
+ * @return Key hash.
+ */
+extern uint32_t hash_dictionary_key(const char *key);
+
+/**
+ * @brief Add record to integer keyed dictionary.
+ *
+ * @param dict Dictionary created with DICTIONARY_MODE_INT_KEYS.
+ * @param key Record key.
+ * @param value Record value.
+ * @return 0 on success, error code otherwise.
+ */
+extern int add_record_to_int_dictionary(const p_dictionary dict, intptr_t key, void *value);
+
+/**
+ * @brief Remove record from integer keyed dictionary.
+ *
+ * @param dict Dictionary created with DICTIONARY_MODE_INT_KEYS.
+ * @param key Record key.
+ * @return Value of removed record.
+ */
+extern void *remove_record_from_int_dictionary(const p_dictionary dict, intptr_t key);
+
+/**
+ * @brief Update record in integer keyed dictionary.
+ *
+ * @param dict Dictionary created with DICTIONARY_MODE_INT_KEYS.
+ * @param key Record key.
+ * @param value Record value.
+ * @return Value of updated record.
+ */
+extern void *update_record_in_int_dictionary(const p_dictionary dict, intptr_t key, void *value);
+
+/**
+ * @brief Get record from integer keyed dictionary.
+ *
+ * @param dict Dictionary created with DICTIONARY_MODE_INT_KEYS.
+ * @param key Record key.
+ * @return Record.
+ */
+extern p_record get_record_from_int_dictionary(const p_dictionary dict, intptr_t key);
+
+/**
+ * @brief Get value from integer keyed dictionary.
+ *
+ * @param dict Dictionary created with DICTIONARY_MODE_INT_KEYS.
+ * @param key Record key.
+ * @return Record value.
+ */
+extern void *get_value_from_int_dictionary(const p_dictionary dict, intptr_t key);
+
+/**
+ * @brief Check if integer keyed dictionary contains specified key.
+ *
+ * @param dict Dictionary created with DICTIONARY_MODE_INT_KEYS.
+ * @param key Record key.
+ * @return 1 if dictionary contains key, 0 otherwise.
+ */
+extern int contains_key_in_int_dictionary(const p_dictionary dict, intptr_t key);
+
 /**
  * @brief Get records from dictionary by key.
  *
  * @details
  * Get all matching records from specified dictionary by key.
  * Return the dictionary of records, if it exists else NULL.
+ * With a key index the k matching records are reached in O(k), otherwise
+ * the whole dictionary is scanned.
  *
  * @param dict Dictionary.
  * @param key Record key.
@@ -589,6 +1078,8 @@ extern p_record get_record_from_dictionary_by_value(const p_dictionary dict, voi
  * @details
  * Get all matching records from specified dictionary by value.
  * Return the dictionary of records, if it exists else NULL.
+ * With a value index the k matching records are reached in O(k), otherwise
+ * the whole dictionary is scanned.
  *
  * @param dict Dictionary.
  * @param value Record value.
@@ -685,6 +1176,26 @@ extern int iterate_over_dictionary(const p_dictionary dict, dictionary_iteration
 extern int iterate_over_dictionary_with_args(
     const p_dictionary dict, dictionary_iteration_callback_with_args callback, void *args);
 
+/**
+ * @brief Iterate over dictionary records with key prefix.
+ *
+ * @details
+ * Apply a callback function to each record whose key starts with prefix.
+ * With a key trie only matching records are visited, ordered by key and
+ * by dictionary order within a key, otherwise all records are scanned in
+ * dictionary order.
+ *
+ * @param dict Dictionary with string keys.
+ * @param prefix Key prefix.
+ * @param callback Callback function.
+ * @param args Arguments for callback function.
+ * @return Count of visited records, or a negative error code.
+ * IPEE_ERROR_CODE__DICTIONARY__INCOMPATIBLE_MODE for integer keys.
+ */
+extern int iterate_over_dictionary_prefix_with_args(
+    const p_dictionary dict, const char *prefix,
+    dictionary_iteration_callback_with_args callback, void *args);
+
 /**
  * @brief Iterate over keys of dictionary.
  *
@@ -861,11 +1372,12 @@ extern void *reduce_dictionary_with_args(
  * @brief Sort dictionary records.
  *
  * @details
- * Sort all records of specfied dictionary.
- * Apply a callback function to each record.
+ * Copy specified dictionary and sort the copy with stable merge sort.
+ * Records metadata is preserved. Complexity is O(n log n).
  *
  * @param dict Dictionary.
  * @param callback Callback function.
+ * @return Sorted dictionary.
  */
 extern p_dictionary sort_dictionary(
     const p_dictionary dict, dictionary_iteration_callback_sort callback);
@@ -874,14 +1386,219 @@ extern p_dictionary sort_dictionary(
  * @brief Sort dictionary records with arguments.
  *
  * @details
- * Sort all records of specfied dictionary.
- * Apply a callback function to each record.
+ * Copy specified dictionary and sort the copy with stable merge sort.
+ * Records metadata is preserved. Complexity is O(n log n).
  *
  * @param dict Dictionary.
  * @param callback Callback function.
  * @param args Arguments for callback function.
+ * @return Sorted dictionary.
  */
 extern p_dictionary sort_dictionary_with_args(
     const p_dictionary dict, dictionary_iteration_callback_sort_with_args callback, void *args);
 
+/**
+ * @brief Sort dictionary records in place.
+ *
+ * @details
+ * Sort specified dictionary with stable merge sort by relinking its records.
+ * No record is allocated or copied. Complexity is O(n log n).
+ *
+ * @param dict Dictionary.
+ * @param callback Callback function.
+ * @return 0 on success, or a negative error code.
+ */
+extern int sort_dictionary_in_place(
+    const p_dictionary dict, dictionary_iteration_callback_sort callback);
+
+/**
+ * @brief Sort dictionary records in place with arguments.
+ *
+ * @details
+ * Sort specified dictionary with stable merge sort by relinking its records.
+ * No record is allocated or copied. Complexity is O(n log n).
+ *
+ * @param dict Dictionary.
+ * @param callback Callback function.
+ * @param args Arguments for callback function.
+ * @return 0 on success, or a negative error code.
+ */
+extern int sort_dictionary_in_place_with_args(
+    const p_dictionary dict, dictionary_iteration_callback_sort_with_args callback, void *args);
+
+/**
+ * @brief Initialize dictionary query.
+ *
+ * @details
+ * Initialize an empty query over specified dictionary.
+ *
+ * @param query Query object.
+ * @param dict Source dictionary.
+ * @return Query, or NULL if query does not exist.
+ */
+extern p_dictionary_query init_dictionary_query(p_dictionary_query query, const p_dictionary dict);
+
+/**
+ * @brief Add filter stage to dictionary query.
+ *
+ * @param query Query object.
+ * @param callback Filter callback function.
+ * @return Query, or NULL if query does not exist or is full.
+ */
+extern p_dictionary_query filter_dictionary_query(
+    p_dictionary_query query, dictionary_iteration_callback_filter callback);
+
+/**
+ * @brief Add filter stage with arguments to dictionary query.
+ *
+ * @param query Query object.
+ * @param callback Filter callback function.
+ * @param args Arguments for callback function.
+ * @return Query, or NULL if query does not exist or is full.
+ */
+extern p_dictionary_query filter_dictionary_query_with_args(
+    p_dictionary_query query, dictionary_iteration_callback_filter_with_args callback, void *args);
+
+/**
+ * @brief Add map stage to dictionary query.
+ *
+ * @details
+ * Records returned by callback are passed to the next stage.
+ * NULL result drops the record.
+ *
+ * @param query Query object.
+ * @param callback Map callback function.
+ * @return Query, or NULL if query does not exist or is full.
+ */
+extern p_dictionary_query map_dictionary_query(
+    p_dictionary_query query, dictionary_iteration_callback_map callback);
+
+/**
+ * @brief Add map stage with arguments to dictionary query.
+ *
+ * @details
+ * Records returned by callback are passed to the next stage.
+ * NULL result drops the record.
+ *
+ * @param query Query object.
+ * @param callback Map callback function.
+ * @param args Arguments for callback function.
+ * @return Query, or NULL if query does not exist or is full.
+ */
+extern p_dictionary_query map_dictionary_query_with_args(
+    p_dictionary_query query, dictionary_iteration_callback_map_with_args callback, void *args);
+
+/**
+ * @brief Get first record of dictionary query.
+ *
+ * @details
+ * Stream records until the first one passes all stages.
+ *
+ * @param query Query object.
+ * @return Record, or NULL if there is no such record.
+ */
+extern p_record get_first_record_from_dictionary_query(p_dictionary_query query);
+
+/**
+ * @brief Count records of dictionary query.
+ *
+ * @param query Query object.
+ * @return Count of records which pass all stages, or a negative error code.
+ */
+extern int count_dictionary_query(p_dictionary_query query);
+
+/**
+ * @brief Check if any record passes dictionary query.
+ *
+ * @param query Query object.
+ * @return 1 if any record passes all stages, 0 otherwise.
+ */
+extern int any_in_dictionary_query(p_dictionary_query query);
+
+/**
+ * @brief Reduce records of dictionary query.
+ *
+ * @param query Query object.
+ * @param callback Callback function.
+ * @param acc Initial accumulator value.
+ * @return Accumulator.
+ */
+extern void *reduce_dictionary_query(
+    p_dictionary_query query, dictionary_iteration_callback_reduce callback, void *acc);
+
+/**
+ * @brief Reduce records of dictionary query with arguments.
+ *
+ * @param query Query object.
+ * @param callback Callback function.
+ * @param acc Initial accumulator value.
+ * @param args Arguments for callback function.
+ * @return Accumulator.
+ */
+extern void *reduce_dictionary_query_with_args(
+    p_dictionary_query query,
+    dictionary_iteration_callback_reduce_with_args callback,
+    void *acc, void *args);
+
+/**
+ * @brief Collect records of dictionary query.
+ *
+ * @details
+ * Materialize records which pass all stages into a new dictionary.
+ * Keys, values and metadata are copied.
+ *
+ * @param query Query object.
+ * @return Dictionary of records.
+ */
+extern p_dictionary collect_dictionary_query(p_dictionary_query query);
+
+/*********************************************************************************************
+ * CURSOR FUNCTIONS DEFINITIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Begin iteration over dictionary from head to tail.
+ *
+ * @param dict Dictionary.
+ * @return Cursor at the head record.
+ */
+static inline dictionary_cursor_t begin_dictionary_cursor(const p_dictionary dict) {
+    p_record record = dict ? dict->head : NULL;
+    return (dictionary_cursor_t){
+        .record = record, .next = record ? record->next : NULL, .reverse = 0};
+}
+
+/**
+ * @brief Begin iteration over dictionary from tail to head.
+ *
+ * @param dict Dictionary.
+ * @return Cursor at the tail record.
+ */
+static inline dictionary_cursor_t begin_reverse_dictionary_cursor(const p_dictionary dict) {
+    p_record record = dict ? dict->tail : NULL;
+    return (dictionary_cursor_t){
+        .record = record, .next = record ? record->prev : NULL, .reverse = 1};
+}
+
+/**
+ * @brief Check whether iteration is done.
+ *
+ * @param cursor Cursor.
+ * @return 1 if there is no current record, 0 otherwise.
+ */
+static inline int is_dictionary_cursor_done(const p_dictionary_cursor cursor) {
+    return !cursor->record;
+}
+
+/**
+ * @brief Move cursor to the next record in its direction.
+ *
+ * @param cursor Cursor.
+ */
+static inline void next_dictionary_cursor(p_dictionary_cursor cursor) {
+    p_record record = cursor->next;
+    cursor->record = record;
+    cursor->next = record ? (cursor->reverse ? record->prev : record->next) : NULL;
+}
+
 #endif // IPEE_DICTIONARY_H
@@ -11,6 +11,8 @@
 #ifndef IPEE_EVENT_H
 #define IPEE_EVENT_H
 
+#include <stddef.h>
+
 #include <dictionary.h>
 
 /*********************************************************************************************
@@ -198,4 +200,21 @@ extern int notify(const char *context, const char *event, void *args);
  */
 char *prepare_event_name(const char *context, const char *event, const int uniq_id);
 
+/**
+ * @brief Format event name into buffer.
+ *
+ * @details
+ * Same name as prepare_event_name, without allocation. The name is
+ * truncated if the buffer is too small.
+ *
+ * @param buffer Buffer for event name.
+ * @param size Buffer size.
+ * @param context Context to prepare event name for.
+ * @param event Event to prepare event name for.
+ * @param uniq_id Unique id to prepare event name for.
+ *
+ * @return Event name length without truncation.
+ */
+int format_event_name(char *buffer, size_t size, const char *context, const char *event, const int uniq_id);
+
 #endif // IPEE_EVENT_H
\ No newline at end of file
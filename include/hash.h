@@ -0,0 +1,98 @@
+/*********************************************************************************************
+ * @file hash.h
+ * @author chcp (cmewhou@yandex.ru)
+ * @brief Hash functions shared by collections.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ ********************************************************************************************/
+
+#ifndef IPEE_HASH_H
+#define IPEE_HASH_H
+
+/*********************************************************************************************
+ * INCLUDES DECLARATIONS
+ ********************************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*********************************************************************************************
+ * MACROS DECLARATIONS
+ ********************************************************************************************/
+
+#define HASH_INIT 2166136261u
+
+/*********************************************************************************************
+ * FUNCTIONS DEFINITIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Hash of a byte sequence.
+ *
+ * @details
+ * Data is consumed by 8 byte blocks, the tail block is mixed with the size.
+ *
+ * @param data      Pointer to data.
+ * @param size      Data size.
+ *
+ * @return Hash value.
+ */
+static inline uint32_t hash_data(const void *data, size_t size) {
+    const unsigned char *bytes = (const unsigned char *)data;
+    size_t nblocks = size / 8;
+    uint64_t hash = HASH_INIT;
+    for (size_t i = 0; i < nblocks; ++i) {
+        hash ^= (uint64_t)bytes[0] << 0 | (uint64_t)bytes[1] << 8 |
+                (uint64_t)bytes[2] << 16 | (uint64_t)bytes[3] << 24 |
+                (uint64_t)bytes[4] << 32 | (uint64_t)bytes[5] << 40 |
+                (uint64_t)bytes[6] << 48 | (uint64_t)bytes[7] << 56;
+        hash *= 0xbf58476d1ce4e5b9;
+        bytes += 8;
+    }
+
+    uint64_t last = size & 0xff;
+    switch (size % 8) {
+    case 7:
+        last |= (uint64_t)bytes[6] << 56;
+    case 6:
+        last |= (uint64_t)bytes[5] << 48;
+    case 5:
+        last |= (uint64_t)bytes[4] << 40;
+    case 4:
+        last |= (uint64_t)bytes[3] << 32;
+    case 3:
+        last |= (uint64_t)bytes[2] << 24;
+    case 2:
+        last |= (uint64_t)bytes[1] << 16;
+    case 1:
+        last |= (uint64_t)bytes[0] << 8;
+        hash ^= last;
+        hash *= 0xd6e8feb86659fd93;
+    }
+
+    return (uint32_t)(hash ^ hash >> 32);
+}
+
+/**
+ * @brief Hash of a 64-bit integer.
+ *
+ * @details
+ * Murmur3 finalizer, every input bit affects every output bit, so
+ * sequential ids and aligned pointers spread evenly.
+ *
+ * @param value     Integer value.
+ *
+ * @return Hash value.
+ */
+static inline uint32_t hash_u64(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccd;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53;
+    value ^= value >> 33;
+    return (uint32_t)value;
+}
+
+#endif // IPEE_HASH_H
@@ -15,6 +15,7 @@
  * INCLUDES DECLARATIONS
  ********************************************************************************************/
 
+#include <stddef.h>
 #include <stdint.h>
 
 /*********************************************************************************************
@@ -40,6 +41,24 @@ typedef struct hashmap_s hashmap_t, *p_hashmap;
 
 typedef const void * p_key;
 
+/**
+ * @brief Hashmap with 64-bit integer keys.
+ * 
+ * @details
+ * Keys are stored in the buckets, so lookups compare integers instead of
+ * key memory and a bucket takes 16 bytes. Shares the table engine with
+ * hashmap_t, iteration follows the table order, not the insertion order.
+ */
+typedef struct hashmap_u64_s hashmap_u64_t, *p_hashmap_u64;
+
+/**
+ * @brief Hashmap with pointer keys.
+ * 
+ * @details
+ * Keys are compared by address, pointed memory is never read.
+ */
+typedef struct hashmap_ptr_s hashmap_ptr_t, *p_hashmap_ptr;
+
 /***********************************************************************************************
  * FUNCTION TYPEDEFS
  **********************************************************************************************/
@@ -52,6 +71,31 @@ typedef const void * p_key;
  */
 typedef void (*hashmap_iteration_callback)(p_key key, void *value);
 
+/**
+ * @brief Callback function for processing sized keys and values of hashmap collection.
+ * 
+ * @param key       Pointer to key for bucket entry.
+ * @param ksize     Key size in bytes.
+ * @param value     Pointer to value in bucket entry.
+ */
+typedef void (*hashmap_iteration_callback_n)(p_key key, size_t ksize, void *value);
+
+/**
+ * @brief Callback function for processing keys and values of integer key hashmap.
+ * 
+ * @param key       Bucket entry key.
+ * @param value     Pointer to value in bucket entry.
+ */
+typedef void (*hashmap_u64_iteration_callback)(uint64_t key, void *value);
+
+/**
+ * @brief Callback function for processing keys and values of pointer key hashmap.
+ * 
+ * @param key       Bucket entry key.
+ * @param value     Pointer to value in bucket entry.
+ */
+typedef void (*hashmap_ptr_iteration_callback)(const void *key, void *value);
+
 /*********************************************************************************************
  * FUNCTIONS DECLARATIONS
  ********************************************************************************************/
@@ -72,6 +116,21 @@ extern p_hashmap hashmap_create(void);
  */
 extern void hashmap_set_entry(p_hashmap map, p_key key, void *value);
 
+/**
+ * @brief Set entry with sized key in hashmap.
+ * 
+ * @details
+ * Key is any byte sequence, it is not copied and has to outlive the entry.
+ * String keys set by hashmap_set_entry are the same as sized keys without
+ * the terminating NUL.
+ * 
+ * @param map       Pointer to hashmap.
+ * @param key       Pointer to key for bucket entry.
+ * @param ksize     Key size in bytes.
+ * @param value     Value in bucket entry.
+ */
+extern void hashmap_set_entry_n(p_hashmap map, p_key key, size_t ksize, void *value);
+
 /**
  * @brief Get entry in hashmap.
  * 
@@ -82,6 +141,17 @@ extern void hashmap_set_entry(p_hashmap map, p_key key, void *value);
  */
 extern void *hashmap_get_entry(p_hashmap map, p_key key);
 
+/**
+ * @brief Get entry with sized key in hashmap.
+ * 
+ * @param map       Pointer to hashmap.
+ * @param key       Pointer to key for bucket entry.
+ * @param ksize     Key size in bytes.
+ * 
+ * @return Pointer to bucket value.
+ */
+extern void *hashmap_get_entry_n(p_hashmap map, p_key key, size_t ksize);
+
 /**
  * @brief Remove entry in hashmap.
  * 
@@ -90,6 +160,15 @@ extern void *hashmap_get_entry(p_hashmap map, p_key key);
  */
 extern void hashmap_remove_entry(p_hashmap map, p_key key);
 
+/**
+ * @brief Remove entry with sized key in hashmap.
+ * 
+ * @param map       Pointer to hashmap.
+ * @param key       Pointer to key for bucket entry.
+ * @param ksize     Key size in bytes.
+ */
+extern void hashmap_remove_entry_n(p_hashmap map, p_key key, size_t ksize);
+
 /**
  * @brief Remove all entries in hashmap.
  * 
@@ -121,4 +200,142 @@ extern int hashmap_get_count(p_hashmap map);
  */
 extern void hashmap_iterate(p_hashmap map, hashmap_iteration_callback callback);
 
+/**
+ * @brief Iterate over hashmap with key sizes.
+ * 
+ * @param map       Pointer to hashmap.
+ * @param callback  Callback function.
+ */
+extern void hashmap_iterate_n(p_hashmap map, hashmap_iteration_callback_n callback);
+
+/**
+ * @brief Create integer key hashmap.
+ * 
+ * @return Pointer to hashmap.
+ */
+extern p_hashmap_u64 hashmap_u64_create(void);
+
+/**
+ * @brief Set entry in integer key hashmap.
+ * 
+ * @param map       Pointer to hashmap.
+ * @param key       Bucket entry key.
+ * @param value     Value in bucket entry.
+ */
+extern void hashmap_u64_set_entry(p_hashmap_u64 map, uint64_t key, void *value);
+
+/**
+ * @brief Get entry in integer key hashmap.
+ * 
+ * @param map       Pointer to hashmap.
+ * @param key       Bucket entry key.
+ * 
+ * @return Pointer to bucket value.
+ */
+extern void *hashmap_u64_get_entry(p_hashmap_u64 map, uint64_t key);
+
+/**
+ * @brief Remove entry in integer key hashmap.
+ * 
+ * @param map       Pointer to hashmap.
+ * @param key       Bucket entry key.
+ */
+extern void hashmap_u64_remove_entry(p_hashmap_u64 map, uint64_t key);
+
+/**
+ * @brief Remove all entries in integer key hashmap.
+ * 
+ * @param map       Pointer to hashmap.
+ */
+extern void hashmap_u64_remove_all_entries(p_hashmap_u64 map);
+
+/**
+ * @brief Remove integer key hashmap.
+ * 
+ * @param map       Hashmap object reference.
+ */
+extern void hashmap_u64_remove(p_hashmap_u64 *map);
+
+/**
+ * @brief Get number of items in integer key hashmap.
+ * 
+ * @param map       Pointer to hashmap.
+ * 
+ * @return Number of items
+ */
+extern int hashmap_u64_get_count(p_hashmap_u64 map);
+
+/**
+ * @brief Iterate over integer key hashmap in table order.
+ * 
+ * @param map       Pointer to hashmap.
+ * @param callback  Callback function.
+ */
+extern void hashmap_u64_iterate(p_hashmap_u64 map, hashmap_u64_iteration_callback callback);
+
+/**
+ * @brief Create pointer key hashmap.
+ * 
+ * @return Pointer to hashmap.
+ */
+extern p_hashmap_ptr hashmap_ptr_create(void);
+
+/**
+ * @brief Set entry in pointer key hashmap.
+ * 
+ * @param map       Pointer to hashmap.
+ * @param key       Bucket entry key.
+ * @param value     Value in bucket entry.
+ */
+extern void hashmap_ptr_set_entry(p_hashmap_ptr map, const void *key, void *value);
+
+/**
+ * @brief Get entry in pointer key hashmap.
+ * 
+ * @param map       Pointer to hashmap.
+ * @param key       Bucket entry key.
+ * 
+ * @return Pointer to bucket value.
+ */
+extern void *hashmap_ptr_get_entry(p_hashmap_ptr map, const void *key);
+
+/**
+ * @brief Remove entry in pointer key hashmap.
+ * 
+ * @param map       Pointer to hashmap.
+ * @param key       Bucket entry key.
+ */
+extern void hashmap_ptr_remove_entry(p_hashmap_ptr map, const void *key);
+
+/**
+ * @brief Remove all entries in pointer key hashmap.
+ * 
+ * @param map       Pointer to hashmap.
+ */
+extern void hashmap_ptr_remove_all_entries(p_hashmap_ptr map);
+
+/**
+ * @brief Remove pointer key hashmap.
+ * 
+ * @param map       Hashmap object reference.
+ */
+extern void hashmap_ptr_remove(p_hashmap_ptr *map);
+
+/**
+ * @brief Get number of items in pointer key hashmap.
+ * 
+ * @param map       Pointer to hashmap.
+ * 
+ * @return Number of items
+ */
+extern int hashmap_ptr_get_count(p_hashmap_ptr map);
+
+/**
+ * @brief Iterate over pointer key hashmap in table order.
+ * 
+ * @param map       Pointer to hashmap.
+ * @param callback  Callback function.
+ */
+extern void hashmap_ptr_iterate(p_hashmap_ptr map, hashmap_ptr_iteration_callback callback);
+
 #endif // IPEE_HASHMAP_H
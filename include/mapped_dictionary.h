@@ -0,0 +1,161 @@
+/*********************************************************************************************
+ * @file mapped_dictionary.h
+ * @author chcp (cmewhou@yandex.ru)
+ * @brief Binary dictionary files and read-only dictionaries mapped from them.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ ********************************************************************************************/
+
+#ifndef IPEE_MAPPED_DICTIONARY_H
+#define IPEE_MAPPED_DICTIONARY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <dictionary.h>
+
+/*********************************************************************************************
+ * ERROR CODES
+ ********************************************************************************************/
+
+typedef enum ipee_mapped_dictionary_error_code_e {
+    IPEE_ERROR_CODE__MAPPED_DICTIONARY__NOT_EXISTS         = -1, // Dictionary does not exist.
+    IPEE_ERROR_CODE__MAPPED_DICTIONARY__FILE_ERROR         = -2, // Failed to write, open or map file.
+    IPEE_ERROR_CODE__MAPPED_DICTIONARY__INVALID_FORMAT     = -3, // File is not a dictionary file.
+    IPEE_ERROR_CODE__MAPPED_DICTIONARY__ALLOCATION_ERROR   = -4, // Failed to allocate memory.
+    IPEE_ERROR_CODE__MAPPED_DICTIONARY__INDEX_OUT_OF_RANGE = -5, // Index is out of valid range.
+} ipee_mapped_dictionary_error_code_t, *p_mapped_dictionary_error_code;
+
+/*********************************************************************************************
+ * STRUCTS DECLARATIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Read-only dictionary mapped from a file.
+ *
+ * @details
+ * Dictionary file holds a header, offsets of records in dictionary order,
+ * an open addressing table of record numbers by key hash and the records:
+ * key with its terminator and value bytes, both aligned to 8 bytes. Keys
+ * and values returned by the dictionary point directly into the mapping,
+ * so opening a file costs no per-record allocations and pages are read
+ * only when records on them are accessed.
+ *
+ * @warning
+ * Files use native byte order. Keys and values are valid until the
+ * dictionary is unloaded.
+ */
+typedef struct mapped_dictionary_s mapped_dictionary_t, *p_mapped_dictionary;
+
+/***********************************************************************************************
+ * FUNCTION TYPEDEFS
+ **********************************************************************************************/
+
+/**
+ * @brief Callback function for getting size of record value.
+ *
+ * @param record Record.
+ * @return Count of value bytes to save.
+ */
+typedef size_t (*dictionary_value_size_callback)(const p_record record);
+
+/*********************************************************************************************
+ * FUNCTIONS DECLARATIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Save dictionary with fixed-size values to file.
+ *
+ * @details
+ * Values are pointers to value_size bytes. NULL keys are saved as empty
+ * strings, NULL values as zero bytes.
+ *
+ * @param dict Dictionary.
+ * @param path File path.
+ * @param value_size Size of each value.
+ * @return 0 on success, error code otherwise.
+ */
+extern int save_dictionary(const p_dictionary dict, const char *path, size_t value_size);
+
+/**
+ * @brief Save dictionary with variable-size values to file.
+ *
+ * @param dict Dictionary.
+ * @param path File path.
+ * @param callback Callback function returning size of each value.
+ * @return 0 on success, error code otherwise.
+ */
+extern int save_dictionary_with_sizes(
+    const p_dictionary dict, const char *path, dictionary_value_size_callback callback);
+
+/**
+ * @brief Load dictionary file.
+ *
+ * @details
+ * Map file read-only. Only the header is checked, records are reached
+ * lazily.
+ *
+ * @param path File path.
+ * @return Mapped dictionary, or NULL on failure.
+ */
+extern p_mapped_dictionary load_dictionary(const char *path);
+
+/**
+ * @brief Unload dictionary file.
+ *
+ * @param dict Mapped dictionary.
+ * @return 0 on success, error code otherwise.
+ */
+extern int unload_dictionary(p_mapped_dictionary dict);
+
+/**
+ * @brief Get count of records in mapped dictionary.
+ *
+ * @param dict Mapped dictionary.
+ * @return Count of records, error code otherwise.
+ */
+extern int get_mapped_dictionary_size(const p_mapped_dictionary dict);
+
+/**
+ * @brief Get value from mapped dictionary by key.
+ *
+ * @details
+ * Get value of first matching record in O(1) through the hash table of
+ * the file.
+ *
+ * @param dict Mapped dictionary.
+ * @param key Record key.
+ * @param length Value length output, may be NULL.
+ * @return Record value, NULL if there is no record.
+ */
+extern const void *get_value_from_mapped_dictionary(const p_mapped_dictionary dict, const char *key, size_t *length);
+
+/**
+ * @brief Get record from mapped dictionary by index.
+ *
+ * @details
+ * Record is a view into the mapping, metadata is not saved.
+ *
+ * @param dict Mapped dictionary.
+ * @param index Record index.
+ * @param record Record output.
+ * @param length Value length output, may be NULL.
+ * @return 0 on success, error code otherwise.
+ */
+extern int get_record_from_mapped_dictionary_by_index(
+    const p_mapped_dictionary dict, int index, p_record record, size_t *length);
+
+/**
+ * @brief Iterate over mapped dictionary.
+ *
+ * @param dict Mapped dictionary.
+ * @param callback Callback function.
+ * @param args Arguments for callback function.
+ * @return 0 on success, error code otherwise.
+ */
+extern int iterate_over_mapped_dictionary_with_args(
+    const p_mapped_dictionary dict, dictionary_iteration_callback_with_args callback, void *args);
+
+#endif // IPEE_MAPPED_DICTIONARY_H
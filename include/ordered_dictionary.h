@@ -0,0 +1,216 @@
+/*********************************************************************************************
+ * @file ordered_dictionary.h
+ * @author chcp (cmewhou@yandex.ru)
+ * @brief Ordered <key:value> map based on skip list with range queries.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ ********************************************************************************************/
+
+#ifndef IPEE_ORDERED_DICTIONARY_H
+#define IPEE_ORDERED_DICTIONARY_H
+
+#include <stddef.h>
+
+#include <dictionary.h>
+
+/*********************************************************************************************
+ * ERROR CODES
+ ********************************************************************************************/
+
+typedef enum ipee_ordered_dictionary_error_code_e {
+    IPEE_ERROR_CODE__ORDERED_DICTIONARY__NOT_EXISTS            = -1, // Dictionary does not exist.
+    IPEE_ERROR_CODE__ORDERED_DICTIONARY__RECORD_CREATION_ERROR = -2, // Failed to allocate a record.
+} ipee_ordered_dictionary_error_code_t, *p_ordered_dictionary_error_code;
+
+/*********************************************************************************************
+ * STRUCTS DECLARATIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Ordered dictionary record.
+ *
+ * @details
+ * Node of the skip list. Records are linked in key order on level 0, upper
+ * levels skip over runs of records, so a search descends in O(log n).
+ * key - record key.
+ * value - record value.
+ * level - count of levels the record is linked on.
+ * next - next record on each level.
+ */
+typedef struct ordered_record_s {
+    char *key;                       // Record key.
+    void *value;                     // Record value.
+    int level;                       // Count of levels.
+    struct ordered_record_s *next[]; // Next records by level.
+} ordered_record_t, *p_ordered_record;
+
+/**
+ * @brief Ordered dictionary collection.
+ *
+ * @details
+ * Collection of records with unique keys ordered by strcmp. Lookup,
+ * insertion and removal are O(log n) expected, bounds and range scans
+ * start at the first matching record instead of the head.
+ *
+ * @warning
+ * The implementation is mutable, not thread-safe and not reentrant.
+ * Keys are not copied, they have to outlive their records.
+ */
+typedef struct ordered_dictionary_s ordered_dictionary_t, *p_ordered_dictionary;
+
+/*********************************************************************************************
+ * FUNCTIONS DECLARATIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Create ordered dictionary.
+ *
+ * @return Dictionary, or NULL on allocation failure.
+ */
+extern p_ordered_dictionary create_ordered_dictionary(void);
+
+/**
+ * @brief Delete ordered dictionary.
+ *
+ * @param dict Dictionary.
+ * @return 0 on success, error code otherwise.
+ */
+extern int delete_ordered_dictionary(p_ordered_dictionary dict);
+
+/**
+ * @brief Add record to ordered dictionary.
+ *
+ * @details
+ * Value of existing record with the same key is replaced.
+ *
+ * @param dict Dictionary.
+ * @param key Record key.
+ * @param value Record value.
+ * @return 0 on success, error code otherwise.
+ */
+extern int add_record_to_ordered_dictionary(const p_ordered_dictionary dict, char *key, void *value);
+
+/**
+ * @brief Remove record from ordered dictionary.
+ *
+ * @param dict Dictionary.
+ * @param key Record key.
+ * @return Value of removed record, NULL if there is no record.
+ */
+extern void *remove_record_from_ordered_dictionary(const p_ordered_dictionary dict, const char *key);
+
+/**
+ * @brief Get record from ordered dictionary.
+ *
+ * @param dict Dictionary.
+ * @param key Record key.
+ * @return Record, NULL if there is no record.
+ */
+extern p_ordered_record get_record_from_ordered_dictionary(const p_ordered_dictionary dict, const char *key);
+
+/**
+ * @brief Get value from ordered dictionary.
+ *
+ * @param dict Dictionary.
+ * @param key Record key.
+ * @return Record value, NULL if there is no record.
+ */
+extern void *get_value_from_ordered_dictionary(const p_ordered_dictionary dict, const char *key);
+
+/**
+ * @brief Get count of records in ordered dictionary.
+ *
+ * @param dict Dictionary.
+ * @return Count of records, error code otherwise.
+ */
+extern int get_ordered_dictionary_size(const p_ordered_dictionary dict);
+
+/**
+ * @brief Get record with the least key.
+ *
+ * @param dict Dictionary.
+ * @return Record, NULL if dictionary is empty.
+ */
+extern p_ordered_record get_first_record_from_ordered_dictionary(const p_ordered_dictionary dict);
+
+/**
+ * @brief Get first record with key not less than specified one.
+ *
+ * @param dict Dictionary.
+ * @param key Bound key.
+ * @return Record, NULL if there is no such record.
+ */
+extern p_ordered_record lower_bound_in_ordered_dictionary(const p_ordered_dictionary dict, const char *key);
+
+/**
+ * @brief Get first record with key greater than specified one.
+ *
+ * @param dict Dictionary.
+ * @param key Bound key.
+ * @return Record, NULL if there is no such record.
+ */
+extern p_ordered_record upper_bound_in_ordered_dictionary(const p_ordered_dictionary dict, const char *key);
+
+/**
+ * @brief Iterate over ordered dictionary in key order.
+ *
+ * @param dict Dictionary.
+ * @param callback Callback function.
+ * @param args Arguments for callback function.
+ * @return 0 on success, error code otherwise.
+ */
+extern int iterate_over_ordered_dictionary_with_args(
+    const p_ordered_dictionary dict, dictionary_iteration_callback_with_args callback, void *args);
+
+/**
+ * @brief Iterate over records with keys in range.
+ *
+ * @details
+ * Visit records with from <= key < to in key order. NULL bound leaves the
+ * range open on its side.
+ *
+ * @param dict Dictionary.
+ * @param from Inclusive lower bound, may be NULL.
+ * @param to Exclusive upper bound, may be NULL.
+ * @param callback Callback function.
+ * @param args Arguments for callback function.
+ * @return Count of visited records, error code otherwise.
+ */
+extern int iterate_over_ordered_dictionary_range_with_args(
+    const p_ordered_dictionary dict, const char *from, const char *to,
+    dictionary_iteration_callback_with_args callback, void *args);
+
+/**
+ * @brief Iterate over records with keys starting with prefix.
+ *
+ * @details
+ * Unlike range bounds, prefix can not be NULL. Empty prefix visits every
+ * record with a non NULL key.
+ *
+ * @param dict Dictionary.
+ * @param prefix Key prefix.
+ * @param callback Callback function.
+ * @param args Arguments for callback function.
+ * @return Count of visited records, error code otherwise, including NULL prefix.
+ */
+extern int iterate_over_ordered_dictionary_prefix_with_args(
+    const p_ordered_dictionary dict, const char *prefix,
+    dictionary_iteration_callback_with_args callback, void *args);
+
+/*********************************************************************************************
+ * RECORD FUNCTIONS DEFINITIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Get next record in key order.
+ *
+ * @param record Record.
+ * @return Next record, NULL if record is the last one.
+ */
+static inline p_ordered_record get_next_ordered_record(const p_ordered_record record) {
+    return record ? record->next[0] : NULL;
+}
+
+#endif // IPEE_ORDERED_DICTIONARY_H
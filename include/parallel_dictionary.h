@@ -0,0 +1,138 @@
+/*********************************************************************************************
+ * @file parallel_dictionary.h
+ * @author chcp (cmewhou@yandex.ru)
+ * @brief Parallel transformations of dictionaries on the thread pool.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ ********************************************************************************************/
+
+#ifndef IPEE_PARALLEL_DICTIONARY_H
+#define IPEE_PARALLEL_DICTIONARY_H
+
+#include <stddef.h>
+
+#include <dictionary.h>
+
+/***********************************************************************************************
+ * FUNCTION TYPEDEFS
+ **********************************************************************************************/
+
+/**
+ * @brief Callback function for combining partial accumulators.
+ *
+ * @details
+ * Partial accumulators are combined in dictionary order, so the operation
+ * has to be associative, but not necessarily commutative.
+ *
+ * @param acc Accumulator.
+ * @param chunk_acc Accumulator of a chunk of records.
+ */
+typedef void (*dictionary_iteration_callback_combine)(void *acc, const void *chunk_acc);
+
+/*********************************************************************************************
+ * FUNCTIONS DECLARATIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Map dictionary in parallel.
+ *
+ * @details
+ * Records are split into contiguous chunks processed by the thread pool
+ * workers and the calling thread. Result keeps the order of the source
+ * dictionary. Returned record is copied at once, so the callback may reuse
+ * thread local storage for it. If the thread pool is not initialized or
+ * has no free workers, chunks are processed by the calling thread.
+ *
+ * @warning
+ * Callback is invoked concurrently and must be thread-safe. The dictionary
+ * must not be modified until the function returns.
+ *
+ * @param dict Dictionary.
+ * @param callback Callback function.
+ * @return Mapped dictionary.
+ */
+extern p_dictionary parallel_map_dictionary(
+    const p_dictionary dict, dictionary_iteration_callback_map callback);
+
+/**
+ * @brief Map dictionary in parallel.
+ *
+ * @param dict Dictionary.
+ * @param callback Callback function.
+ * @param args Arguments for callback function.
+ * @return Mapped dictionary.
+ */
+extern p_dictionary parallel_map_dictionary_with_args(
+    const p_dictionary dict, dictionary_iteration_callback_map_with_args callback, void *args);
+
+/**
+ * @brief Filter dictionary in parallel.
+ *
+ * @details
+ * Same partitioning as parallel_map_dictionary, result keeps the order of
+ * the source dictionary.
+ *
+ * @warning
+ * Callback is invoked concurrently and must be thread-safe.
+ *
+ * @param dict Dictionary.
+ * @param callback Callback function.
+ * @return Filtered dictionary.
+ */
+extern p_dictionary parallel_filter_dictionary(
+    const p_dictionary dict, dictionary_iteration_callback_filter callback);
+
+/**
+ * @brief Filter dictionary in parallel.
+ *
+ * @param dict Dictionary.
+ * @param callback Callback function.
+ * @param args Arguments for callback function.
+ * @return Filtered dictionary.
+ */
+extern p_dictionary parallel_filter_dictionary_with_args(
+    const p_dictionary dict, dictionary_iteration_callback_filter_with_args callback, void *args);
+
+/**
+ * @brief Reduce dictionary in parallel.
+ *
+ * @details
+ * Each chunk of records is reduced into its own accumulator of acc_size
+ * bytes initialized from identity, or zeroed if identity is NULL. Then
+ * chunk accumulators are combined into acc in dictionary order.
+ *
+ * @warning
+ * Callback is invoked concurrently and must be thread-safe.
+ *
+ * @param dict Dictionary.
+ * @param callback Callback function.
+ * @param combiner Combiner of partial accumulators.
+ * @param acc Accumulator.
+ * @param acc_size Size of accumulator.
+ * @param identity Initial value of chunk accumulators.
+ * @return Accumulator, or NULL on failure.
+ */
+extern void *parallel_reduce_dictionary(
+    const p_dictionary dict, dictionary_iteration_callback_reduce callback,
+    dictionary_iteration_callback_combine combiner, void *acc, size_t acc_size, const void *identity);
+
+/**
+ * @brief Reduce dictionary in parallel.
+ *
+ * @param dict Dictionary.
+ * @param callback Callback function.
+ * @param combiner Combiner of partial accumulators.
+ * @param acc Accumulator.
+ * @param acc_size Size of accumulator.
+ * @param identity Initial value of chunk accumulators.
+ * @param args Arguments for callback function.
+ * @return Accumulator, or NULL on failure.
+ */
+extern void *parallel_reduce_dictionary_with_args(
+    const p_dictionary dict, dictionary_iteration_callback_reduce_with_args callback,
+    dictionary_iteration_callback_combine combiner, void *acc, size_t acc_size,
+    const void *identity, void *args);
+
+#endif // IPEE_PARALLEL_DICTIONARY_H
@@ -0,0 +1,161 @@
+/*********************************************************************************************
+ * @file persistent_dictionary.h
+ * @author chcp (cmewhou@yandex.ru)
+ * @brief <key:value> pair collection with O(1) immutable snapshots.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ ********************************************************************************************/
+
+#ifndef IPEE_PERSISTENT_DICTIONARY_H
+#define IPEE_PERSISTENT_DICTIONARY_H
+
+#include <dictionary.h>
+
+/*********************************************************************************************
+ * ERROR CODES
+ ********************************************************************************************/
+
+typedef enum ipee_persistent_dictionary_error_code_e {
+    IPEE_ERROR_CODE__PERSISTENT_DICTIONARY__NOT_EXISTS            = -1, // Dictionary does not exist.
+    IPEE_ERROR_CODE__PERSISTENT_DICTIONARY__RECORD_CREATION_ERROR = -2, // Failed to allocate a record.
+    IPEE_ERROR_CODE__PERSISTENT_DICTIONARY__SNAPSHOT_NOT_EXISTS   = -3, // Snapshot does not exist.
+} ipee_persistent_dictionary_error_code_t, *p_persistent_dictionary_error_code;
+
+/*********************************************************************************************
+ * STRUCTS DECLARATIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Persistent dictionary collection.
+ *
+ * @details
+ * Collection of records with unique keys ordered by key. Records live in a
+ * treap whose nodes are shared between the dictionary and its snapshots:
+ * a mutation copies only the nodes on its path that are still referenced
+ * by a snapshot, nodes owned by the dictionary alone are changed in place.
+ *
+ * @warning
+ * Keys are not copied, they have to outlive every snapshot holding them.
+ * The dictionary itself is not thread-safe, snapshots are immutable and
+ * can be read and released from any thread.
+ */
+typedef struct persistent_dictionary_s persistent_dictionary_t, *p_persistent_dictionary;
+
+/**
+ * @brief Immutable snapshot of persistent dictionary.
+ */
+typedef struct dictionary_snapshot_s dictionary_snapshot_t, *p_dictionary_snapshot;
+
+/*********************************************************************************************
+ * FUNCTIONS DECLARATIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Create persistent dictionary.
+ *
+ * @return Dictionary, or NULL on allocation failure.
+ */
+extern p_persistent_dictionary create_persistent_dictionary(void);
+
+/**
+ * @brief Delete persistent dictionary.
+ *
+ * @details
+ * Records still referenced by snapshots are freed with the last snapshot.
+ *
+ * @param dict Dictionary.
+ * @return 0 on success, error code otherwise.
+ */
+extern int delete_persistent_dictionary(p_persistent_dictionary dict);
+
+/**
+ * @brief Add record to persistent dictionary.
+ *
+ * @details
+ * Value of existing record with the same key is replaced.
+ *
+ * @param dict Dictionary.
+ * @param key Record key.
+ * @param value Record value.
+ * @return 0 on success, error code otherwise.
+ */
+extern int add_record_to_persistent_dictionary(const p_persistent_dictionary dict, char *key, void *value);
+
+/**
+ * @brief Remove record from persistent dictionary.
+ *
+ * @param dict Dictionary.
+ * @param key Record key.
+ * @return Value of removed record.
+ */
+extern void *remove_record_from_persistent_dictionary(const p_persistent_dictionary dict, char *key);
+
+/**
+ * @brief Get value from persistent dictionary by key.
+ *
+ * @param dict Dictionary.
+ * @param key Record key.
+ * @return Record value, NULL if there is no record.
+ */
+extern void *get_value_from_persistent_dictionary(const p_persistent_dictionary dict, char *key);
+
+/**
+ * @brief Get count of records in persistent dictionary.
+ *
+ * @param dict Dictionary.
+ * @return Count of records, error code otherwise.
+ */
+extern int get_persistent_dictionary_size(const p_persistent_dictionary dict);
+
+/**
+ * @brief Take snapshot of persistent dictionary.
+ *
+ * @details
+ * The snapshot shares all records with the dictionary, so it takes O(1)
+ * regardless of size. Later mutations of the dictionary are not visible
+ * in the snapshot.
+ *
+ * @param dict Dictionary.
+ * @return Snapshot, or NULL on failure.
+ */
+extern p_dictionary_snapshot snapshot_dictionary(const p_persistent_dictionary dict);
+
+/**
+ * @brief Release snapshot.
+ *
+ * @param snapshot Snapshot.
+ * @return 0 on success, error code otherwise.
+ */
+extern int release_dictionary_snapshot(p_dictionary_snapshot snapshot);
+
+/**
+ * @brief Get value from snapshot by key.
+ *
+ * @param snapshot Snapshot.
+ * @param key Record key.
+ * @return Record value, NULL if there is no record.
+ */
+extern void *get_value_from_dictionary_snapshot(const p_dictionary_snapshot snapshot, char *key);
+
+/**
+ * @brief Get count of records in snapshot.
+ *
+ * @param snapshot Snapshot.
+ * @return Count of records, error code otherwise.
+ */
+extern int get_dictionary_snapshot_size(const p_dictionary_snapshot snapshot);
+
+/**
+ * @brief Iterate over snapshot in key order.
+ *
+ * @param snapshot Snapshot.
+ * @param callback Callback function.
+ * @param args Arguments for callback function.
+ * @return 0 on success, error code otherwise.
+ */
+extern int iterate_over_dictionary_snapshot_with_args(
+    const p_dictionary_snapshot snapshot, dictionary_iteration_callback_with_args callback, void *args);
+
+#endif // IPEE_PERSISTENT_DICTIONARY_H
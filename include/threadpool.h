@@ -13,6 +13,12 @@
 
 #include <pthread.h>
 
+/*********************************************************************************************
+ * MACROS DECLARATIONS
+ ********************************************************************************************/
+
+#define TASK_EVENT_NAME_SIZE 48 // Completion event name with any task id.
+
 /*********************************************************************************************
  * ERROR CODES
  ********************************************************************************************/
@@ -45,13 +51,13 @@ typedef struct thread_s thread_t, *p_thread;
  * @brief Task metadata.
  */
 typedef struct task_metadata_s {
-    int task_id;                            // Task Id.
-    char *task_event_name;                  // Task event name.
-    p_thread thread;                        // Thread.
-    void *(*callback)(void *args);          // Task callback.
-    void *args;                             // Task callback arguments.
-    void (*release_callback)(p_task *task); // Task release callback.
-    task_release_type_t release_type;       // Task release type.
+    int task_id;                                // Task Id.
+    char task_event_name[TASK_EVENT_NAME_SIZE]; // Task event name.
+    p_thread thread;                            // Thread.
+    void *(*callback)(void *args);              // Task callback.
+    void *args;                                 // Task callback arguments.
+    void (*release_callback)(p_task *task);     // Task release callback.
+    task_release_type_t release_type;           // Task release type.
 } task_metadata_t, *p_task_metadata;
 
 /**
@@ -116,6 +122,13 @@ typedef void (*threadpool_release_callback)(p_task task);
  */
 extern int set_threadpool_size(int size);
 
+/**
+ * @brief Get thread pool size.
+ *
+ * @return Count of worker threads, or a negative error code if the pool is not initialized.
+ */
+extern int get_threadpool_size(void);
+
 /**
  * @brief Set internal task counter limit.
  *
@@ -211,6 +224,15 @@ extern p_task as_manual(p_task task);
  */
 extern p_task run_task_with_args(p_task task, void *args);
 
+/**
+ * @brief Run task if a thread is idle.
+ * @details Unlike run_task(), never waits for a thread to become idle.
+ *
+ * @param task Task.
+ * @return Task, NULL if every thread is busy.
+ */
+extern p_task try_run_task(p_task task);
+
 /**
  * @brief Start new task.
  * @details It is an equivalent for run_task(make_task(...)).
@@ -229,6 +251,18 @@ extern p_task start_task(threadpool_task_callback task_callback, void *args);
  */
 extern void *await_task(p_task task);
 
+/**
+ * @brief Release task which is not running.
+ *
+ * @details
+ * Invoke release callback of a task which was made but was not run,
+ * for example because run_task failed to find a free thread.
+ *
+ * @param task Task.
+ * @return 0 on success, or a negative error code.
+ */
+extern int release_task(p_task task);
+
 /**
  * @brief Destroy task pool.
  * @return 0 on success, or a negative error code.
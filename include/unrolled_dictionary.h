@@ -0,0 +1,424 @@
+/*********************************************************************************************
+ * @file unrolled_dictionary.h
+ * @author chcp (cmewhou@yandex.ru)
+ * @brief Ordered <key:value> pair collection based on unrolled linked list.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ ********************************************************************************************/
+
+#ifndef IPEE_UNROLLED_DICTIONARY_H
+#define IPEE_UNROLLED_DICTIONARY_H
+
+#include <stdint.h>
+
+#include <dictionary.h>
+
+/*********************************************************************************************
+ * MACROS DECLARATIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Count of record slots in one node.
+ */
+#define UNROLLED_DICTIONARY_BLOCK_SIZE 16
+
+/*********************************************************************************************
+ * ERROR CODES
+ ********************************************************************************************/
+
+typedef enum ipee_unrolled_dictionary_error_code_e {
+    IPEE_ERROR_CODE__UNROLLED_DICTIONARY__NOT_EXISTS         = -1, // Dictionary does not exist.
+    IPEE_ERROR_CODE__UNROLLED_DICTIONARY__INDEX_OUT_OF_RANGE = -2, // Index is out of valid range.
+    IPEE_ERROR_CODE__UNROLLED_DICTIONARY__ALLOCATION_ERROR   = -3, // Failed to allocate node.
+} ipee_unrolled_dictionary_error_code_t, *p_unrolled_dictionary_error_code;
+
+/*********************************************************************************************
+ * STRUCTS DECLARATIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Unrolled dictionary node.
+ *
+ * @details
+ * Block of up to UNROLLED_DICTIONARY_BLOCK_SIZE consecutive records. Used
+ * slots are packed at the start of the block.
+ */
+typedef struct unrolled_dictionary_node_s {
+    struct unrolled_dictionary_node_s *next;                  // Next node.
+    struct unrolled_dictionary_node_s *prev;                  // Previous node.
+    int count;                                                // Count of used slots.
+    char *keys[UNROLLED_DICTIONARY_BLOCK_SIZE];               // Records keys.
+    void *values[UNROLLED_DICTIONARY_BLOCK_SIZE];             // Records values.
+    void *records_metadata[UNROLLED_DICTIONARY_BLOCK_SIZE];   // Records metadata.
+} unrolled_dictionary_node_t, *p_unrolled_dictionary_node;
+
+/**
+ * @brief Unrolled dictionary collection.
+ *
+ * @details
+ * Ordered collection of records stored in a doubly linked list of blocks.
+ * Link pointers and allocations are paid once per block instead of once
+ * per record, appending fills the tail block in O(1) and iteration walks
+ * records of a block sequentially. Records are not unique.
+ * Inserting into a full block splits it in halves, removal shifts the
+ * rest of the block and merges it with the next one when both fit.
+ * head - first node.
+ * tail - last node.
+ * size - count of records.
+ * nodes - count of nodes.
+ *
+ * @warning
+ * The implementation is mutable, not thread-safe and not reentrant.
+ * Changing the dictionary while iterating is not supported.
+ */
+typedef struct unrolled_dictionary_s {
+    p_unrolled_dictionary_node head; // First node.
+    p_unrolled_dictionary_node tail; // Last node.
+    int size;                        // Count of records.
+    int nodes;                       // Count of nodes.
+    void *metadata;                  // Dictionary metadata.
+} unrolled_dictionary_t, *p_unrolled_dictionary;
+
+/***********************************************************************************************
+ * FUNCTION TYPEDEFS
+ **********************************************************************************************/
+
+/**
+ * @brief Callback function for filtering records of unrolled dictionary.
+ *
+ * @details
+ * Record is a temporary view of a slot, it is valid only during the call.
+ *
+ * @param record Record.
+ * @param index Record index.
+ * @param dict Unrolled dictionary.
+ * @return Result of comparison.
+ */
+typedef int (*unrolled_dictionary_iteration_callback_filter)(
+    const p_record record, int index, const p_unrolled_dictionary dict);
+
+/**
+ * @brief Callback function for filtering records of unrolled dictionary.
+ *
+ * @param record Record.
+ * @param index Record index.
+ * @param dict Unrolled dictionary.
+ * @param args Arguments for callback function.
+ * @return Result of comparison.
+ */
+typedef int (*unrolled_dictionary_iteration_callback_filter_with_args)(
+    const p_record record, int index, const p_unrolled_dictionary dict, void *args);
+
+/**
+ * @brief Callback function for reducing records of unrolled dictionary.
+ *
+ * @param acc Accumulator.
+ * @param record Record.
+ * @param index Record index.
+ * @param dict Unrolled dictionary.
+ */
+typedef void (*unrolled_dictionary_iteration_callback_reduce)(
+    void *acc, const p_record record, int index, const p_unrolled_dictionary dict);
+
+/**
+ * @brief Callback function for reducing records of unrolled dictionary.
+ *
+ * @param acc Accumulator.
+ * @param record Record.
+ * @param index Record index.
+ * @param dict Unrolled dictionary.
+ * @param args Arguments for callback function.
+ */
+typedef void (*unrolled_dictionary_iteration_callback_reduce_with_args)(
+    void *acc, const p_record record, int index, const p_unrolled_dictionary dict, void *args);
+
+/*********************************************************************************************
+ * FUNCTIONS DECLARATIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Create unrolled dictionary.
+ *
+ * @return Unrolled dictionary.
+ */
+extern p_unrolled_dictionary create_unrolled_dictionary(void);
+
+/**
+ * @brief Create unrolled dictionary.
+ *
+ * @param metadata Metadata.
+ * @return Unrolled dictionary.
+ */
+extern p_unrolled_dictionary create_unrolled_dictionary_with_metadata(void *metadata);
+
+/**
+ * @brief Delete unrolled dictionary.
+ *
+ * @param dict Unrolled dictionary.
+ * @return 0 on success, or a negative error code.
+ */
+extern int delete_unrolled_dictionary(p_unrolled_dictionary dict);
+
+/**
+ * @brief Add record to the end of unrolled dictionary.
+ *
+ * @param dict Unrolled dictionary.
+ * @param key Record key.
+ * @param value Record value.
+ * @return 0 on success, or a negative error code.
+ */
+extern int add_record_to_unrolled_dictionary(const p_unrolled_dictionary dict, char *key, void *value);
+
+/**
+ * @brief Add record with metadata to the end of unrolled dictionary.
+ *
+ * @param dict Unrolled dictionary.
+ * @param key Record key.
+ * @param value Record value.
+ * @param metadata Record metadata.
+ * @return 0 on success, or a negative error code.
+ */
+extern int add_record_to_unrolled_dictionary_with_metadata(
+    const p_unrolled_dictionary dict, char *key, void *value, void *metadata);
+
+/**
+ * @brief Add record to the start of unrolled dictionary.
+ *
+ * @param dict Unrolled dictionary.
+ * @param key Record key.
+ * @param value Record value.
+ * @return 0 on success, or a negative error code.
+ */
+extern int emplace_record_to_unrolled_dictionary(const p_unrolled_dictionary dict, char *key, void *value);
+
+/**
+ * @brief Add record to unrolled dictionary by index.
+ *
+ * @param dict Unrolled dictionary.
+ * @param index Record index.
+ * @param key Record key.
+ * @param value Record value.
+ * @return 0 on success, or a negative error code.
+ */
+extern int add_record_to_unrolled_dictionary_by_index(
+    const p_unrolled_dictionary dict, int index, char *key, void *value);
+
+/**
+ * @brief Add record with metadata to unrolled dictionary by index.
+ *
+ * @param dict Unrolled dictionary.
+ * @param index Record index.
+ * @param key Record key.
+ * @param value Record value.
+ * @param metadata Record metadata.
+ * @return 0 on success, or a negative error code.
+ */
+extern int add_record_to_unrolled_dictionary_by_index_with_metadata(
+    const p_unrolled_dictionary dict, int index, char *key, void *value, void *metadata);
+
+/**
+ * @brief Remove first record with specified key.
+ *
+ * @param dict Unrolled dictionary.
+ * @param key Record key.
+ * @return Value of removed record.
+ */
+extern void *remove_record_from_unrolled_dictionary(const p_unrolled_dictionary dict, char *key);
+
+/**
+ * @brief Remove record by index.
+ *
+ * @param dict Unrolled dictionary.
+ * @param index Record index.
+ * @return Value of removed record.
+ */
+extern void *remove_record_from_unrolled_dictionary_by_index(const p_unrolled_dictionary dict, int index);
+
+/**
+ * @brief Update value of first record with specified key.
+ *
+ * @param dict Unrolled dictionary.
+ * @param key Record key.
+ * @param value New value.
+ * @return Old value.
+ */
+extern void *update_record_in_unrolled_dictionary(
+    const p_unrolled_dictionary dict, char *key, void *value);
+
+/**
+ * @brief Update value of record by index.
+ *
+ * @param dict Unrolled dictionary.
+ * @param index Record index.
+ * @param value New value.
+ * @return Old value.
+ */
+extern void *update_record_in_unrolled_dictionary_by_index(
+    const p_unrolled_dictionary dict, int index, void *value);
+
+/**
+ * @brief Check if unrolled dictionary contains specified key.
+ *
+ * @param dict Unrolled dictionary.
+ * @param key Record key.
+ * @return 1 if dictionary contains key, 0 otherwise.
+ */
+extern int contains_key_in_unrolled_dictionary(const p_unrolled_dictionary dict, char *key);
+
+/**
+ * @brief Check if unrolled dictionary contains specified value.
+ *
+ * @param dict Unrolled dictionary.
+ * @param value Record value.
+ * @return 1 if dictionary contains value, 0 otherwise.
+ */
+extern int contains_value_in_unrolled_dictionary(const p_unrolled_dictionary dict, void *value);
+
+/**
+ * @brief Get value of first record with specified key.
+ *
+ * @param dict Unrolled dictionary.
+ * @param key Record key.
+ * @return Record value.
+ */
+extern void *get_value_from_unrolled_dictionary(const p_unrolled_dictionary dict, char *key);
+
+/**
+ * @brief Get value of record by index.
+ *
+ * @param dict Unrolled dictionary.
+ * @param index Record index.
+ * @return Record value.
+ */
+extern void *get_value_from_unrolled_dictionary_by_index(const p_unrolled_dictionary dict, int index);
+
+/**
+ * @brief Get key of record by index.
+ *
+ * @param dict Unrolled dictionary.
+ * @param index Record index.
+ * @return Record key.
+ */
+extern char *get_key_from_unrolled_dictionary_by_index(const p_unrolled_dictionary dict, int index);
+
+/**
+ * @brief Get index of first record with specified key.
+ *
+ * @param dict Unrolled dictionary.
+ * @param key Record key.
+ * @return Record index, -1 if there is no record, or a negative error code.
+ */
+extern int get_index_from_unrolled_dictionary_by_key(const p_unrolled_dictionary dict, char *key);
+
+/**
+ * @brief Iterate over unrolled dictionary.
+ *
+ * @param dict Unrolled dictionary.
+ * @param callback Callback function.
+ * @return 0 on success, or a negative error code.
+ */
+extern int iterate_over_unrolled_dictionary(
+    const p_unrolled_dictionary dict, dictionary_iteration_callback callback);
+
+/**
+ * @brief Iterate over unrolled dictionary with arguments.
+ *
+ * @param dict Unrolled dictionary.
+ * @param callback Callback function.
+ * @param args Arguments for callback function.
+ * @return 0 on success, or a negative error code.
+ */
+extern int iterate_over_unrolled_dictionary_with_args(
+    const p_unrolled_dictionary dict, dictionary_iteration_callback_with_args callback, void *args);
+
+/**
+ * @brief Iterate over keys of unrolled dictionary.
+ *
+ * @param dict Unrolled dictionary.
+ * @param callback Callback function.
+ * @return 0 on success, or a negative error code.
+ */
+extern int iterate_over_unrolled_dictionary_keys(
+    const p_unrolled_dictionary dict, dictionary_iteration_keys_callback callback);
+
+/**
+ * @brief Iterate over keys of unrolled dictionary with arguments.
+ *
+ * @param dict Unrolled dictionary.
+ * @param callback Callback function.
+ * @param args Arguments for callback function.
+ * @return 0 on success, or a negative error code.
+ */
+extern int iterate_over_unrolled_dictionary_keys_with_args(
+    const p_unrolled_dictionary dict, dictionary_iteration_keys_callback_with_args callback, void *args);
+
+/**
+ * @brief Iterate over values of unrolled dictionary.
+ *
+ * @param dict Unrolled dictionary.
+ * @param callback Callback function.
+ * @return 0 on success, or a negative error code.
+ */
+extern int iterate_over_unrolled_dictionary_values(
+    const p_unrolled_dictionary dict, dictionary_iteration_values_callback callback);
+
+/**
+ * @brief Iterate over values of unrolled dictionary with arguments.
+ *
+ * @param dict Unrolled dictionary.
+ * @param callback Callback function.
+ * @param args Arguments for callback function.
+ * @return 0 on success, or a negative error code.
+ */
+extern int iterate_over_unrolled_dictionary_values_with_args(
+    const p_unrolled_dictionary dict, dictionary_iteration_values_callback_with_args callback, void *args);
+
+/**
+ * @brief Filter unrolled dictionary.
+ *
+ * @param dict Unrolled dictionary.
+ * @param callback Callback function.
+ * @return Filtered unrolled dictionary.
+ */
+extern p_unrolled_dictionary filter_unrolled_dictionary(
+    const p_unrolled_dictionary dict, unrolled_dictionary_iteration_callback_filter callback);
+
+/**
+ * @brief Filter unrolled dictionary with arguments.
+ *
+ * @param dict Unrolled dictionary.
+ * @param callback Callback function.
+ * @param args Arguments for callback function.
+ * @return Filtered unrolled dictionary.
+ */
+extern p_unrolled_dictionary filter_unrolled_dictionary_with_args(
+    const p_unrolled_dictionary dict,
+    unrolled_dictionary_iteration_callback_filter_with_args callback, void *args);
+
+/**
+ * @brief Reduce unrolled dictionary.
+ *
+ * @param dict Unrolled dictionary.
+ * @param callback Callback function.
+ * @param acc Accumulator.
+ * @return Accumulator.
+ */
+extern void *reduce_unrolled_dictionary(
+    const p_unrolled_dictionary dict, unrolled_dictionary_iteration_callback_reduce callback, void *acc);
+
+/**
+ * @brief Reduce unrolled dictionary with arguments.
+ *
+ * @param dict Unrolled dictionary.
+ * @param callback Callback function.
+ * @param acc Accumulator.
+ * @param args Arguments for callback function.
+ * @return Accumulator.
+ */
+extern void *reduce_unrolled_dictionary_with_args(
+    const p_unrolled_dictionary dict,
+    unrolled_dictionary_iteration_callback_reduce_with_args callback, void *acc, void *args);
+
+#endif // IPEE_UNROLLED_DICTIONARY_H
@@ -0,0 +1,512 @@
+#include <array_dictionary.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+/*********************************************************************************************
+ * MACROS DECLARATIONS
+ ********************************************************************************************/
+
+#define ARRAY_DICTIONARY_DEFAULT_CAPACITY 16
+#define ARRAY_DICTIONARY_RESIZE_FACTOR 2
+
+/**
+ * @brief Make temporary record view of a slot.
+ */
+#define array_dictionary_record(dict, slot) \
+    ((record_t){.key = (dict)->keys[slot], .value = (dict)->values[slot], \
+                .metadata = (dict)->records_metadata[slot]})
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ **********************************************************************************************/
+
+/**
+ * @brief Reserve storage for records.
+ *
+ * @param dict Array dictionary.
+ * @param capacity Required count of slots.
+ * @return 0 on success, or a negative error code.
+ */
+static int reserve_array_dictionary(const p_array_dictionary dict, int capacity);
+
+/**
+ * @brief Find slot of first matching key.
+ *
+ * @param dict Array dictionary.
+ * @param key Record key.
+ * @return Slot index, or -1.
+ */
+static int find_key_slot(const p_array_dictionary dict, const char *key);
+
+/**
+ * @brief Find slot of record by index.
+ *
+ * @details
+ * Slot equals index if there are no removed slots, otherwise live slots are
+ * counted. The dictionary is not changed, so reads can run concurrently.
+ *
+ * @param dict Array dictionary.
+ * @param index Record index.
+ * @return Slot index, or -1.
+ */
+static int find_index_slot(const p_array_dictionary dict, int index);
+
+/**
+ * @brief Mark slot as removed.
+ *
+ * @param dict Array dictionary.
+ * @param slot Slot index.
+ * @return Value of removed record.
+ */
+static void *remove_slot(const p_array_dictionary dict, int slot);
+
+/*********************************************************************************************
+ * FUNCTIONS DEFINITIONS
+ ********************************************************************************************/
+
+p_array_dictionary create_array_dictionary(void) {
+    return create_array_dictionary_with_metadata(NULL);
+}
+
+p_array_dictionary create_array_dictionary_with_metadata(void *metadata) {
+    p_array_dictionary dict = (p_array_dictionary)malloc(sizeof(array_dictionary_t));
+    if (!dict)
+        return NULL;
+
+    dict->keys = NULL;
+    dict->values = NULL;
+    dict->records_metadata = NULL;
+    dict->tombstones = NULL;
+    dict->length = 0;
+    dict->capacity = 0;
+    dict->size = 0;
+    dict->metadata = metadata;
+
+    if (reserve_array_dictionary(dict, ARRAY_DICTIONARY_DEFAULT_CAPACITY)) {
+        delete_array_dictionary(dict);
+        return NULL;
+    }
+    return dict;
+}
+
+int delete_array_dictionary(p_array_dictionary dict) {
+    if (!dict)
+        return IPEE_ERROR_CODE__ARRAY_DICTIONARY__NOT_EXISTS;
+
+    free(dict->keys);
+    free(dict->values);
+    free(dict->records_metadata);
+    free(dict->tombstones);
+    free(dict);
+    return 0;
+}
+
+int compact_array_dictionary(const p_array_dictionary dict) {
+    if (!dict)
+        return IPEE_ERROR_CODE__ARRAY_DICTIONARY__NOT_EXISTS;
+    if (dict->size == dict->length)
+        return 0;
+
+    int target = 0;
+    for (int slot = 0; slot < dict->length; slot++) {
+        if (dict->tombstones[slot])
+            continue;
+
+        dict->keys[target] = dict->keys[slot];
+        dict->values[target] = dict->values[slot];
+        dict->records_metadata[target] = dict->records_metadata[slot];
+        target++;
+    }
+    memset(dict->tombstones, 0, dict->length);
+    dict->length = target;
+    return 0;
+}
+
+int add_record_to_array_dictionary(const p_array_dictionary dict, char *key, void *value) {
+    return add_record_to_array_dictionary_with_metadata(dict, key, value, NULL);
+}
+
+int add_record_to_array_dictionary_with_metadata(
+    const p_array_dictionary dict, char *key, void *value, void *metadata) {
+    if (!dict)
+        return IPEE_ERROR_CODE__ARRAY_DICTIONARY__NOT_EXISTS;
+
+    if (dict->length == dict->capacity) {
+        // Reuse removed slots before growing when most of the storage is dead.
+        if (dict->length - dict->size > dict->length / 2)
+            compact_array_dictionary(dict);
+        else if (reserve_array_dictionary(dict, dict->capacity * ARRAY_DICTIONARY_RESIZE_FACTOR))
+            return IPEE_ERROR_CODE__ARRAY_DICTIONARY__ALLOCATION_ERROR;
+    }
+
+    int slot = dict->length++;
+    dict->keys[slot] = key;
+    dict->values[slot] = value;
+    dict->records_metadata[slot] = metadata;
+    dict->tombstones[slot] = 0;
+    dict->size++;
+    return 0;
+}
+
+int emplace_record_to_array_dictionary(const p_array_dictionary dict, char *key, void *value) {
+    return add_record_to_array_dictionary_by_index_with_metadata(dict, 0, key, value, NULL);
+}
+
+int add_record_to_array_dictionary_by_index(
+    const p_array_dictionary dict, int index, char *key, void *value) {
+    return add_record_to_array_dictionary_by_index_with_metadata(dict, index, key, value, NULL);
+}
+
+int add_record_to_array_dictionary_by_index_with_metadata(
+    const p_array_dictionary dict, int index, char *key, void *value, void *metadata) {
+    if (!dict)
+        return IPEE_ERROR_CODE__ARRAY_DICTIONARY__NOT_EXISTS;
+    if (index < 0 || index > dict->size)
+        return IPEE_ERROR_CODE__ARRAY_DICTIONARY__INDEX_OUT_OF_RANGE;
+
+    compact_array_dictionary(dict);
+    if (dict->length == dict->capacity &&
+        reserve_array_dictionary(dict, dict->capacity * ARRAY_DICTIONARY_RESIZE_FACTOR))
+        return IPEE_ERROR_CODE__ARRAY_DICTIONARY__ALLOCATION_ERROR;
+
+    int count = dict->length - index;
+    memmove(&dict->keys[index + 1], &dict->keys[index], count * sizeof(char *));
+    memmove(&dict->values[index + 1], &dict->values[index], count * sizeof(void *));
+    memmove(&dict->records_metadata[index + 1], &dict->records_metadata[index], count * sizeof(void *));
+
+    dict->keys[index] = key;
+    dict->values[index] = value;
+    dict->records_metadata[index] = metadata;
+    dict->tombstones[dict->length] = 0;
+    dict->length++;
+    dict->size++;
+    return 0;
+}
+
+void *remove_record_from_array_dictionary(const p_array_dictionary dict, char *key) {
+    int slot = find_key_slot(dict, key);
+    return slot < 0 ? NULL : remove_slot(dict, slot);
+}
+
+void *remove_record_from_array_dictionary_by_index(const p_array_dictionary dict, int index) {
+    // Positional writes compact, so following positional reads find slots at once.
+    compact_array_dictionary(dict);
+    int slot = find_index_slot(dict, index);
+    return slot < 0 ? NULL : remove_slot(dict, slot);
+}
+
+void *update_record_in_array_dictionary(const p_array_dictionary dict, char *key, void *value) {
+    int slot = find_key_slot(dict, key);
+    if (slot < 0)
+        return NULL;
+
+    void *old_value = dict->values[slot];
+    dict->values[slot] = value;
+    return old_value;
+}
+
+void *update_record_in_array_dictionary_by_index(
+    const p_array_dictionary dict, int index, void *value) {
+    compact_array_dictionary(dict);
+    int slot = find_index_slot(dict, index);
+    if (slot < 0)
+        return NULL;
+
+    void *old_value = dict->values[slot];
+    dict->values[slot] = value;
+    return old_value;
+}
+
+int contains_key_in_array_dictionary(const p_array_dictionary dict, char *key) {
+    return find_key_slot(dict, key) >= 0;
+}
+
+int contains_value_in_array_dictionary(const p_array_dictionary dict, void *value) {
+    if (!dict)
+        return 0;
+
+    for (int slot = 0; slot < dict->length; slot++) {
+        if (dict->values[slot] == value && !dict->tombstones[slot])
+            return 1;
+    }
+    return 0;
+}
+
+void *get_value_from_array_dictionary(const p_array_dictionary dict, char *key) {
+    int slot = find_key_slot(dict, key);
+    return slot < 0 ? NULL : dict->values[slot];
+}
+
+void *get_value_from_array_dictionary_by_index(const p_array_dictionary dict, int index) {
+    int slot = find_index_slot(dict, index);
+    return slot < 0 ? NULL : dict->values[slot];
+}
+
+char *get_key_from_array_dictionary_by_index(const p_array_dictionary dict, int index) {
+    int slot = find_index_slot(dict, index);
+    return slot < 0 ? NULL : dict->keys[slot];
+}
+
+int get_index_from_array_dictionary_by_key(const p_array_dictionary dict, char *key) {
+    if (!dict)
+        return IPEE_ERROR_CODE__ARRAY_DICTIONARY__NOT_EXISTS;
+
+    int index = 0;
+    for (int slot = 0; slot < dict->length; slot++) {
+        if (dict->tombstones[slot])
+            continue;
+        if (strcmp(dict->keys[slot], key) == 0)
+            return index;
+        index++;
+    }
+    return -1;
+}
+
+int iterate_over_array_dictionary(
+    const p_array_dictionary dict, dictionary_iteration_callback callback) {
+    if (!dict)
+        return IPEE_ERROR_CODE__ARRAY_DICTIONARY__NOT_EXISTS;
+
+    for (int slot = 0; slot < dict->length; slot++) {
+        if (!dict->tombstones[slot])
+            callback(dict->keys[slot], dict->values[slot]);
+    }
+    return 0;
+}
+
+int iterate_over_array_dictionary_with_args(
+    const p_array_dictionary dict, dictionary_iteration_callback_with_args callback, void *args) {
+    if (!dict)
+        return IPEE_ERROR_CODE__ARRAY_DICTIONARY__NOT_EXISTS;
+
+    for (int slot = 0; slot < dict->length; slot++) {
+        if (!dict->tombstones[slot])
+            callback(dict->keys[slot], dict->values[slot], args);
+    }
+    return 0;
+}
+
+int iterate_over_array_dictionary_keys(
+    const p_array_dictionary dict, dictionary_iteration_keys_callback callback) {
+    if (!dict)
+        return IPEE_ERROR_CODE__ARRAY_DICTIONARY__NOT_EXISTS;
+
+    for (int slot = 0; slot < dict->length; slot++) {
+        if (!dict->tombstones[slot])
+            callback(dict->keys[slot]);
+    }
+    return 0;
+}
+
+int iterate_over_array_dictionary_keys_with_args(
+    const p_array_dictionary dict, dictionary_iteration_keys_callback_with_args callback, void *args) {
+    if (!dict)
+        return IPEE_ERROR_CODE__ARRAY_DICTIONARY__NOT_EXISTS;
+
+    for (int slot = 0; slot < dict->length; slot++) {
+        if (!dict->tombstones[slot])
+            callback(dict->keys[slot], args);
+    }
+    return 0;
+}
+
+int iterate_over_array_dictionary_values(
+    const p_array_dictionary dict, dictionary_iteration_values_callback callback) {
+    if (!dict)
+        return IPEE_ERROR_CODE__ARRAY_DICTIONARY__NOT_EXISTS;
+
+    for (int slot = 0; slot < dict->length; slot++) {
+        if (!dict->tombstones[slot])
+            callback(dict->values[slot]);
+    }
+    return 0;
+}
+
+int iterate_over_array_dictionary_values_with_args(
+    const p_array_dictionary dict, dictionary_iteration_values_callback_with_args callback, void *args) {
+    if (!dict)
+        return IPEE_ERROR_CODE__ARRAY_DICTIONARY__NOT_EXISTS;
+
+    for (int slot = 0; slot < dict->length; slot++) {
+        if (!dict->tombstones[slot])
+            callback(dict->values[slot], args);
+    }
+    return 0;
+}
+
+p_array_dictionary map_array_dictionary(
+    const p_array_dictionary dict, array_dictionary_iteration_callback_map callback) {
+    if (!dict)
+        return NULL;
+
+    p_array_dictionary new_dict = create_array_dictionary();
+    int index = 0;
+    for (int slot = 0; slot < dict->length; slot++) {
+        if (dict->tombstones[slot])
+            continue;
+
+        record_t record = array_dictionary_record(dict, slot);
+        p_record new_record = callback(&record, index++, dict);
+        if (new_record)
+            add_record_to_array_dictionary(new_dict, new_record->key, new_record->value);
+    }
+    return new_dict;
+}
+
+p_array_dictionary map_array_dictionary_with_args(
+    const p_array_dictionary dict,
+    array_dictionary_iteration_callback_map_with_args callback, void *args) {
+    if (!dict)
+        return NULL;
+
+    p_array_dictionary new_dict = create_array_dictionary();
+    int index = 0;
+    for (int slot = 0; slot < dict->length; slot++) {
+        if (dict->tombstones[slot])
+            continue;
+
+        record_t record = array_dictionary_record(dict, slot);
+        p_record new_record = callback(&record, index++, dict, args);
+        if (new_record)
+            add_record_to_array_dictionary(new_dict, new_record->key, new_record->value);
+    }
+    return new_dict;
+}
+
+p_array_dictionary filter_array_dictionary(
+    const p_array_dictionary dict, array_dictionary_iteration_callback_filter callback) {
+    if (!dict)
+        return NULL;
+
+    p_array_dictionary new_dict = create_array_dictionary();
+    int index = 0;
+    for (int slot = 0; slot < dict->length; slot++) {
+        if (dict->tombstones[slot])
+            continue;
+
+        record_t record = array_dictionary_record(dict, slot);
+        if (callback(&record, index++, dict))
+            add_record_to_array_dictionary(new_dict, dict->keys[slot], dict->values[slot]);
+    }
+    return new_dict;
+}
+
+p_array_dictionary filter_array_dictionary_with_args(
+    const p_array_dictionary dict,
+    array_dictionary_iteration_callback_filter_with_args callback, void *args) {
+    if (!dict)
+        return NULL;
+
+    p_array_dictionary new_dict = create_array_dictionary();
+    int index = 0;
+    for (int slot = 0; slot < dict->length; slot++) {
+        if (dict->tombstones[slot])
+            continue;
+
+        record_t record = array_dictionary_record(dict, slot);
+        if (callback(&record, index++, dict, args))
+            add_record_to_array_dictionary(new_dict, dict->keys[slot], dict->values[slot]);
+    }
+    return new_dict;
+}
+
+void *reduce_array_dictionary(
+    const p_array_dictionary dict, array_dictionary_iteration_callback_reduce callback, void *acc) {
+    if (!dict)
+        return NULL;
+
+    int index = 0;
+    for (int slot = 0; slot < dict->length; slot++) {
+        if (dict->tombstones[slot])
+            continue;
+
+        record_t record = array_dictionary_record(dict, slot);
+        callback(acc, &record, index++, dict);
+    }
+    return acc;
+}
+
+void *reduce_array_dictionary_with_args(
+    const p_array_dictionary dict,
+    array_dictionary_iteration_callback_reduce_with_args callback, void *acc, void *args) {
+    if (!dict)
+        return NULL;
+
+    int index = 0;
+    for (int slot = 0; slot < dict->length; slot++) {
+        if (dict->tombstones[slot])
+            continue;
+
+        record_t record = array_dictionary_record(dict, slot);
+        callback(acc, &record, index++, dict, args);
+    }
+    return acc;
+}
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DEFINITIONS
+ **********************************************************************************************/
+
+static int reserve_array_dictionary(const p_array_dictionary dict, int capacity) {
+    if (capacity <= dict->capacity)
+        return 0;
+
+    char **keys = realloc(dict->keys, capacity * sizeof(char *));
+    if (!keys)
+        return IPEE_ERROR_CODE__ARRAY_DICTIONARY__ALLOCATION_ERROR;
+    dict->keys = keys;
+
+    void **values = realloc(dict->values, capacity * sizeof(void *));
+    if (!values)
+        return IPEE_ERROR_CODE__ARRAY_DICTIONARY__ALLOCATION_ERROR;
+    dict->values = values;
+
+    void **records_metadata = realloc(dict->records_metadata, capacity * sizeof(void *));
+    if (!records_metadata)
+        return IPEE_ERROR_CODE__ARRAY_DICTIONARY__ALLOCATION_ERROR;
+    dict->records_metadata = records_metadata;
+
+    uint8_t *tombstones = realloc(dict->tombstones, capacity * sizeof(uint8_t));
+    if (!tombstones)
+        return IPEE_ERROR_CODE__ARRAY_DICTIONARY__ALLOCATION_ERROR;
+    dict->tombstones = tombstones;
+
+    dict->capacity = capacity;
+    return 0;
+}
+
+static int find_key_slot(const p_array_dictionary dict, const char *key) {
+    if (!dict)
+        return -1;
+
+    for (int slot = 0; slot < dict->length; slot++) {
+        if (!dict->tombstones[slot] && strcmp(dict->keys[slot], key) == 0)
+            return slot;
+    }
+    return -1;
+}
+
+static int find_index_slot(const p_array_dictionary dict, int index) {
+    if (!dict || index < 0 || index >= dict->size)
+        return -1;
+    if (dict->size == dict->length)
+        return index;
+
+    for (int slot = 0; slot < dict->length; slot++) {
+        if (!dict->tombstones[slot] && index-- == 0)
+            return slot;
+    }
+    return -1;
+}
+
+static void *remove_slot(const p_array_dictionary dict, int slot) {
+    void *removed_value = dict->values[slot];
+    dict->tombstones[slot] = 1;
+    dict->size--;
+
+    // Trailing removed slots are simply cut off.
+    while (dict->length && dict->tombstones[dict->length - 1])
+        dict->tombstones[--dict->length] = 0;
+    return removed_value;
+}
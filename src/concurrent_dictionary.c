@@ -0,0 +1,401 @@
+#include <concurrent_dictionary.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <hash.h>
+
+/*********************************************************************************************
+ * MACROS DECLARATIONS
+ ********************************************************************************************/
+
+#define CONCURRENT_DICTIONARY_READER_SLOTS 64
+#define CONCURRENT_DICTIONARY_RETIRE_LIMIT 64
+#define CONCURRENT_DICTIONARY_CACHE_LINE 64
+
+/*********************************************************************************************
+ * STRUCTS DECLARATIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Concurrent dictionary record.
+ *
+ * @details
+ * Next pointer of a removed record is left intact, so readers standing on
+ * it still reach the rest of the list.
+ */
+typedef struct concurrent_record_s {
+    _Atomic(struct concurrent_record_s *) next; // Next record.
+    struct concurrent_record_s *retired;        // Next retired record.
+    char *key;                                  // Record key.
+    _Atomic(void *) value;                      // Record value.
+    uint32_t hash;                              // Key hash.
+    uint32_t length;                            // Key length.
+} concurrent_record_t, *p_concurrent_record;
+
+/**
+ * @brief Readers counters of a slot.
+ *
+ * @details
+ * Threads are spread over slots, so readers on different cores do not
+ * share a cache line. Counter is chosen by parity of the epoch a reader
+ * entered in.
+ */
+typedef struct concurrent_reader_slot_s {
+    _Alignas(CONCURRENT_DICTIONARY_CACHE_LINE) atomic_long readers[2]; // Readers per epoch parity.
+} concurrent_reader_slot_t;
+
+struct concurrent_dictionary_s {
+    concurrent_reader_slot_t slots[CONCURRENT_DICTIONARY_READER_SLOTS]; // Readers counters.
+    _Atomic(p_concurrent_record) head;                                  // Head record.
+    atomic_int size;                                                    // Count of records.
+    atomic_uint epoch;                                                  // Reclamation epoch.
+    pthread_mutex_t writer;                                             // Writers mutex.
+    pthread_mutex_t reclaimer;                                          // Grace periods mutex.
+    p_concurrent_record tail;                                           // Tail record.
+    p_concurrent_record retired;                                        // Retired records.
+    int retired_count;                                                  // Count of retired records.
+};
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ **********************************************************************************************/
+
+/**
+ * @brief Get readers slot of current thread.
+ *
+ * @return Slot index.
+ */
+static int get_reader_slot(void);
+
+/**
+ * @brief Find first record with specified key.
+ *
+ * @details
+ * Has to be called inside a read section or by a writer.
+ *
+ * @param dict Dictionary.
+ * @param key Record key.
+ * @param prev Previous record output, may be NULL.
+ * @return Record, NULL if there is no record.
+ */
+static p_concurrent_record find_concurrent_record(
+    const p_concurrent_dictionary dict, const char *key, p_concurrent_record *prev);
+
+/**
+ * @brief Take retired records for reclamation.
+ *
+ * @details
+ * Has to be called by a writer. Records are kept retired while current
+ * thread is inside a read section.
+ *
+ * @param dict Dictionary.
+ * @return Retired records, NULL if there is nothing to reclaim.
+ */
+static p_concurrent_record detach_retired_records(const p_concurrent_dictionary dict);
+
+/**
+ * @brief Free records taken by detach_retired_records.
+ *
+ * @details
+ * Flip epoch and wait until readers of the previous one leave. Has to be
+ * called without the writers mutex, readers may wait for it in callbacks.
+ *
+ * @param dict Dictionary.
+ * @param record Detached records.
+ */
+static void reclaim_records(const p_concurrent_dictionary dict, p_concurrent_record record);
+
+/*********************************************************************************************
+ * STATIC VARIABLES
+ ********************************************************************************************/
+
+/**
+ * @brief Count of threads assigned to readers slots.
+ */
+static atomic_uint reader_slots_assigned = 0;
+
+/**
+ * @brief Readers slot of current thread, -1 if not assigned yet.
+ */
+static _Thread_local int reader_slot = -1;
+
+/**
+ * @brief Count of read sections current thread is inside of.
+ *
+ * @details
+ * A writer inside a read section must not wait for readers, it would wait
+ * for itself. Counted over all dictionaries: a reader of one dictionary
+ * waiting for readers of another could wait for a thread that waits for it.
+ */
+static _Thread_local int reader_depth = 0;
+
+/*********************************************************************************************
+ * FUNCTIONS DEFINITIONS
+ ********************************************************************************************/
+
+p_concurrent_dictionary create_concurrent_dictionary(void) {
+    p_concurrent_dictionary dict = aligned_alloc(_Alignof(concurrent_dictionary_t), sizeof(concurrent_dictionary_t));
+    if (!dict)
+        return NULL;
+
+    for (int i = 0; i < CONCURRENT_DICTIONARY_READER_SLOTS; i++) {
+        atomic_init(&dict->slots[i].readers[0], 0);
+        atomic_init(&dict->slots[i].readers[1], 0);
+    }
+    atomic_init(&dict->head, NULL);
+    atomic_init(&dict->size, 0);
+    atomic_init(&dict->epoch, 0);
+    pthread_mutex_init(&dict->writer, NULL);
+    pthread_mutex_init(&dict->reclaimer, NULL);
+    dict->tail = NULL;
+    dict->retired = NULL;
+    dict->retired_count = 0;
+
+    return dict;
+}
+
+int delete_concurrent_dictionary(p_concurrent_dictionary dict) {
+    if (!dict)
+        return IPEE_ERROR_CODE__CONCURRENT_DICTIONARY__NOT_EXISTS;
+
+    p_concurrent_record record = atomic_load_explicit(&dict->head, memory_order_relaxed);
+    while (record) {
+        p_concurrent_record next = atomic_load_explicit(&record->next, memory_order_relaxed);
+        free(record);
+        record = next;
+    }
+
+    record = dict->retired;
+    while (record) {
+        p_concurrent_record next = record->retired;
+        free(record);
+        record = next;
+    }
+
+    pthread_mutex_destroy(&dict->writer);
+    pthread_mutex_destroy(&dict->reclaimer);
+    free(dict);
+    return 0;
+}
+
+int begin_concurrent_dictionary_read(const p_concurrent_dictionary dict) {
+    if (!dict)
+        return IPEE_ERROR_CODE__CONCURRENT_DICTIONARY__NOT_EXISTS;
+
+    concurrent_reader_slot_t *slot = &dict->slots[get_reader_slot()];
+    for (;;) {
+        const unsigned parity = atomic_load(&dict->epoch) & 1;
+        atomic_fetch_add(&slot->readers[parity], 1);
+        // Epoch flipped before the reader was counted, the writer may not wait for it.
+        if ((atomic_load(&dict->epoch) & 1) == parity) {
+            reader_depth++;
+            return (int)parity;
+        }
+        atomic_fetch_sub(&slot->readers[parity], 1);
+    }
+}
+
+void end_concurrent_dictionary_read(const p_concurrent_dictionary dict, int token) {
+    if (!dict || token < 0)
+        return;
+
+    atomic_fetch_sub(&dict->slots[get_reader_slot()].readers[token & 1], 1);
+    reader_depth--;
+}
+
+int add_record_to_concurrent_dictionary(const p_concurrent_dictionary dict, char *key, void *value) {
+    if (!dict)
+        return IPEE_ERROR_CODE__CONCURRENT_DICTIONARY__NOT_EXISTS;
+
+    p_concurrent_record record = malloc(sizeof(concurrent_record_t));
+    if (!record)
+        return IPEE_ERROR_CODE__CONCURRENT_DICTIONARY__RECORD_CREATION_ERROR;
+
+    const size_t length = key ? strlen(key) : 0;
+    atomic_init(&record->next, NULL);
+    atomic_init(&record->value, value);
+    record->retired = NULL;
+    record->key = key;
+    record->length = (uint32_t)length;
+    record->hash = key ? hash_data(key, length) : 0;
+
+    pthread_mutex_lock(&dict->writer);
+    // Record is fully initialized before it is published to readers.
+    if (dict->tail)
+        atomic_store_explicit(&dict->tail->next, record, memory_order_release);
+    else
+        atomic_store_explicit(&dict->head, record, memory_order_release);
+    dict->tail = record;
+    atomic_fetch_add(&dict->size, 1);
+    pthread_mutex_unlock(&dict->writer);
+
+    return 0;
+}
+
+void *remove_record_from_concurrent_dictionary(const p_concurrent_dictionary dict, char *key) {
+    if (!dict)
+        return NULL;
+
+    pthread_mutex_lock(&dict->writer);
+    p_concurrent_record prev = NULL;
+    p_concurrent_record record = find_concurrent_record(dict, key, &prev);
+    if (!record) {
+        pthread_mutex_unlock(&dict->writer);
+        return NULL;
+    }
+
+    p_concurrent_record next = atomic_load_explicit(&record->next, memory_order_relaxed);
+    if (prev)
+        atomic_store_explicit(&prev->next, next, memory_order_release);
+    else
+        atomic_store_explicit(&dict->head, next, memory_order_release);
+    if (dict->tail == record)
+        dict->tail = prev;
+    atomic_fetch_sub(&dict->size, 1);
+
+    void *value = atomic_load_explicit(&record->value, memory_order_relaxed);
+    record->retired = dict->retired;
+    dict->retired = record;
+    p_concurrent_record retired = NULL;
+    if (++dict->retired_count >= CONCURRENT_DICTIONARY_RETIRE_LIMIT)
+        retired = detach_retired_records(dict);
+    pthread_mutex_unlock(&dict->writer);
+    reclaim_records(dict, retired);
+
+    return value;
+}
+
+void *update_record_in_concurrent_dictionary(const p_concurrent_dictionary dict, char *key, void *value) {
+    if (!dict)
+        return NULL;
+
+    pthread_mutex_lock(&dict->writer);
+    p_concurrent_record record = find_concurrent_record(dict, key, NULL);
+    void *previous = record ? atomic_exchange(&record->value, value) : NULL;
+    pthread_mutex_unlock(&dict->writer);
+
+    return previous;
+}
+
+void *get_value_from_concurrent_dictionary(const p_concurrent_dictionary dict, char *key) {
+    if (!dict)
+        return NULL;
+
+    const int token = begin_concurrent_dictionary_read(dict);
+    p_concurrent_record record = find_concurrent_record(dict, key, NULL);
+    void *value = record ? atomic_load_explicit(&record->value, memory_order_acquire) : NULL;
+    end_concurrent_dictionary_read(dict, token);
+
+    return value;
+}
+
+int contains_key_in_concurrent_dictionary(const p_concurrent_dictionary dict, char *key) {
+    if (!dict)
+        return 0;
+
+    const int token = begin_concurrent_dictionary_read(dict);
+    const int result = find_concurrent_record(dict, key, NULL) != NULL;
+    end_concurrent_dictionary_read(dict, token);
+
+    return result;
+}
+
+int get_concurrent_dictionary_size(const p_concurrent_dictionary dict) {
+    if (!dict)
+        return IPEE_ERROR_CODE__CONCURRENT_DICTIONARY__NOT_EXISTS;
+
+    return atomic_load(&dict->size);
+}
+
+int iterate_over_concurrent_dictionary_with_args(
+    const p_concurrent_dictionary dict, dictionary_iteration_callback_with_args callback, void *args) {
+    if (!dict)
+        return IPEE_ERROR_CODE__CONCURRENT_DICTIONARY__NOT_EXISTS;
+
+    const int token = begin_concurrent_dictionary_read(dict);
+    p_concurrent_record record = atomic_load_explicit(&dict->head, memory_order_acquire);
+    while (record) {
+        callback(record->key, atomic_load_explicit(&record->value, memory_order_acquire), args);
+        record = atomic_load_explicit(&record->next, memory_order_acquire);
+    }
+    end_concurrent_dictionary_read(dict, token);
+
+    return 0;
+}
+
+int synchronize_concurrent_dictionary(const p_concurrent_dictionary dict) {
+    if (!dict)
+        return IPEE_ERROR_CODE__CONCURRENT_DICTIONARY__NOT_EXISTS;
+
+    pthread_mutex_lock(&dict->writer);
+    p_concurrent_record retired = detach_retired_records(dict);
+    pthread_mutex_unlock(&dict->writer);
+    reclaim_records(dict, retired);
+
+    return 0;
+}
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DEFINITIONS
+ **********************************************************************************************/
+
+static int get_reader_slot(void) {
+    if (reader_slot < 0)
+        reader_slot = atomic_fetch_add(&reader_slots_assigned, 1) % CONCURRENT_DICTIONARY_READER_SLOTS;
+    return reader_slot;
+}
+
+static p_concurrent_record find_concurrent_record(
+    const p_concurrent_dictionary dict, const char *key, p_concurrent_record *prev) {
+    const uint32_t length = key ? (uint32_t)strlen(key) : 0;
+    const uint32_t hash = key ? hash_data(key, length) : 0;
+
+    p_concurrent_record previous = NULL;
+    p_concurrent_record record = atomic_load_explicit(&dict->head, memory_order_acquire);
+    while (record) {
+        if (record->hash == hash && record->length == length &&
+            (record->key == key || (key && record->key && !memcmp(record->key, key, length)))) {
+            if (prev)
+                *prev = previous;
+            return record;
+        }
+        previous = record;
+        record = atomic_load_explicit(&record->next, memory_order_acquire);
+    }
+
+    return NULL;
+}
+
+static p_concurrent_record detach_retired_records(const p_concurrent_dictionary dict) {
+    if (reader_depth)
+        return NULL;
+
+    p_concurrent_record record = dict->retired;
+    dict->retired = NULL;
+    dict->retired_count = 0;
+    return record;
+}
+
+static void reclaim_records(const p_concurrent_dictionary dict, p_concurrent_record record) {
+    if (!record)
+        return;
+
+    // Grace periods do not overlap, so readers of the older parity are gone before it is reused.
+    pthread_mutex_lock(&dict->reclaimer);
+    // Readers entered after the flip cannot reach records unlinked before it.
+    const unsigned parity = atomic_fetch_add(&dict->epoch, 1) & 1;
+    for (int i = 0; i < CONCURRENT_DICTIONARY_READER_SLOTS; i++)
+        while (atomic_load(&dict->slots[i].readers[parity]))
+            sched_yield();
+    pthread_mutex_unlock(&dict->reclaimer);
+
+    while (record) {
+        p_concurrent_record next = record->retired;
+        free(record);
+        record = next;
+    }
+}
@@ -102,7 +102,7 @@ p_container get_container(const char *name) {
 
 p_container init_container(const char *name) {
     if (!containers)
-        containers = create_dictionary();
+        containers = create_indexed_dictionary();
     else if (contains_key_in_dictionary(containers, name))
         return get_container(name);
 
@@ -112,12 +112,12 @@ p_container init_container(const char *name) {
         return NULL;
 
     app_container->name = name;
-    app_container->services = create_dictionary();
-    app_container->elements_types = create_dictionary();
-    app_container->elements_initial_callback = create_dictionary();
-    app_container->elements_release_callback = create_dictionary();
-    app_container->elements_args = create_dictionary();
-    app_container->elements_refs = create_dictionary();
+    app_container->services = create_int_dictionary();
+    app_container->elements_types = create_indexed_dictionary();
+    app_container->elements_initial_callback = create_indexed_dictionary();
+    app_container->elements_release_callback = create_indexed_dictionary();
+    app_container->elements_args = create_indexed_dictionary();
+    app_container->elements_refs = create_indexed_dictionary();
 
     pthread_mutexattr_t mutex_attr;
     pthread_mutexattr_init(&mutex_attr);
@@ -141,9 +141,9 @@ int release_container(p_container container) {
 
     p_application_container app_container = (p_application_container)container;
     pthread_mutex_lock(&app_container->mutex);
-    iterate_over_dictionary_with_args(
-        app_container->elements_release_callback,
-        (dictionary_iteration_callback_with_args)release_service, app_container);
+    for (dictionary_cursor_t cursor = begin_dictionary_cursor(app_container->elements_release_callback);
+         !is_dictionary_cursor_done(&cursor); next_dictionary_cursor(&cursor))
+        release_service(cursor.record->key, cursor.record->value, app_container);
     delete_dictionary(app_container->services);
     app_container->services = NULL;
     delete_dictionary(app_container->elements_types);
@@ -183,8 +183,10 @@ int release_all_containers(void) {
     if (!containers)
         return IPEE_ERROR_CODE__CONTAINER__SERVICE_UNINITIALIZED;
 
-    iterate_over_dictionary_values(
-        containers, (dictionary_iteration_values_callback)release_container);
+    // Cursor keeps the next record, so the last release may delete containers.
+    for (dictionary_cursor_t cursor = begin_dictionary_cursor(containers);
+         !is_dictionary_cursor_done(&cursor); next_dictionary_cursor(&cursor))
+        release_container(cursor.record->value);
     return 0;
 }
 
@@ -280,7 +282,7 @@ int add_service_to_global_container(
     container_callback_function initial_callback,
     container_callback_function release_callback, void *args) {
     if (!containers)
-        containers = create_dictionary();
+        containers = create_indexed_dictionary();
 
     p_container container = (p_container)get_value_from_dictionary(containers, name_of(global));
     if (!container)
@@ -314,7 +316,7 @@ int add_service_to_container(
 
     switch (type) {
     case SERVICE_TYPE_SINGLETON:
-        add_record_to_dictionary(app_container->services, app_container->services->size, key);
+        add_record_to_int_dictionary(app_container->services, app_container->services->size, key);
         add_record_to_dictionary(app_container->elements_types, key, (void *)SERVICE_TYPE_SINGLETON);
         add_record_to_dictionary(app_container->elements_initial_callback, key, initial_callback);
         add_record_to_dictionary(app_container->elements_release_callback, key, release_callback);
@@ -323,7 +325,7 @@ int add_service_to_container(
         break;
 
     case SERVICE_TYPE_TRANSIENT:
-        add_record_to_dictionary(app_container->services, app_container->services->size, key);
+        add_record_to_int_dictionary(app_container->services, app_container->services->size, key);
         add_record_to_dictionary(app_container->elements_types, key, (void *)SERVICE_TYPE_TRANSIENT);
         add_record_to_dictionary(app_container->elements_initial_callback, key, initial_callback);
         add_record_to_dictionary(app_container->elements_release_callback, key, release_callback);
@@ -332,7 +334,7 @@ int add_service_to_container(
         break;
 
     case SERVICE_TYPE_GLBLVALUE:
-        add_record_to_dictionary(app_container->services, app_container->services->size, key);
+        add_record_to_int_dictionary(app_container->services, app_container->services->size, key);
         add_record_to_dictionary(app_container->elements_types, key, (void *)SERVICE_TYPE_GLBLVALUE);
         add_record_to_dictionary(app_container->elements_initial_callback, key, NULL);
         add_record_to_dictionary(app_container->elements_release_callback, key, release_callback);
@@ -468,7 +470,9 @@ static void release_service(
     case SERVICE_TYPE_TRANSIENT:
         p_dictionary refs = get_value_from_dictionary(container->elements_refs, key);
         if (refs && callback)
-            iterate_over_dictionary_values(refs, (dictionary_iteration_values_callback)callback);
+            for (dictionary_cursor_t cursor = begin_dictionary_cursor(refs);
+                 !is_dictionary_cursor_done(&cursor); next_dictionary_cursor(&cursor))
+                callback(cursor.record->value);
         delete_dictionary(refs);
         refs = NULL;
         break;
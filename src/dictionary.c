@@ -1,10 +1,837 @@
 #include <dictionary.h>
+#include <hash.h>
 
+#include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include <macro.h>
 
+/*********************************************************************************************
+ * MACROS DECLARATIONS
+ ********************************************************************************************/
+
+#define DICTIONARY_INDEX_DEFAULT_CAPACITY 16
+#define DICTIONARY_INDEX_MAX_LOAD 0.75f
+#define DICTIONARY_INDEX_RESIZE_FACTOR 2
+
+#define RECORD_POOL_CACHE_LINE_SIZE 64
+#define RECORD_POOL_MIN_SLAB_CAPACITY 64
+#define RECORD_POOL_MAX_SLAB_CAPACITY 4096
+
+#define KEY_CHUNK_SIZE 4096
+#define KEY_MIN_CLASS_SIZE 16
+#define KEY_CLASSES 5
+
+#define POSITION_INDEX_SEED 2463534242u
+
+/*********************************************************************************************
+ * STRUCTS DECLARATIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Indexed record field.
+ */
+typedef enum dictionary_index_field_e {
+    DICTIONARY_INDEX_FIELD_KEY      = 0, // Record keys compared as strings.
+    DICTIONARY_INDEX_FIELD_VALUE    = 1, // Record values compared as pointers.
+    DICTIONARY_INDEX_FIELD_INT_KEY  = 2, // Record keys compared as integers.
+    DICTIONARY_INDEX_FIELD_TRIE_KEY = 3, // Record keys stored in a radix trie.
+} dictionary_index_field_t;
+
+/**
+ * @brief Index entry.
+ *
+ * @details
+ * One entry exists per distinct key or value. It refers to the first and
+ * the last record with that field in dictionary order and counts all records
+ * sharing it, the records are chained by their links of the index. The field
+ * itself is taken from the first record.
+ */
+typedef struct dictionary_index_entry_s {
+    struct dictionary_index_entry_s *next; // Next entry in bucket chain.
+    uint32_t hash;                         // Field hash.
+    const void *field;                     // Indexed key or value.
+    p_record first;                        // First record with the field.
+    p_record last;                         // Last record with the field.
+    int count;                             // Count of records with the field.
+} dictionary_index_entry_t, *p_dictionary_index_entry;
+
+/**
+ * @brief Radix trie node.
+ *
+ * @details
+ * Node of a compressed trie over key bytes. Edge label is stored in the
+ * node, so a prefix shared by many keys is stored once. A node with no
+ * entry has at least two children, except the root. Index entry of the key
+ * ending at the node is embedded, its count is zero if there is no key.
+ */
+typedef struct dictionary_trie_node_s {
+    dictionary_index_entry_t entry;         // Entry of key ending at the node.
+    struct dictionary_trie_node_s *child;   // First child, children ordered by first label byte.
+    struct dictionary_trie_node_s *sibling; // Next sibling.
+    uint32_t length;                        // Label length.
+    char label[];                           // Edge label.
+} dictionary_trie_node_t, *p_dictionary_trie_node;
+
+/**
+ * @brief Key or value index.
+ *
+ * @details
+ * Separate chaining hash table over distinct record keys or values, or a
+ * radix trie over distinct keys.
+ */
+typedef struct dictionary_index_s {
+    p_dictionary_index_entry *buckets; // Bucket chains.
+    int capacity;                      // Count of buckets, power of two.
+    int count;                         // Count of distinct fields.
+    dictionary_index_field_t field;    // Indexed record field.
+    p_dictionary_trie_node trie;       // Trie root, replaces buckets for trie key index.
+    int hash_offset;                   // Offset of cached key hash in records, string key index only.
+    int chain_offset;                  // Offset of index links in records.
+} dictionary_index_t, *p_dictionary_index;
+
+/**
+ * @brief Position index node.
+ *
+ * @details
+ * Node of a treap ordered by record positions. The heap is kept by random
+ * priorities, so the expected height is O(log n). Each node counts records
+ * of its subtree which gives a position of a record in O(log n).
+ */
+typedef struct record_position_s {
+    struct record_position_s *left;   // Left subtree, preceding records.
+    struct record_position_s *right;  // Right subtree, following records.
+    struct record_position_s *parent; // Parent node.
+    p_record record;                  // Indexed record.
+    uint32_t priority;                // Random heap priority.
+    int size;                         // Count of records in subtree.
+} record_position_t, *p_record_position;
+
+/**
+ * @brief Position index.
+ *
+ * @details
+ * Order statistic tree over dictionary records.
+ */
+typedef struct dictionary_position_index_s {
+    p_record_position root; // Root node.
+    uint32_t seed;          // Priorities generator state.
+} dictionary_position_index_t, *p_dictionary_position_index;
+
+/**
+ * @brief Index links of record.
+ *
+ * @details
+ * Records with equal indexed field are chained in dictionary order, so all
+ * of them are reached without walking the records in between.
+ */
+typedef struct record_chain_s {
+    p_record next; // Next record with the field.
+    p_record prev; // Previous record with the field.
+} record_chain_t, *p_record_chain;
+
+/**
+ * @brief Cached key hash.
+ */
+typedef struct record_key_hash_s {
+    uint32_t hash;   // Key hash.
+    uint32_t length; // Key length.
+} record_key_hash_t, *p_record_key_hash;
+
+/**
+ * @brief Pooled record.
+ *
+ * @details
+ * Layout of records allocated from a record pool. Optional fields have the
+ * same offsets in all dictionaries of a pool, so records can be recycled
+ * and spliced between them. A pool allocates fields only up to the last one
+ * its dictionaries use.
+ */
+typedef struct pooled_record_s {
+    record_t record;            // Record.
+    uint32_t generation;        // Record storage generation.
+    record_key_hash_t key_hash; // Cached key hash and length.
+    char inline_key[8];         // Short owned key storage.
+    p_record_position position; // Position index node.
+    record_chain_t key_chain;   // Key index links.
+    record_chain_t value_chain; // Value index links.
+} pooled_record_t, *p_pooled_record;
+
+/**
+ * @brief Record slab.
+ *
+ * @details
+ * Contiguous cache-line aligned block of records. Records are handed out
+ * sequentially until the slab is exhausted.
+ */
+typedef struct record_slab_s {
+    struct record_slab_s *next;                             // Next slab reference.
+    int capacity;                                           // Count of records in slab.
+    int used;                                               // Count of handed out records.
+    _Alignas(RECORD_POOL_CACHE_LINE_SIZE) char records[];  // Records storage, pool record size each.
+} record_slab_t, *p_record_slab;
+
+/**
+ * @brief Key chunk.
+ *
+ * @details
+ * Block of long owned keys. Keys are handed out sequentially in blocks of
+ * their size class until the chunk is exhausted.
+ */
+typedef struct key_chunk_s {
+    struct key_chunk_s *next;         // Next chunk reference.
+    size_t used;                      // Count of handed out bytes.
+    _Alignas(void *) char data[];     // Keys storage.
+} key_chunk_t, *p_key_chunk;
+
+/**
+ * @brief Record pool.
+ */
+typedef struct record_pool_s {
+    p_record_slab slabs;            // Slabs list, the newest slab first.
+    p_record free_list;             // Recycled records linked by next reference.
+    p_key_chunk key_chunks;         // Key chunks list, the newest chunk first.
+    char *free_keys[KEY_CLASSES];   // Recycled key blocks per size class.
+    int record_size;                // Size of handed out records.
+} record_pool_t, *p_record_pool;
+
+/**
+ * @brief Records comparator.
+ *
+ * @details
+ * Binds either of sort callbacks with its arguments.
+ */
+typedef struct record_comparator_s {
+    dictionary_iteration_callback_sort callback;                     // Sort callback.
+    dictionary_iteration_callback_sort_with_args callback_with_args; // Sort callback with arguments.
+    void *args;                                                      // Arguments for callback function.
+} record_comparator_t, *p_record_comparator;
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ **********************************************************************************************/
+
+/**
+ * @brief Resolve implied and excluded dictionary mode flags.
+ *
+ * @param mode Dictionary mode flags.
+ * @return Effective mode flags.
+ */
+static int get_dictionary_mode(int mode);
+
+/**
+ * @brief Get size of pooled records for dictionary mode.
+ *
+ * @param mode Effective dictionary mode flags.
+ * @return Record size, a multiple of the pointer size.
+ */
+static int get_pooled_record_size(int mode);
+
+/**
+ * @brief Set record size and offsets of optional record fields.
+ *
+ * @details
+ * Pooled records have fixed offsets, heap records pack only the fields of
+ * the dictionary mode after record_t.
+ *
+ * @param dict Dictionary with mode and pool set.
+ */
+static void set_record_layout(const p_dictionary dict);
+
+/**
+ * @brief Get cached key hash of record.
+ *
+ * @param dict Dictionary with DICTIONARY_MODE_KEY_HASH.
+ * @param record Record.
+ * @return Cached key hash and length.
+ */
+static inline p_record_key_hash get_record_key_hash(const p_dictionary dict, const p_record record);
+
+/**
+ * @brief Get position index node link of record.
+ *
+ * @param dict Dictionary with position index.
+ * @param record Record.
+ * @return Position index node link.
+ */
+static inline p_record_position *get_record_position(const p_dictionary dict, const p_record record);
+
+/**
+ * @brief Allocate a new record.
+ *
+ * @details
+ * Record is taken from the dictionary pool if any, otherwise from the heap.
+ *
+ * @param dict Dictionary.
+ * @param key Record key.
+ * @param value Record value.
+ * @param metadata Record metadata.
+ * @return Record or NULL on allocation failure.
+ */
+static p_record create_record(const p_dictionary dict, char *key, void *value, void *metadata);
+
+/**
+ * @brief Release record.
+ *
+ * @details
+ * Record is returned to the dictionary pool if any, otherwise to the heap.
+ *
+ * @param dict Dictionary.
+ * @param record Unlinked record.
+ */
+static void release_record(const p_dictionary dict, p_record record);
+
+/**
+ * @brief Take a record from the pool.
+ *
+ * @param pool Record pool.
+ * @return Record or NULL on allocation failure.
+ */
+static p_record allocate_pooled_record(p_record_pool pool);
+
+/**
+ * @brief Allocate a new slab and make it the current one.
+ *
+ * @param pool Record pool.
+ * @param capacity Count of records in slab.
+ * @return Slab or NULL on allocation failure.
+ */
+static p_record_slab create_record_slab(p_record_pool pool, int capacity);
+
+/**
+ * @brief Get record of slab by index.
+ *
+ * @param pool Record pool of the slab.
+ * @param slab Slab.
+ * @param index Record index in slab.
+ * @return Record.
+ */
+static inline p_record get_slab_record(const p_record_pool pool, p_record_slab slab, int index);
+
+/**
+ * @brief Make room for a batch of records in the pool.
+ *
+ * @details
+ * If the current slab cannot hold the batch, its unused records go to the
+ * free list and a single slab is allocated for the rest of the batch.
+ *
+ * @param pool Record pool.
+ * @param count Count of records.
+ * @return 0 on success, or a negative error code.
+ */
+static int reserve_pooled_records(p_record_pool pool, int count);
+
+/**
+ * @brief Copy key into record storage.
+ *
+ * @details
+ * Short key is stored inside the record, long one in a block of the pool
+ * size class, the longest ones on the heap. Record length has to be set.
+ *
+ * @param pool Record pool.
+ * @param record Record.
+ * @param key Record key.
+ * @return Owned key or NULL on allocation failure.
+ */
+static char *create_record_key(p_record_pool pool, p_record record, const char *key);
+
+/**
+ * @brief Release owned key of record.
+ *
+ * @param pool Record pool.
+ * @param record Record.
+ */
+static void release_record_key(p_record_pool pool, p_record record);
+
+/**
+ * @brief Get size class of owned key.
+ *
+ * @param length Key length.
+ * @return Size class, KEY_CLASSES if key is stored on the heap.
+ */
+static int get_key_class(uint32_t length);
+
+/**
+ * @brief Link record into dictionary.
+ *
+ * @details
+ * Insert record before specified one and update indexes if any.
+ *
+ * @param dict Dictionary.
+ * @param record Record to link.
+ * @param next Record to insert before, NULL to insert at tail.
+ * @return 0 on success, or a negative error code.
+ */
+static int link_record(const p_dictionary dict, p_record record, p_record next);
+
+/**
+ * @brief Unlink record from dictionary.
+ *
+ * @details
+ * Detach record from the list and the key index if any.
+ * Record memory is not released.
+ *
+ * @param dict Dictionary.
+ * @param record Record to unlink.
+ */
+static void unlink_record(const p_dictionary dict, p_record record);
+
+/**
+ * @brief Replace value of a linked record.
+ *
+ * @details
+ * Value index is updated if any. On allocation failure the record is kept untouched.
+ *
+ * @param dict Dictionary.
+ * @param record Record linked into dictionary.
+ * @param value New value.
+ * @return Old value, or NULL on failure.
+ */
+static void *set_record_value(const p_dictionary dict, p_record record, void *value);
+
+/**
+ * @brief Copy dictionary records.
+ *
+ * @details
+ * Create a plain dictionary with the same keys, values and metadata.
+ *
+ * @param dict Dictionary.
+ * @return Dictionary copy or NULL on allocation failure.
+ */
+static p_dictionary copy_records(const p_dictionary dict);
+
+/**
+ * @brief Create dictionary for records derived from a dictionary.
+ *
+ * @details
+ * Derived dictionary keeps integer keys of the source, other modes are
+ * not inherited.
+ *
+ * @param dict Source dictionary.
+ * @return Empty dictionary.
+ */
+static p_dictionary create_derived_dictionary(const p_dictionary dict);
+
+/**
+ * @brief Compare records.
+ *
+ * @param comparator Records comparator.
+ * @param record1 Record 1.
+ * @param record2 Record 2.
+ * @return Nonzero if record1 must be placed after record2, 0 otherwise.
+ */
+static inline int compare_records(
+    const p_record_comparator comparator, const p_record record1, const p_record record2);
+
+/**
+ * @brief Sort dictionary records.
+ *
+ * @details
+ * Bottom-up stable merge sort of the linked list. Records are relinked,
+ * never copied, so record references and metadata stay valid.
+ *
+ * @param dict Dictionary.
+ * @param comparator Records comparator.
+ */
+static void merge_sort_records(const p_dictionary dict, const p_record_comparator comparator);
+
+/**
+ * @brief Add stage to dictionary query.
+ *
+ * @param query Query object.
+ * @param type Stage type.
+ * @return Stage with cleared callbacks, or NULL if query does not exist or is full.
+ */
+static p_dictionary_query_stage add_query_stage(
+    p_dictionary_query query, dictionary_query_stage_type_t type);
+
+/**
+ * @brief Start dictionary query run.
+ *
+ * @details
+ * Reset indices of all stages.
+ *
+ * @param query Query object.
+ * @return Head record of source dictionary.
+ */
+static p_record start_query(p_dictionary_query query);
+
+/**
+ * @brief Pull next record from dictionary query.
+ *
+ * @details
+ * Advance cursor over source records until one passes all stages.
+ *
+ * @param query Query object.
+ * @param cursor Next source record reference.
+ * @return Record produced by the last stage, or NULL if source is exhausted.
+ */
+static p_record pull_query_record(p_dictionary_query query, p_record *cursor);
+
+/**
+ * @brief Create key or value index.
+ *
+ * @param field Indexed record field.
+ * @param hash_offset Offset of cached key hash in records, used by string key index.
+ * @param chain_offset Offset of index links in records.
+ * @return Index or NULL on allocation failure.
+ */
+static p_dictionary_index create_dictionary_index(
+    dictionary_index_field_t field, int hash_offset, int chain_offset);
+
+/**
+ * @brief Delete key or value index.
+ *
+ * @param index Index.
+ */
+static void delete_dictionary_index(p_dictionary_index index);
+
+/**
+ * @brief Find index entry.
+ *
+ * @param index Index.
+ * @param field Record key or value.
+ * @param hash Field hash.
+ * @return Entry reference or NULL if field is not indexed.
+ */
+static p_dictionary_index_entry find_index_entry(
+    const p_dictionary_index index, const void *field, uint32_t hash);
+
+/**
+ * @brief Add linked record to index.
+ *
+ * @details
+ * Index links of the record are written only on success.
+ *
+ * @param dict Dictionary.
+ * @param index Key or value index of the dictionary.
+ * @param record Record already linked into dictionary.
+ * @return 0 on success, or a negative error code.
+ */
+static int index_record(const p_dictionary dict, p_dictionary_index index, p_record record);
+
+/**
+ * @brief Chain a duplicate into its index entry.
+ *
+ * @details
+ * Head and tail records are chained at once, other ones after the preceding
+ * duplicate. It is found by rank with a position index, otherwise by the
+ * nearest record with the field on either side of the new one.
+ *
+ * @param dict Dictionary.
+ * @param index Key or value index of the dictionary.
+ * @param entry Entry of the record field.
+ * @param record Record already linked into dictionary.
+ */
+static void chain_record(
+    const p_dictionary dict, p_dictionary_index index, p_dictionary_index_entry entry, p_record record);
+
+/**
+ * @brief Remove linked record from index.
+ *
+ * @param index Key or value index of the dictionary.
+ * @param record Record still linked into dictionary.
+ * @param field Key or value the record was indexed by.
+ */
+static void unindex_record(p_dictionary_index index, p_record record, const void *field);
+
+/**
+ * @brief Unchain record from its index entry.
+ *
+ * @param index Key or value index of the dictionary.
+ * @param entry Entry of the record field.
+ * @param record Chained record.
+ */
+static void unchain_record(p_dictionary_index index, p_dictionary_index_entry entry, p_record record);
+
+/**
+ * @brief Rebuild index chains in dictionary order.
+ *
+ * @param dict Dictionary.
+ * @param index Key or value index of the dictionary.
+ */
+static void rechain_records(const p_dictionary dict, p_dictionary_index index);
+
+/**
+ * @brief Resize index.
+ *
+ * @param index Index.
+ * @return 0 on success, or a negative error code.
+ */
+static int resize_dictionary_index(p_dictionary_index index, int capacity);
+
+/**
+ * @brief Grow index ahead of a batch of records.
+ *
+ * @details
+ * Index is resized once to hold the batch without exceeding the load factor.
+ * Trie index needs no room. A failed resize is left to the per-record growth.
+ *
+ * @param index Index.
+ * @param count Count of records to be indexed.
+ */
+static void reserve_dictionary_index(p_dictionary_index index, int count);
+
+/**
+ * @brief Create radix trie node.
+ *
+ * @param label Edge label, NULL to leave label bytes to the caller.
+ * @param length Label length.
+ * @return Node with empty entry or NULL on allocation failure.
+ */
+static p_dictionary_trie_node create_trie_node(const char *label, uint32_t length);
+
+/**
+ * @brief Delete radix trie node with its subtree.
+ *
+ * @param node Node.
+ */
+static void delete_trie_node(p_dictionary_trie_node node);
+
+/**
+ * @brief Find link to child starting with a byte.
+ *
+ * @param node Parent node.
+ * @param byte First label byte.
+ * @return Link to the child, or link where such a child would be inserted.
+ */
+static p_dictionary_trie_node *find_trie_link(p_dictionary_trie_node node, char byte);
+
+/**
+ * @brief Find trie node of key or prefix.
+ *
+ * @param root Trie root.
+ * @param key Key or prefix.
+ * @param prefix Nonzero to accept a node whose path only starts with key.
+ * @return Node or NULL if there is none.
+ */
+static p_dictionary_trie_node find_trie_node(p_dictionary_trie_node root, const char *key, int prefix);
+
+/**
+ * @brief Insert key into trie.
+ *
+ * @details
+ * Existing node of the key is returned as is, nodes are split as needed.
+ *
+ * @param root Trie root.
+ * @param key Record key.
+ * @return Entry of the key node or NULL on allocation failure.
+ */
+static p_dictionary_index_entry insert_trie_entry(p_dictionary_trie_node root, const char *key);
+
+/**
+ * @brief Remove key with empty entry from trie.
+ *
+ * @details
+ * Node of the key is removed or merged with its only child, then its
+ * parent is merged with its only remaining child.
+ *
+ * @param root Trie root.
+ * @param key Record key.
+ */
+static void remove_trie_entry(p_dictionary_trie_node root, const char *key);
+
+/**
+ * @brief Remove node without entry or merge it with its only child.
+ *
+ * @param link Link to the node.
+ */
+static void compact_trie_node(p_dictionary_trie_node *link);
+
+/**
+ * @brief Visit records of trie subtree in key order.
+ *
+ * @param index Trie key index.
+ * @param node Subtree root.
+ * @param callback Callback function.
+ * @param args Arguments for callback function.
+ * @return Count of visited records.
+ */
+static int visit_trie_records(const p_dictionary_index index, p_dictionary_trie_node node,
+    dictionary_iteration_callback_with_args callback, void *args);
+
+/**
+ * @brief Get index links of record.
+ *
+ * @param index Index.
+ * @param record Record.
+ * @return Index links.
+ */
+static inline p_record_chain get_record_chain(const p_dictionary_index index, const p_record record);
+
+/**
+ * @brief Get indexed field of record.
+ *
+ * @param index Index.
+ * @param record Record.
+ * @return Record key or value.
+ */
+static inline const void *get_record_field(const p_dictionary_index index, const p_record record);
+
+/**
+ * @brief Hash key or value of record.
+ *
+ * @details
+ * Key hash is cached in the record, value is passed explicitly since it may
+ * differ from the current value of the record while it is being replaced.
+ *
+ * @param index Index.
+ * @param record Record.
+ * @param field Record key or value.
+ * @return Hash value.
+ */
+static inline uint32_t hash_field(const p_dictionary_index index, const p_record record, const void *field);
+
+/**
+ * @brief Compare two keys or values.
+ *
+ * @param index Index.
+ * @param field1 Record key or value 1.
+ * @param field2 Record key or value 2.
+ * @return 1 if equal, 0 otherwise.
+ */
+static inline int match_field(const p_dictionary_index index, const void *field1, const void *field2);
+
+/**
+ * @brief Hash of a pointer value.
+ *
+ * @param value Record value.
+ * @return Hash value.
+ */
+static inline uint32_t hash_pointer(const void *value);
+
+/**
+ * @brief Find record by key starting from specified record.
+ *
+ * @details
+ * If records cache key hashes, hash and length are compared before the keys.
+ *
+ * @param dict Dictionary.
+ * @param record Record to start from.
+ * @param key Record key.
+ * @param hash Key hash, ignored if records do not cache hashes.
+ * @param length Key length, ignored if records do not cache hashes.
+ * @return Record or NULL.
+ */
+static inline p_record find_record(
+    const p_dictionary dict, p_record record, const char *key, uint32_t hash, uint32_t length);
+
+/**
+ * @brief Hash key according to dictionary mode.
+ *
+ * @details
+ * Integer keys are hashed as pointers, string keys only if key hash is
+ * enabled, otherwise the hash is zero.
+ *
+ * @param dict Dictionary.
+ * @param key Record key.
+ * @param length Key length output, zero for integer keys.
+ * @return Key hash.
+ */
+static inline uint32_t hash_key(const p_dictionary dict, const char *key, uint32_t *length);
+
+/**
+ * @brief Compare record key with specified one.
+ *
+ * @param dict Dictionary.
+ * @param record Record.
+ * @param key Record key.
+ * @param hash Key hash, ignored if records do not cache hashes.
+ * @param length Key length, ignored if records do not cache hashes.
+ * @return 1 if keys are equal, 0 otherwise.
+ */
+static inline int match_record_key(
+    const p_dictionary dict, const p_record record, const char *key, uint32_t hash, uint32_t length);
+
+/**
+ * @brief Create position index.
+ *
+ * @return Position index.
+ */
+static p_dictionary_position_index create_position_index(void);
+
+/**
+ * @brief Delete position index and its nodes.
+ *
+ * @param index Position index.
+ */
+static void delete_position_index(p_dictionary_position_index index);
+
+/**
+ * @brief Add record to the position index.
+ *
+ * @details
+ * Record must be already linked into the dictionary list.
+ *
+ * @param dict Dictionary.
+ * @param record Record.
+ * @return 0 on success, or a negative error code.
+ */
+static int index_record_position(const p_dictionary dict, p_record record);
+
+/**
+ * @brief Remove record from the position index.
+ *
+ * @param dict Dictionary.
+ * @param record Record.
+ */
+static void unindex_record_position(const p_dictionary dict, p_record record);
+
+/**
+ * @brief Find record by position.
+ *
+ * @param index Position index.
+ * @param position Record position.
+ * @return Record, or NULL.
+ */
+static p_record select_record_position(const p_dictionary_position_index index, int position);
+
+/**
+ * @brief Get position of an indexed record.
+ *
+ * @param node Position index node of the record.
+ * @param root Receives root of the tree the node belongs to.
+ * @return Record position.
+ */
+static int rank_record_position(p_record_position node, p_record_position *root);
+
+/**
+ * @brief Split treap by position.
+ *
+ * @param node Treap root.
+ * @param count Count of nodes to put into left part.
+ * @param left Receives left part.
+ * @param right Receives right part.
+ */
+static void split_positions(
+    p_record_position node, int count, p_record_position *left, p_record_position *right);
+
+/**
+ * @brief Merge two treaps, all nodes of the left one precede the right one.
+ *
+ * @param left Left treap.
+ * @param right Right treap.
+ * @return Root of merged treap.
+ */
+static p_record_position merge_positions(p_record_position left, p_record_position right);
+
+/**
+ * @brief Recount subtree size and adopt children of a node.
+ *
+ * @param node Node.
+ */
+static inline void update_position(p_record_position node);
+
+/**
+ * @brief Get count of records in subtree.
+ *
+ * @param node Subtree root.
+ * @return Count of records.
+ */
+static inline int position_size(const p_record_position node);
+
 /***********************************************************************************************
  * FUNCTIONS DEFINITIONS
  **********************************************************************************************/
@@ -14,6 +841,14 @@ p_dictionary create_dictionary(void) {
 }
 
 p_dictionary create_dictionary_with_metadata(void *metadata) {
+    return create_dictionary_with_mode(DICTIONARY_MODE_DEFAULT, metadata);
+}
+
+p_dictionary create_dictionary_with_mode(int mode, void *metadata) {
+    return create_dictionary_with_pool(mode, NULL, metadata);
+}
+
+p_dictionary create_dictionary_with_pool(int mode, p_record_pool pool, void *metadata) {
     p_dictionary dict = (p_dictionary)malloc(sizeof(dictionary_t));
     if (!dict) {
         return NULL;
@@ -23,26 +858,146 @@ p_dictionary create_dictionary_with_metadata(void *metadata) {
     dict->head = NULL;
     dict->tail = NULL;
     dict->metadata = metadata;
+    mode = get_dictionary_mode(mode);
+    dict->mode = mode;
+    dict->key_index = NULL;
+    dict->value_index = NULL;
+    dict->pool = pool;
+    dict->position_index = NULL;
+
+    // Shared pool is owned by the caller, private one - by the dictionary.
+    if (pool)
+        dict->mode &= ~DICTIONARY_MODE_RECORD_POOL;
+    else if (mode & DICTIONARY_MODE_RECORD_POOL) {
+        dict->pool = create_record_pool_with_mode(mode);
+        if (!dict->pool) {
+            free(dict);
+            return NULL;
+        }
+    }
+
+    set_record_layout(dict);
+    if (pool && dict->record_size > pool->record_size) {
+        // Records already handed out cannot grow.
+        if (pool->slabs) {
+            free(dict);
+            return NULL;
+        }
+        pool->record_size = dict->record_size;
+    }
+
+    if (mode & DICTIONARY_MODE_KEY_INDEX) {
+        dictionary_index_field_t field = DICTIONARY_INDEX_FIELD_KEY;
+        if (mode & DICTIONARY_MODE_INT_KEYS)
+            field = DICTIONARY_INDEX_FIELD_INT_KEY;
+        else if (mode & DICTIONARY_MODE_KEY_TRIE)
+            field = DICTIONARY_INDEX_FIELD_TRIE_KEY;
+        dict->key_index = create_dictionary_index(field, dict->hash_offset, dict->key_chain_offset);
+        if (!dict->key_index) {
+            delete_dictionary(dict);
+            return NULL;
+        }
+    }
+
+    if (mode & DICTIONARY_MODE_VALUE_INDEX) {
+        dict->value_index = create_dictionary_index(DICTIONARY_INDEX_FIELD_VALUE, 0, dict->value_chain_offset);
+        if (!dict->value_index) {
+            delete_dictionary(dict);
+            return NULL;
+        }
+    }
+
+    if (mode & DICTIONARY_MODE_POSITION_INDEX) {
+        dict->position_index = create_position_index();
+        if (!dict->position_index) {
+            delete_dictionary(dict);
+            return NULL;
+        }
+    }
 
     return dict;
 }
 
+p_dictionary create_indexed_dictionary(void) {
+    return create_indexed_dictionary_with_metadata(NULL);
+}
+
+p_dictionary create_indexed_dictionary_with_metadata(void *metadata) {
+    return create_dictionary_with_mode(DICTIONARY_MODE_KEY_INDEX, metadata);
+}
+
+p_dictionary create_int_dictionary(void) {
+    return create_dictionary_with_mode(DICTIONARY_MODE_INT_KEYS | DICTIONARY_MODE_KEY_INDEX, NULL);
+}
+
 int delete_dictionary(p_dictionary dict) {
     if (!dict) {
         return IPEE_ERROR_CODE__DICTIONARY__NOT_EXISTS;
     }
 
-    p_record current = dict->head;
-    while (current) {
-        p_record next = current->next;
-        free(current);
-        current = next;
+    if (dict->mode & DICTIONARY_MODE_RECORD_POOL) {
+        // Keys of the heap size class live outside the pool.
+        if (dict->mode & DICTIONARY_MODE_OWNED_KEYS)
+            for (p_record current = dict->head; current; current = current->next)
+                if (get_key_class(((p_pooled_record)current)->key_hash.length) == KEY_CLASSES)
+                    free(current->key);
+        delete_record_pool(dict->pool);
+    } else {
+        p_record current = dict->head;
+        while (current) {
+            p_record next = current->next;
+            release_record(dict, current);
+            current = next;
+        }
     }
 
+    delete_dictionary_index(dict->key_index);
+    delete_dictionary_index(dict->value_index);
+    delete_position_index(dict->position_index);
     free(dict);
     return 0;
 }
 
+p_record_pool create_record_pool(void) {
+    return create_record_pool_with_mode(DICTIONARY_MODE_DEFAULT);
+}
+
+p_record_pool create_record_pool_with_mode(int mode) {
+    p_record_pool pool = (p_record_pool)malloc(sizeof(record_pool_t));
+    if (!pool)
+        return NULL;
+
+    pool->slabs = NULL;
+    pool->free_list = NULL;
+    pool->key_chunks = NULL;
+    for (int i = 0; i < KEY_CLASSES; i++)
+        pool->free_keys[i] = NULL;
+    pool->record_size = get_pooled_record_size(get_dictionary_mode(mode));
+    return pool;
+}
+
+int delete_record_pool(p_record_pool pool) {
+    if (!pool)
+        return IPEE_ERROR_CODE__DICTIONARY__POOL_NOT_EXISTS;
+
+    p_record_slab slab = pool->slabs;
+    while (slab) {
+        p_record_slab next = slab->next;
+        free(slab);
+        slab = next;
+    }
+
+    p_key_chunk chunk = pool->key_chunks;
+    while (chunk) {
+        p_key_chunk next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+
+    free(pool);
+    return 0;
+}
+
 int add_record_to_dictionary(const p_dictionary dict, char *key, void *value) {
     return add_record_to_dictionary_with_metadata(dict, key, value, NULL);
 }
@@ -52,25 +1007,14 @@ int add_record_to_dictionary_with_metadata(
     if (!dict)
         return IPEE_ERROR_CODE__DICTIONARY__NOT_EXISTS;
 
-    p_record record = (p_record)malloc(sizeof(record_t));
+    p_record record = create_record(dict, key, value, metadata);
     if (!record)
         return IPEE_ERROR_CODE__DICTIONARY__RECORD_CREATION_ERROR;
 
-    record->key = key;
-    record->value = value;
-    record->next = NULL;
-    record->prev = dict->tail;
-    record->metadata = metadata;
-
-    if (!dict->size) {
-        dict->head = record;
-        dict->tail = record;
-    } else {
-        dict->tail->next = record;
-        dict->tail = record;
-    }
-    dict->size++;
-    return 0;
+    int result = link_record(dict, record, NULL);
+    if (result)
+        release_record(dict, record);
+    return result;
 }
 
 int emplace_record_to_dictionary(const p_dictionary dict, char *key, void *value) {
@@ -94,122 +1038,223 @@ int add_record_to_dictionary_by_index_with_metadata(
     if (index < 0 || index > dict->size)
         return IPEE_ERROR_CODE__DICTIONARY__INDEX_OUT_OF_RANGE;
 
-    p_record record = (p_record)malloc(sizeof(record_t));
+    p_record next = NULL;
+    if (index < dict->size) {
+        next = get_record_from_dictionary_by_index(dict, index);
+        if (!next)
+            return IPEE_ERROR_CODE__DICTIONARY__INDEX_OUT_OF_RANGE;
+    }
+
+    p_record record = create_record(dict, key, value, metadata);
     if (!record)
         return IPEE_ERROR_CODE__DICTIONARY__RECORD_CREATION_ERROR;
 
-    record->key = key;
-    record->value = value;
-    record->next = NULL;
-    record->prev = NULL;
-    record->metadata = metadata;
+    int result = link_record(dict, record, next);
+    if (result)
+        release_record(dict, record);
+    return result;
+}
+
+int append_records_to_dictionary(const p_dictionary dict, const record_t *records, int count) {
+    if (!dict)
+        return IPEE_ERROR_CODE__DICTIONARY__NOT_EXISTS;
+    if (count <= 0)
+        return 0;
+
+    if (dict->pool && reserve_pooled_records(dict->pool, count))
+        return IPEE_ERROR_CODE__DICTIONARY__RECORD_CREATION_ERROR;
+    if (dict->key_index)
+        reserve_dictionary_index(dict->key_index, count);
+    if (dict->value_index)
+        reserve_dictionary_index(dict->value_index, count);
+
+    for (int i = 0; i < count; i++) {
+        p_record record = create_record(dict, records[i].key, records[i].value, records[i].metadata);
+        int result = record ? link_record(dict, record, NULL) : IPEE_ERROR_CODE__DICTIONARY__RECORD_CREATION_ERROR;
+        if (!result)
+            continue;
+
+        // Records appended before the failure are taken back from the tail.
+        if (record)
+            release_record(dict, record);
+        while (i-- > 0) {
+            record = dict->tail;
+            unlink_record(dict, record);
+            release_record(dict, record);
+        }
+        return result;
+    }
+    return 0;
+}
+
+int splice_dictionary(const p_dictionary dict, const p_dictionary source) {
+    if (!dict || !source)
+        return IPEE_ERROR_CODE__DICTIONARY__NOT_EXISTS;
+
+    const int key_modes = DICTIONARY_MODE_OWNED_KEYS | DICTIONARY_MODE_INT_KEYS;
+    if (dict == source || dict->pool != source->pool || (dict->mode ^ source->mode) & key_modes)
+        return IPEE_ERROR_CODE__DICTIONARY__INCOMPATIBLE_MODE;
+    if (!source->head)
+        return 0;
 
-    if (!dict->size || index == dict->size) {
-        record->prev = dict->tail;
+    // Heap records grow to the destination layout, pooled ones share the pool layout.
+    const int resize = !dict->pool && dict->record_size > source->record_size;
+    const int rehash = (dict->mode & DICTIONARY_MODE_KEY_HASH) &&
+        (!(source->mode & DICTIONARY_MODE_KEY_HASH) || dict->hash_offset != source->hash_offset);
+    if (!resize && !rehash && !dict->key_index && !dict->value_index && !dict->position_index &&
+        !source->key_index && !source->value_index && !source->position_index) {
+        source->head->prev = dict->tail;
         if (dict->tail)
-            dict->tail->next = record;
+            dict->tail->next = source->head;
         else
-            dict->head = record;
-        dict->tail = record;
-        dict->size++;
+            dict->head = source->head;
+        dict->tail = source->tail;
+        dict->size += source->size;
+
+        source->head = NULL;
+        source->tail = NULL;
+        source->size = 0;
         return 0;
     }
 
-    p_record current = get_record_from_dictionary_by_index(dict, index);
-    if (!current) {
-        free(record);
-        return IPEE_ERROR_CODE__DICTIONARY__INDEX_OUT_OF_RANGE;
+    if (dict->key_index)
+        reserve_dictionary_index(dict->key_index, source->size);
+    if (dict->value_index)
+        reserve_dictionary_index(dict->value_index, source->size);
+
+    while (source->head) {
+        p_record record = source->head;
+        unlink_record(source, record);
+        int result = 0;
+        if (resize) {
+            p_record resized = (p_record)realloc(record, dict->record_size);
+            if (resized)
+                record = resized;
+            else
+                result = IPEE_ERROR_CODE__DICTIONARY__RECORD_CREATION_ERROR;
+        }
+        if (!result && rehash) {
+            p_record_key_hash key_hash = get_record_key_hash(dict, record);
+            key_hash->hash = hash_key(dict, record->key, &key_hash->length);
+        }
+        if (!result)
+            result = link_record(dict, record, NULL);
+        if (!result)
+            continue;
+
+        // Destination fields may overlap the cached hash of the source layout.
+        if (source->mode & DICTIONARY_MODE_KEY_HASH) {
+            p_record_key_hash key_hash = get_record_key_hash(source, record);
+            key_hash->hash = hash_key(source, record->key, &key_hash->length);
+        }
+        if (link_record(source, record, source->head))
+            release_record(source, record);
+        return result;
     }
+    return 0;
+}
 
-    if (dict->head == current) {
-        record->next = current;
-        current->prev = record;
-        dict->head = record;
-    } else {
-        record->next = current;
-        record->prev = current->prev;
-        if (current->prev)
-            current->prev->next = record;
-        current->prev = record;
+int merge_dictionaries(
+    const p_dictionary dict, const p_dictionary source, dictionary_merge_policy_t policy) {
+    if (!dict || !source)
+        return IPEE_ERROR_CODE__DICTIONARY__NOT_EXISTS;
+    if ((dict->mode ^ source->mode) & DICTIONARY_MODE_INT_KEYS)
+        return IPEE_ERROR_CODE__DICTIONARY__INCOMPATIBLE_MODE;
+
+    // Count is taken up front, so a dictionary merged into itself stops at its old tail.
+    const int count = source->size;
+    if (dict->pool && reserve_pooled_records(dict->pool, count))
+        return IPEE_ERROR_CODE__DICTIONARY__RECORD_CREATION_ERROR;
+    if (dict->key_index)
+        reserve_dictionary_index(dict->key_index, count);
+    if (dict->value_index)
+        reserve_dictionary_index(dict->value_index, count);
+
+    const int hashed = dict->mode & source->mode & DICTIONARY_MODE_KEY_HASH;
+    p_record current = source->head;
+    for (int i = 0; i < count; i++, current = current->next) {
+        p_record record = NULL;
+        if (policy != DICTIONARY_MERGE_APPEND) {
+            record = hashed
+                ? get_record_from_dictionary_hashed(
+                      dict, current->key, get_record_key_hash(source, current)->hash)
+                : get_record_from_dictionary(dict, current->key);
+        }
+
+        if (!record) {
+            int result = add_record_to_dictionary_with_metadata(
+                dict, current->key, current->value, current->metadata);
+            if (result)
+                return result;
+        } else if (policy == DICTIONARY_MERGE_REPLACE) {
+            // Failed value index update keeps the old value.
+            set_record_value(dict, record, current->value);
+            if (record->value != current->value)
+                return IPEE_ERROR_CODE__DICTIONARY__RECORD_CREATION_ERROR;
+        }
     }
-    dict->size++;
     return 0;
 }
 
 void *remove_record_from_dictionary(const p_dictionary dict, char *key) {
-    if (!dict)
+    p_record record = get_record_from_dictionary(dict, key);
+    if (!record)
         return NULL;
 
-    p_record current = dict->head;
-    while (current) {
-        if (strcmp(current->key, key) == 0) {
-            if (current->prev)
-                current->prev->next = current->next;
-            else
-                dict->head = current->next;
-
-            if (current->next)
-                current->next->prev = current->prev;
-            else
-                dict->tail = current->prev;
-
-            void *removed_value = current->value;
-            free(current);
-            dict->size--;
-            return removed_value;
-        }
-        current = current->next;
-    }
-    return NULL;
+    void *removed_value = record->value;
+    unlink_record(dict, record);
+    release_record(dict, record);
+    return removed_value;
 }
 
 void *remove_record_from_dictionary_by_index(const p_dictionary dict, int index) {
-    if (!dict)
-        return NULL;
-    if (index < 0 || index >= dict->size)
+    p_record record = get_record_from_dictionary_by_index(dict, index);
+    if (!record)
         return NULL;
 
-    p_record current = dict->head;
-    for (int i = 0; i < index; i++) {
-        if (!current)
-            return NULL;
-        current = current->next;
-    }
-
-    if (current->prev)
-        current->prev->next = current->next;
-    else
-        dict->head = current->next;
+    void *removed_value = record->value;
+    unlink_record(dict, record);
+    release_record(dict, record);
+    return removed_value;
+}
 
-    if (current->next)
-        current->next->prev = current->prev;
-    else
-        dict->tail = current->prev;
+void *remove_record_from_dictionary_by_ref(const p_dictionary dict, record_ref_t ref) {
+    if (!is_record_ref_valid(dict, ref))
+        return NULL;
 
-    void *removed_value = current->value;
-    free(current);
-    dict->size--;
+    void *removed_value = ref.record->value;
+    unlink_record(dict, ref.record);
+    release_record(dict, ref.record);
     return removed_value;
 }
 
 void *update_record_in_dictionary(const p_dictionary dict, char *key, void *value) {
-    void *old_value = NULL;
     p_record record = get_record_from_dictionary(dict, key);
-    if (record) {
-        old_value = record->value;
-        record->value = value;
-    }
-    return old_value;
+    return record ? set_record_value(dict, record, value) : NULL;
 }
 
 void *update_record_in_dictionary_by_index(const p_dictionary dict, int index, void *value) {
-    void *old_value = NULL;
     p_record record = get_record_from_dictionary_by_index(dict, index);
-    if (record) {
-        old_value = record->value;
-        record->value = value;
-    }
-    return old_value;
+    return record ? set_record_value(dict, record, value) : NULL;
+}
+
+void *update_record_in_dictionary_by_ref(const p_dictionary dict, record_ref_t ref, void *value) {
+    if (!is_record_ref_valid(dict, ref))
+        return NULL;
+
+    return set_record_value(dict, ref.record, value);
+}
+
+record_ref_t get_record_ref(const p_dictionary dict, const p_record record) {
+    if (!dict || !dict->pool || !record)
+        return (record_ref_t){.record = NULL, .generation = 0};
+    return (record_ref_t){.record = record, .generation = ((p_pooled_record)record)->generation};
+}
+
+int is_record_ref_valid(const p_dictionary dict, const record_ref_t ref) {
+    if (!dict || !dict->pool || !ref.record)
+        return 0;
+    return ((p_pooled_record)ref.record)->generation == ref.generation;
 }
 
 int contains_key_in_dictionary(const p_dictionary dict, char *key) {
@@ -277,25 +1322,78 @@ p_record get_record_from_dictionary(const p_dictionary dict, char *key) {
     if (!dict)
         return NULL;
 
-    p_record record = dict->head;
-    while (record) {
-        if (strcmp(record->key, key) == 0)
-            return record;
-        record = record->next;
+    uint32_t length = 0;
+    uint32_t hash = hash_key(dict, key, &length);
+    if (dict->key_index) {
+        p_dictionary_index_entry entry = find_index_entry(dict->key_index, key, hash);
+        return entry ? entry->first : NULL;
     }
-    return NULL;
+    return find_record(dict, dict->head, key, hash, length);
+}
+
+p_record get_record_from_dictionary_hashed(const p_dictionary dict, char *key, uint32_t hash) {
+    // Integer keys are hashed by hash_pointer, callers can not compute their hash.
+    if (!dict || dict->mode & DICTIONARY_MODE_INT_KEYS)
+        return NULL;
+
+    if (dict->key_index) {
+        p_dictionary_index_entry entry = find_index_entry(dict->key_index, key, hash);
+        return entry ? entry->first : NULL;
+    }
+    return find_record(dict, dict->head, key, hash, strlen(key));
+}
+
+uint32_t hash_dictionary_key(const char *key) {
+    return hash_data(key, strlen(key));
+}
+
+int add_record_to_int_dictionary(const p_dictionary dict, intptr_t key, void *value) {
+    return add_record_to_dictionary(dict, (char *)key, value);
+}
+
+void *remove_record_from_int_dictionary(const p_dictionary dict, intptr_t key) {
+    return remove_record_from_dictionary(dict, (char *)key);
+}
+
+void *update_record_in_int_dictionary(const p_dictionary dict, intptr_t key, void *value) {
+    return update_record_in_dictionary(dict, (char *)key, value);
+}
+
+p_record get_record_from_int_dictionary(const p_dictionary dict, intptr_t key) {
+    return get_record_from_dictionary(dict, (char *)key);
+}
+
+void *get_value_from_int_dictionary(const p_dictionary dict, intptr_t key) {
+    p_record record = get_record_from_dictionary(dict, (char *)key);
+    return record ? record->value : NULL;
+}
+
+int contains_key_in_int_dictionary(const p_dictionary dict, intptr_t key) {
+    return get_record_from_dictionary(dict, (char *)key) != NULL;
 }
 
 p_dictionary get_records_from_dictionary(const p_dictionary dict, char *key) {
     if (!dict)
         return NULL;
 
-    p_dictionary records_dict = create_dictionary();
-    p_record record = dict->head;
-    while (record) {
-        if (strcmp(record->key, key) == 0)
+    uint32_t length = 0;
+    uint32_t hash = hash_key(dict, key, &length);
+
+    p_dictionary records_dict = create_derived_dictionary(dict);
+    if (dict->key_index) {
+        p_dictionary_index_entry entry = find_index_entry(dict->key_index, key, hash);
+        p_record record = entry ? entry->first : NULL;
+        while (record) {
             add_record_to_dictionary(records_dict, record->key, record->value);
-        record = record->next;
+            record = get_record_chain(dict->key_index, record)->next;
+        }
+        return records_dict;
+    }
+
+    p_record record = find_record(dict, dict->head, key, hash, length);
+    while (record) {
+        add_record_to_dictionary(records_dict, record->key, record->value);
+        record = find_record(dict, record->next, key, hash, length);
     }
     return records_dict;
 }
@@ -304,6 +1402,11 @@ p_record get_record_from_dictionary_by_value(const p_dictionary dict, void *valu
     if (!dict)
         return NULL;
 
+    if (dict->value_index) {
+        p_dictionary_index_entry entry = find_index_entry(dict->value_index, value, hash_pointer(value));
+        return entry ? entry->first : NULL;
+    }
+
     p_record record = dict->head;
     while (record) {
         if (record->value == value)
@@ -317,7 +1420,17 @@ p_dictionary get_records_from_dictionary_by_value(const p_dictionary dict, void
     if (!dict)
         return NULL;
 
-    p_dictionary records_dict = create_dictionary();
+    p_dictionary records_dict = create_derived_dictionary(dict);
+    if (dict->value_index) {
+        p_dictionary_index_entry entry = find_index_entry(dict->value_index, value, hash_pointer(value));
+        p_record record = entry ? entry->first : NULL;
+        while (record) {
+            add_record_to_dictionary(records_dict, record->key, record->value);
+            record = get_record_chain(dict->value_index, record)->next;
+        }
+        return records_dict;
+    }
+
     p_record record = dict->head;
     while (record) {
         if (record->value == value)
@@ -347,6 +1460,9 @@ p_record get_record_from_dictionary_by_index(const p_dictionary dict, int index)
     if (index < 0 || index >= dict->size)
         return NULL;
 
+    if (dict->position_index)
+        return select_record_position(dict->position_index, index);
+
     p_record record = dict->head;
     for (int i = 0; i < index; i++) {
         if (!record)
@@ -360,10 +1476,18 @@ int get_index_from_dictionary_by_key(const p_dictionary dict, char *key) {
     if (!dict)
         return IPEE_ERROR_CODE__DICTIONARY__NOT_EXISTS;
 
+    if (dict->key_index) {
+        p_record record = get_record_from_dictionary(dict, key);
+        return record ? get_index_from_dictionary_by_ref_record(dict, record) : -1;
+    }
+
+    uint32_t length = 0;
+    uint32_t hash = hash_key(dict, key, &length);
+
     p_record record = dict->head;
     int index = 0;
     while (record) {
-        if (strcmp(record->key, key) == 0)
+        if (match_record_key(dict, record, key, hash, length))
             return index;
         record = record->next;
         index++;
@@ -375,6 +1499,15 @@ int get_index_from_dictionary_by_ref_record(const p_dictionary dict, p_record re
     if (!dict)
         return IPEE_ERROR_CODE__DICTIONARY__NOT_EXISTS;
 
+    if (dict->position_index) {
+        if (!record || !*get_record_position(dict, record))
+            return -1;
+
+        p_record_position root = NULL;
+        int index = rank_record_position(*get_record_position(dict, record), &root);
+        return root == dict->position_index->root ? index : -1;
+    }
+
     p_record current = dict->head;
     int index = 0;
     while (current) {
@@ -414,6 +1547,30 @@ int iterate_over_dictionary_with_args(
     return 0;
 }
 
+int iterate_over_dictionary_prefix_with_args(
+    const p_dictionary dict, const char *prefix,
+    dictionary_iteration_callback_with_args callback, void *args) {
+    if (!dict)
+        return IPEE_ERROR_CODE__DICTIONARY__NOT_EXISTS;
+    if (dict->mode & DICTIONARY_MODE_INT_KEYS)
+        return IPEE_ERROR_CODE__DICTIONARY__INCOMPATIBLE_MODE;
+
+    if (dict->key_index && dict->key_index->trie) {
+        p_dictionary_trie_node node = find_trie_node(dict->key_index->trie, prefix, 1);
+        return node ? visit_trie_records(dict->key_index, node, callback, args) : 0;
+    }
+
+    const size_t length = strlen(prefix);
+    int count = 0;
+    for (p_record current = dict->head; current; current = current->next) {
+        if (strncmp(current->key, prefix, length) == 0) {
+            callback(current->key, current->value, args);
+            count++;
+        }
+    }
+    return count;
+}
+
 int iterate_over_dictionary_keys(
     const p_dictionary dict, dictionary_iteration_keys_callback callback) {
     if (!dict)
@@ -503,7 +1660,7 @@ p_dictionary map_dictionary(
     if (!dict)
         return NULL;
 
-    p_dictionary new_dict = create_dictionary();
+    p_dictionary new_dict = create_derived_dictionary(dict);
     p_record current = dict->head;
     int index = 0;
     while (current) {
@@ -523,7 +1680,7 @@ p_dictionary map_dictionary_with_args(
     if (!dict)
         return NULL;
 
-    p_dictionary new_dict = create_dictionary();
+    p_dictionary new_dict = create_derived_dictionary(dict);
     p_record current = dict->head;
     int index = 0;
     while (current) {
@@ -542,7 +1699,7 @@ p_dictionary filter_dictionary(
     if (!dict)
         return NULL;
 
-    p_dictionary new_dict = create_dictionary();
+    p_dictionary new_dict = create_derived_dictionary(dict);
     p_record current = dict->head;
     int index = 0;
     while (current) {
@@ -561,7 +1718,7 @@ p_dictionary filter_dictionary_with_args(
     if (!dict)
         return NULL;
 
-    p_dictionary new_dict = create_dictionary();
+    p_dictionary new_dict = create_derived_dictionary(dict);
     p_record current = dict->head;
     int index = 0;
     while (current) {
@@ -613,27 +1770,10 @@ p_dictionary sort_dictionary(
     if (!dict)
         return NULL;
 
-    p_dictionary new_dict = create_dictionary();
-    p_record current = dict->head;
-    while (current) {
-        add_record_to_dictionary(new_dict, current->key, current->value);
-        current = current->next;
-    }
-    p_record current1 = new_dict->head;
-    while (current1) {
-        p_record current2 = current1->next;
-        while (current2) {
-            if (callback(current1, current2)) {
-                char *key = current1->key;
-                void *value = current1->value;
-                current1->key = current2->key;
-                current1->value = current2->value;
-                current2->key = key;
-                current2->value = value;
-            }
-            current2 = current2->next;
-        }
-        current1 = current1->next;
+    p_dictionary new_dict = copy_records(dict);
+    if (new_dict) {
+        record_comparator_t comparator = {callback, NULL, NULL};
+        merge_sort_records(new_dict, &comparator);
     }
     return new_dict;
 }
@@ -643,27 +1783,1295 @@ p_dictionary sort_dictionary_with_args(
     if (!dict)
         return NULL;
 
-    p_dictionary new_dict = create_dictionary();
-    p_record current = dict->head;
-    while (current) {
-        add_record_to_dictionary(new_dict, current->key, current->value);
-        current = current->next;
-    }
-    p_record current1 = new_dict->head;
-    while (current1) {
-        p_record current2 = current1->next;
-        while (current2) {
-            if (callback(current1, current2, args)) {
-                char *key = current1->key;
-                void *value = current1->value;
-                current1->key = current2->key;
-                current1->value = current2->value;
-                current2->key = key;
-                current2->value = value;
-            }
-            current2 = current2->next;
-        }
-        current1 = current1->next;
+    p_dictionary new_dict = copy_records(dict);
+    if (new_dict) {
+        record_comparator_t comparator = {NULL, callback, args};
+        merge_sort_records(new_dict, &comparator);
     }
     return new_dict;
 }
+
+int sort_dictionary_in_place(
+    const p_dictionary dict, dictionary_iteration_callback_sort callback) {
+    if (!dict)
+        return IPEE_ERROR_CODE__DICTIONARY__NOT_EXISTS;
+
+    record_comparator_t comparator = {callback, NULL, NULL};
+    merge_sort_records(dict, &comparator);
+    return 0;
+}
+
+int sort_dictionary_in_place_with_args(
+    const p_dictionary dict, dictionary_iteration_callback_sort_with_args callback, void *args) {
+    if (!dict)
+        return IPEE_ERROR_CODE__DICTIONARY__NOT_EXISTS;
+
+    record_comparator_t comparator = {NULL, callback, args};
+    merge_sort_records(dict, &comparator);
+    return 0;
+}
+
+p_dictionary_query init_dictionary_query(p_dictionary_query query, const p_dictionary dict) {
+    if (!query)
+        return NULL;
+
+    query->dict = dict;
+    query->stages_count = 0;
+    return query;
+}
+
+p_dictionary_query filter_dictionary_query(
+    p_dictionary_query query, dictionary_iteration_callback_filter callback) {
+    p_dictionary_query_stage stage = add_query_stage(query, DICTIONARY_QUERY_STAGE_FILTER);
+    if (!stage)
+        return NULL;
+
+    stage->filter = callback;
+    return query;
+}
+
+p_dictionary_query filter_dictionary_query_with_args(
+    p_dictionary_query query, dictionary_iteration_callback_filter_with_args callback, void *args) {
+    p_dictionary_query_stage stage = add_query_stage(query, DICTIONARY_QUERY_STAGE_FILTER);
+    if (!stage)
+        return NULL;
+
+    stage->filter_with_args = callback;
+    stage->args = args;
+    return query;
+}
+
+p_dictionary_query map_dictionary_query(
+    p_dictionary_query query, dictionary_iteration_callback_map callback) {
+    p_dictionary_query_stage stage = add_query_stage(query, DICTIONARY_QUERY_STAGE_MAP);
+    if (!stage)
+        return NULL;
+
+    stage->map = callback;
+    return query;
+}
+
+p_dictionary_query map_dictionary_query_with_args(
+    p_dictionary_query query, dictionary_iteration_callback_map_with_args callback, void *args) {
+    p_dictionary_query_stage stage = add_query_stage(query, DICTIONARY_QUERY_STAGE_MAP);
+    if (!stage)
+        return NULL;
+
+    stage->map_with_args = callback;
+    stage->args = args;
+    return query;
+}
+
+p_record get_first_record_from_dictionary_query(p_dictionary_query query) {
+    if (!query || !query->dict)
+        return NULL;
+
+    p_record cursor = start_query(query);
+    return pull_query_record(query, &cursor);
+}
+
+int count_dictionary_query(p_dictionary_query query) {
+    if (!query || !query->dict)
+        return IPEE_ERROR_CODE__DICTIONARY__NOT_EXISTS;
+
+    int count = 0;
+    p_record cursor = start_query(query);
+    while (pull_query_record(query, &cursor))
+        count++;
+    return count;
+}
+
+int any_in_dictionary_query(p_dictionary_query query) {
+    return get_first_record_from_dictionary_query(query) != NULL;
+}
+
+void *reduce_dictionary_query(
+    p_dictionary_query query, dictionary_iteration_callback_reduce callback, void *acc) {
+    if (!query || !query->dict)
+        return NULL;
+
+    int index = 0;
+    p_record record = NULL;
+    p_record cursor = start_query(query);
+    while ((record = pull_query_record(query, &cursor)))
+        callback(acc, record, index++, query->dict);
+    return acc;
+}
+
+void *reduce_dictionary_query_with_args(
+    p_dictionary_query query,
+    dictionary_iteration_callback_reduce_with_args callback, void *acc, void *args) {
+    if (!query || !query->dict)
+        return NULL;
+
+    int index = 0;
+    p_record record = NULL;
+    p_record cursor = start_query(query);
+    while ((record = pull_query_record(query, &cursor)))
+        callback(acc, record, index++, query->dict, args);
+    return acc;
+}
+
+p_dictionary collect_dictionary_query(p_dictionary_query query) {
+    if (!query || !query->dict)
+        return NULL;
+
+    p_dictionary new_dict = create_derived_dictionary(query->dict);
+    if (!new_dict)
+        return NULL;
+
+    p_record record = NULL;
+    p_record cursor = start_query(query);
+    while ((record = pull_query_record(query, &cursor)))
+        add_record_to_dictionary_with_metadata(new_dict, record->key, record->value, record->metadata);
+    return new_dict;
+}
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DEFINITIONS
+ **********************************************************************************************/
+
+static int get_dictionary_mode(int mode) {
+    if (mode & DICTIONARY_MODE_INT_KEYS)
+        mode &= ~DICTIONARY_MODE_KEY_TRIE;
+    if (mode & DICTIONARY_MODE_OWNED_KEYS)
+        mode |= DICTIONARY_MODE_KEY_HASH | DICTIONARY_MODE_RECORD_POOL;
+    if (mode & DICTIONARY_MODE_KEY_TRIE)
+        mode |= DICTIONARY_MODE_KEY_INDEX;
+    else if (mode & DICTIONARY_MODE_KEY_INDEX)
+        mode |= DICTIONARY_MODE_KEY_HASH;
+    if (mode & DICTIONARY_MODE_INT_KEYS)
+        mode &= ~(DICTIONARY_MODE_KEY_HASH | DICTIONARY_MODE_OWNED_KEYS);
+    return mode;
+}
+
+static int get_pooled_record_size(int mode) {
+    size_t size = offsetof(pooled_record_t, key_hash);
+    if (mode & DICTIONARY_MODE_VALUE_INDEX)
+        size = sizeof(pooled_record_t);
+    else if (mode & DICTIONARY_MODE_KEY_INDEX)
+        size = offsetof(pooled_record_t, value_chain);
+    else if (mode & DICTIONARY_MODE_POSITION_INDEX)
+        size = offsetof(pooled_record_t, key_chain);
+    else if (mode & DICTIONARY_MODE_OWNED_KEYS)
+        size = offsetof(pooled_record_t, position);
+    else if (mode & DICTIONARY_MODE_KEY_HASH)
+        size = offsetof(pooled_record_t, inline_key);
+    return (int)((size + sizeof(void *) - 1) & ~(sizeof(void *) - 1));
+}
+
+static void set_record_layout(const p_dictionary dict) {
+    if (dict->pool) {
+        dict->record_size = get_pooled_record_size(dict->mode);
+        dict->hash_offset = offsetof(pooled_record_t, key_hash);
+        dict->position_offset = offsetof(pooled_record_t, position);
+        dict->key_chain_offset = offsetof(pooled_record_t, key_chain);
+        dict->value_chain_offset = offsetof(pooled_record_t, value_chain);
+        return;
+    }
+
+    dict->record_size = sizeof(record_t);
+    dict->hash_offset = 0;
+    dict->position_offset = 0;
+    dict->key_chain_offset = 0;
+    dict->value_chain_offset = 0;
+    if (dict->mode & DICTIONARY_MODE_KEY_HASH) {
+        dict->hash_offset = dict->record_size;
+        dict->record_size += sizeof(record_key_hash_t);
+    }
+    if (dict->mode & DICTIONARY_MODE_POSITION_INDEX) {
+        dict->position_offset = dict->record_size;
+        dict->record_size += sizeof(p_record_position);
+    }
+    if (dict->mode & DICTIONARY_MODE_KEY_INDEX) {
+        dict->key_chain_offset = dict->record_size;
+        dict->record_size += sizeof(record_chain_t);
+    }
+    if (dict->mode & DICTIONARY_MODE_VALUE_INDEX) {
+        dict->value_chain_offset = dict->record_size;
+        dict->record_size += sizeof(record_chain_t);
+    }
+}
+
+static inline p_record_key_hash get_record_key_hash(const p_dictionary dict, const p_record record) {
+    return (p_record_key_hash)((char *)record + dict->hash_offset);
+}
+
+static inline p_record_position *get_record_position(const p_dictionary dict, const p_record record) {
+    return (p_record_position *)((char *)record + dict->position_offset);
+}
+
+static p_record create_record(const p_dictionary dict, char *key, void *value, void *metadata) {
+    p_record record = dict->pool
+        ? allocate_pooled_record(dict->pool)
+        : (p_record)malloc(dict->record_size);
+    if (!record)
+        return NULL;
+
+    record->key = key;
+    record->value = value;
+    record->next = NULL;
+    record->prev = NULL;
+    record->metadata = metadata;
+    if (dict->position_index)
+        *get_record_position(dict, record) = NULL;
+    if (dict->mode & DICTIONARY_MODE_KEY_HASH) {
+        p_record_key_hash key_hash = get_record_key_hash(dict, record);
+        key_hash->hash = hash_key(dict, key, &key_hash->length);
+    }
+
+    if (dict->mode & DICTIONARY_MODE_OWNED_KEYS) {
+        record->key = create_record_key(dict->pool, record, key);
+        if (!record->key) {
+            release_record(dict, record);
+            return NULL;
+        }
+    }
+    return record;
+}
+
+static void release_record(const p_dictionary dict, p_record record) {
+    if ((dict->mode & DICTIONARY_MODE_OWNED_KEYS) && record->key)
+        release_record_key(dict->pool, record);
+
+    if (!dict->pool) {
+        free(record);
+        return;
+    }
+
+    // References taken before the release become stale.
+    ((p_pooled_record)record)->generation++;
+    record->next = dict->pool->free_list;
+    dict->pool->free_list = record;
+}
+
+static p_record allocate_pooled_record(p_record_pool pool) {
+    if (pool->free_list) {
+        p_record record = pool->free_list;
+        pool->free_list = record->next;
+        return record;
+    }
+
+    p_record_slab slab = pool->slabs;
+    if (!slab || slab->used == slab->capacity) {
+        int capacity = slab ? slab->capacity * 2 : RECORD_POOL_MIN_SLAB_CAPACITY;
+        if (capacity > RECORD_POOL_MAX_SLAB_CAPACITY)
+            capacity = RECORD_POOL_MAX_SLAB_CAPACITY;
+
+        slab = create_record_slab(pool, capacity);
+        if (!slab)
+            return NULL;
+    }
+
+    p_record record = get_slab_record(pool, slab, slab->used++);
+    ((p_pooled_record)record)->generation = 0;
+    return record;
+}
+
+static p_record_slab create_record_slab(p_record_pool pool, int capacity) {
+    size_t size = sizeof(record_slab_t) + (size_t)capacity * pool->record_size;
+    size = (size + RECORD_POOL_CACHE_LINE_SIZE - 1) & ~(size_t)(RECORD_POOL_CACHE_LINE_SIZE - 1);
+    p_record_slab slab = (p_record_slab)aligned_alloc(RECORD_POOL_CACHE_LINE_SIZE, size);
+    if (!slab)
+        return NULL;
+
+    slab->capacity = capacity;
+    slab->used = 0;
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+    return slab;
+}
+
+static inline p_record get_slab_record(const p_record_pool pool, p_record_slab slab, int index) {
+    return (p_record)(slab->records + (size_t)index * pool->record_size);
+}
+
+static int reserve_pooled_records(p_record_pool pool, int count) {
+    p_record_slab slab = pool->slabs;
+    int available = slab ? slab->capacity - slab->used : 0;
+    if (available >= count)
+        return 0;
+
+    // Free list is consumed first, so the slab remainder is not lost.
+    for (; slab && slab->used < slab->capacity; slab->used++) {
+        p_record record = get_slab_record(pool, slab, slab->used);
+        ((p_pooled_record)record)->generation = 0;
+        record->next = pool->free_list;
+        pool->free_list = record;
+    }
+
+    int capacity = count - available;
+    if (capacity < RECORD_POOL_MIN_SLAB_CAPACITY)
+        capacity = RECORD_POOL_MIN_SLAB_CAPACITY;
+    return create_record_slab(pool, capacity) ? 0 : IPEE_ERROR_CODE__DICTIONARY__RECORD_CREATION_ERROR;
+}
+
+static char *create_record_key(p_record_pool pool, p_record record, const char *key) {
+    p_pooled_record pooled = (p_pooled_record)record;
+    const size_t size = (size_t)pooled->key_hash.length + 1;
+    if (size <= sizeof(pooled->inline_key))
+        return memcpy(pooled->inline_key, key, size);
+
+    const int key_class = get_key_class(pooled->key_hash.length);
+    if (key_class == KEY_CLASSES) {
+        char *owned = malloc(size);
+        return owned ? memcpy(owned, key, size) : NULL;
+    }
+
+    char *block = pool->free_keys[key_class];
+    if (block) {
+        memcpy(&pool->free_keys[key_class], block, sizeof(char *));
+        return memcpy(block, key, size);
+    }
+
+    const size_t class_size = (size_t)KEY_MIN_CLASS_SIZE << key_class;
+    p_key_chunk chunk = pool->key_chunks;
+    if (!chunk || chunk->used + class_size > KEY_CHUNK_SIZE - sizeof(key_chunk_t)) {
+        chunk = (p_key_chunk)malloc(KEY_CHUNK_SIZE);
+        if (!chunk)
+            return NULL;
+
+        chunk->used = 0;
+        chunk->next = pool->key_chunks;
+        pool->key_chunks = chunk;
+    }
+
+    block = chunk->data + chunk->used;
+    chunk->used += class_size;
+    return memcpy(block, key, size);
+}
+
+static void release_record_key(p_record_pool pool, p_record record) {
+    p_pooled_record pooled = (p_pooled_record)record;
+    char *key = record->key;
+    record->key = NULL;
+    if (key == pooled->inline_key)
+        return;
+
+    const int key_class = get_key_class(pooled->key_hash.length);
+    if (key_class == KEY_CLASSES) {
+        free(key);
+        return;
+    }
+
+    // Free block keeps the link to the next one in its first bytes.
+    memcpy(key, &pool->free_keys[key_class], sizeof(char *));
+    pool->free_keys[key_class] = key;
+}
+
+static int get_key_class(uint32_t length) {
+    int key_class = 0;
+    while (key_class < KEY_CLASSES && ((size_t)KEY_MIN_CLASS_SIZE << key_class) < (size_t)length + 1)
+        key_class++;
+    return key_class;
+}
+
+static int link_record(const p_dictionary dict, p_record record, p_record next) {
+    record->next = next;
+    record->prev = next ? next->prev : dict->tail;
+
+    if (record->prev)
+        record->prev->next = record;
+    else
+        dict->head = record;
+
+    if (next)
+        next->prev = record;
+    else
+        dict->tail = record;
+    dict->size++;
+
+    // Indexes are filled one by one, a failed one rolls back the previous ones.
+    int result = dict->position_index ? index_record_position(dict, record) : 0;
+    if (!result && dict->key_index) {
+        result = index_record(dict, dict->key_index, record);
+        if (result && dict->position_index)
+            unindex_record_position(dict, record);
+    }
+    if (!result && dict->value_index) {
+        result = index_record(dict, dict->value_index, record);
+        if (result && dict->key_index)
+            unindex_record(dict->key_index, record, record->key);
+        if (result && dict->position_index)
+            unindex_record_position(dict, record);
+    }
+    if (!result)
+        return 0;
+
+    if (record->prev)
+        record->prev->next = record->next;
+    else
+        dict->head = record->next;
+
+    if (record->next)
+        record->next->prev = record->prev;
+    else
+        dict->tail = record->prev;
+    dict->size--;
+    return result;
+}
+
+static void unlink_record(const p_dictionary dict, p_record record) {
+    if (dict->key_index)
+        unindex_record(dict->key_index, record, record->key);
+    if (dict->value_index)
+        unindex_record(dict->value_index, record, record->value);
+    if (dict->position_index)
+        unindex_record_position(dict, record);
+
+    if (record->prev)
+        record->prev->next = record->next;
+    else
+        dict->head = record->next;
+
+    if (record->next)
+        record->next->prev = record->prev;
+    else
+        dict->tail = record->prev;
+
+    record->next = NULL;
+    record->prev = NULL;
+    dict->size--;
+}
+
+static void *set_record_value(const p_dictionary dict, p_record record, void *value) {
+    void *old_value = record->value;
+    if (!dict->value_index || value == old_value) {
+        record->value = value;
+        return old_value;
+    }
+
+    // Index the new value first, so a failed allocation leaves the old state intact.
+    p_record_chain chain = get_record_chain(dict->value_index, record);
+    const record_chain_t old_chain = *chain;
+    record->value = value;
+    if (index_record(dict, dict->value_index, record)) {
+        record->value = old_value;
+        return NULL;
+    }
+
+    // Links of the old value are needed once more to unchain the record from it.
+    const record_chain_t new_chain = *chain;
+    *chain = old_chain;
+    unindex_record(dict->value_index, record, old_value);
+    *chain = new_chain;
+    return old_value;
+}
+
+static p_dictionary create_derived_dictionary(const p_dictionary dict) {
+    return create_dictionary_with_mode(dict->mode & DICTIONARY_MODE_INT_KEYS, NULL);
+}
+
+static p_dictionary copy_records(const p_dictionary dict) {
+    p_dictionary new_dict = create_derived_dictionary(dict);
+    if (!new_dict)
+        return NULL;
+
+    p_record current = dict->head;
+    while (current) {
+        if (add_record_to_dictionary_with_metadata(
+                new_dict, current->key, current->value, current->metadata)) {
+            delete_dictionary(new_dict);
+            return NULL;
+        }
+        current = current->next;
+    }
+    return new_dict;
+}
+
+static inline int compare_records(
+    const p_record_comparator comparator, const p_record record1, const p_record record2) {
+    if (comparator->callback)
+        return comparator->callback(record1, record2);
+    return comparator->callback_with_args(record1, record2, comparator->args);
+}
+
+static void merge_sort_records(const p_dictionary dict, const p_record_comparator comparator) {
+    if (dict->size < 2)
+        return;
+
+    p_record list = dict->head;
+    p_record tail = NULL;
+    int run_size = 1;
+
+    while (1) {
+        p_record left = list;
+        int merges = 0;
+        list = NULL;
+        tail = NULL;
+
+        while (left) {
+            merges++;
+
+            p_record right = left;
+            int left_size = 0;
+            for (int i = 0; i < run_size && right; i++) {
+                left_size++;
+                right = right->next;
+            }
+            int right_size = run_size;
+
+            // Take from the right run only if it strictly precedes, so equal records keep order.
+            while (left_size || (right_size && right)) {
+                p_record record = NULL;
+                if (!left_size) {
+                    record = right;
+                    right = right->next;
+                    right_size--;
+                } else if (!right_size || !right || !compare_records(comparator, left, right)) {
+                    record = left;
+                    left = left->next;
+                    left_size--;
+                } else {
+                    record = right;
+                    right = right->next;
+                    right_size--;
+                }
+
+                if (tail)
+                    tail->next = record;
+                else
+                    list = record;
+                record->prev = tail;
+                tail = record;
+            }
+            left = right;
+        }
+        tail->next = NULL;
+
+        if (merges <= 1)
+            break;
+        run_size *= 2;
+    }
+
+    dict->head = list;
+    dict->tail = tail;
+
+    // Shape of the position tree is independent of records, so records are just redistributed in order.
+    if (dict->position_index) {
+        p_record current = dict->head;
+        p_record_position node = dict->position_index->root;
+        while (node->left)
+            node = node->left;
+
+        while (node) {
+            node->record = current;
+            *get_record_position(dict, current) = node;
+            current = current->next;
+
+            if (node->right) {
+                node = node->right;
+                while (node->left)
+                    node = node->left;
+            } else {
+                while (node->parent && node->parent->right == node)
+                    node = node->parent;
+                node = node->parent;
+            }
+        }
+    }
+
+    // Records with equal fields may have been reordered.
+    if (dict->key_index)
+        rechain_records(dict, dict->key_index);
+    if (dict->value_index)
+        rechain_records(dict, dict->value_index);
+}
+
+static p_dictionary_query_stage add_query_stage(
+    p_dictionary_query query, dictionary_query_stage_type_t type) {
+    if (!query || query->stages_count >= DICTIONARY_QUERY_MAX_STAGES)
+        return NULL;
+
+    p_dictionary_query_stage stage = &query->stages[query->stages_count++];
+    stage->type = type;
+    stage->filter = NULL;
+    stage->filter_with_args = NULL;
+    stage->map = NULL;
+    stage->map_with_args = NULL;
+    stage->args = NULL;
+    stage->index = 0;
+    return stage;
+}
+
+static p_record start_query(p_dictionary_query query) {
+    for (int i = 0; i < query->stages_count; i++)
+        query->stages[i].index = 0;
+    return query->dict->head;
+}
+
+static p_record pull_query_record(p_dictionary_query query, p_record *cursor) {
+    while (*cursor) {
+        p_record record = *cursor;
+        *cursor = record->next;
+
+        for (int i = 0; record && i < query->stages_count; i++) {
+            p_dictionary_query_stage stage = &query->stages[i];
+            int index = stage->index++;
+
+            switch (stage->type) {
+            case DICTIONARY_QUERY_STAGE_FILTER:
+                if (stage->filter
+                        ? !stage->filter(record, index, query->dict)
+                        : !stage->filter_with_args(record, index, query->dict, stage->args))
+                    record = NULL;
+                break;
+
+            case DICTIONARY_QUERY_STAGE_MAP:
+                record = stage->map
+                    ? stage->map(record, index, query->dict)
+                    : stage->map_with_args(record, index, query->dict, stage->args);
+                break;
+
+            default:
+                break;
+            }
+        }
+
+        if (record)
+            return record;
+    }
+    return NULL;
+}
+
+static p_dictionary_index create_dictionary_index(
+    dictionary_index_field_t field, int hash_offset, int chain_offset) {
+    p_dictionary_index index = (p_dictionary_index)malloc(sizeof(dictionary_index_t));
+    if (!index)
+        return NULL;
+
+    index->capacity = DICTIONARY_INDEX_DEFAULT_CAPACITY;
+    index->count = 0;
+    index->field = field;
+    index->trie = NULL;
+    index->hash_offset = hash_offset;
+    index->chain_offset = chain_offset;
+    if (field == DICTIONARY_INDEX_FIELD_TRIE_KEY) {
+        index->buckets = NULL;
+        index->trie = create_trie_node("", 0);
+        if (!index->trie) {
+            free(index);
+            return NULL;
+        }
+        return index;
+    }
+
+    index->buckets = calloc(index->capacity, sizeof(p_dictionary_index_entry));
+    if (!index->buckets) {
+        free(index);
+        return NULL;
+    }
+    return index;
+}
+
+static void delete_dictionary_index(p_dictionary_index index) {
+    if (!index)
+        return;
+
+    if (index->trie) {
+        delete_trie_node(index->trie);
+        free(index);
+        return;
+    }
+
+    for (int i = 0; i < index->capacity; i++) {
+        p_dictionary_index_entry entry = index->buckets[i];
+        while (entry) {
+            p_dictionary_index_entry next = entry->next;
+            free(entry);
+            entry = next;
+        }
+    }
+    free(index->buckets);
+    free(index);
+}
+
+static p_dictionary_index_entry find_index_entry(
+    const p_dictionary_index index, const void *field, uint32_t hash) {
+    if (index->trie) {
+        p_dictionary_trie_node node = find_trie_node(index->trie, field, 0);
+        return node && node->entry.count ? &node->entry : NULL;
+    }
+
+    p_dictionary_index_entry entry = index->buckets[hash & (index->capacity - 1)];
+    while (entry) {
+        if (entry->hash == hash && match_field(index, entry->field, field))
+            return entry;
+        entry = entry->next;
+    }
+    return NULL;
+}
+
+static int index_record(const p_dictionary dict, p_dictionary_index index, p_record record) {
+    const void *field = get_record_field(index, record);
+    uint32_t hash = hash_field(index, record, field);
+
+    p_dictionary_index_entry entry = find_index_entry(index, field, hash);
+    if (entry) {
+        chain_record(dict, index, entry, record);
+        entry->count++;
+        return 0;
+    }
+
+    p_record_chain chain = get_record_chain(index, record);
+    if (index->trie) {
+        entry = insert_trie_entry(index->trie, field);
+        if (!entry)
+            return IPEE_ERROR_CODE__DICTIONARY__RECORD_CREATION_ERROR;
+
+        entry->field = field;
+        entry->first = record;
+        entry->last = record;
+        entry->count = 1;
+        chain->next = NULL;
+        chain->prev = NULL;
+        index->count++;
+        return 0;
+    }
+
+    if (index->count + 1 > DICTIONARY_INDEX_MAX_LOAD * index->capacity)
+        resize_dictionary_index(index, index->capacity * DICTIONARY_INDEX_RESIZE_FACTOR);
+
+    entry = (p_dictionary_index_entry)malloc(sizeof(dictionary_index_entry_t));
+    if (!entry)
+        return IPEE_ERROR_CODE__DICTIONARY__RECORD_CREATION_ERROR;
+
+    int bucket = hash & (index->capacity - 1);
+    entry->hash = hash;
+    entry->field = field;
+    entry->first = record;
+    entry->last = record;
+    entry->count = 1;
+    entry->next = index->buckets[bucket];
+    index->buckets[bucket] = entry;
+    chain->next = NULL;
+    chain->prev = NULL;
+    index->count++;
+    return 0;
+}
+
+static void chain_record(
+    const p_dictionary dict, p_dictionary_index index, p_dictionary_index_entry entry, p_record record) {
+    const void *field = get_record_field(index, record);
+
+    // Duplicate the record is chained after, NULL if it becomes the first one.
+    p_record previous = NULL;
+    if (!record->next) {
+        previous = entry->last;
+    } else if (!record->prev) {
+        previous = NULL;
+    } else if (dict->position_index) {
+        const int rank = rank_record_position(*get_record_position(dict, record), NULL);
+        previous = entry->last;
+        while (previous && rank_record_position(*get_record_position(dict, previous), NULL) > rank)
+            previous = get_record_chain(index, previous)->prev;
+    } else {
+        p_record before = record->prev;
+        p_record after = record->next;
+        while (1) {
+            if (!before || match_field(index, get_record_field(index, before), field)) {
+                previous = before;
+                break;
+            }
+            if (!after) {
+                previous = entry->last;
+                break;
+            }
+            if (match_field(index, get_record_field(index, after), field)) {
+                previous = get_record_chain(index, after)->prev;
+                break;
+            }
+            before = before->prev;
+            after = after->next;
+        }
+    }
+
+    p_record_chain chain = get_record_chain(index, record);
+    chain->prev = previous;
+    chain->next = previous ? get_record_chain(index, previous)->next : entry->first;
+    if (chain->prev) {
+        get_record_chain(index, chain->prev)->next = record;
+    } else {
+        entry->first = record;
+        entry->field = field;
+    }
+    if (chain->next)
+        get_record_chain(index, chain->next)->prev = record;
+    else
+        entry->last = record;
+}
+
+static void unindex_record(p_dictionary_index index, p_record record, const void *field) {
+    if (index->trie) {
+        p_dictionary_index_entry entry = find_index_entry(index, field, 0);
+        if (!entry)
+            return;
+
+        if (--entry->count == 0) {
+            remove_trie_entry(index->trie, field);
+            index->count--;
+        } else {
+            unchain_record(index, entry, record);
+        }
+        return;
+    }
+
+    uint32_t hash = hash_field(index, record, field);
+
+    p_dictionary_index_entry *link = &index->buckets[hash & (index->capacity - 1)];
+    while (*link) {
+        p_dictionary_index_entry entry = *link;
+        if (entry->hash == hash && match_field(index, entry->field, field)) {
+            if (--entry->count == 0) {
+                *link = entry->next;
+                free(entry);
+                index->count--;
+                return;
+            }
+            unchain_record(index, entry, record);
+            return;
+        }
+        link = &entry->next;
+    }
+}
+
+static void unchain_record(p_dictionary_index index, p_dictionary_index_entry entry, p_record record) {
+    p_record_chain chain = get_record_chain(index, record);
+    if (chain->prev) {
+        get_record_chain(index, chain->prev)->next = chain->next;
+    } else {
+        entry->first = chain->next;
+        entry->field = get_record_field(index, chain->next);
+    }
+    if (chain->next)
+        get_record_chain(index, chain->next)->prev = chain->prev;
+    else
+        entry->last = chain->prev;
+}
+
+static void rechain_records(const p_dictionary dict, p_dictionary_index index) {
+    for (p_record current = dict->head; current; current = current->next) {
+        const void *field = get_record_field(index, current);
+        find_index_entry(index, field, hash_field(index, current, field))->first = NULL;
+    }
+
+    for (p_record current = dict->head; current; current = current->next) {
+        const void *field = get_record_field(index, current);
+        p_dictionary_index_entry entry = find_index_entry(index, field, hash_field(index, current, field));
+        p_record_chain chain = get_record_chain(index, current);
+        chain->next = NULL;
+        chain->prev = entry->first ? entry->last : NULL;
+        if (chain->prev) {
+            get_record_chain(index, chain->prev)->next = current;
+        } else {
+            entry->first = current;
+            entry->field = field;
+        }
+        entry->last = current;
+    }
+}
+
+static int resize_dictionary_index(p_dictionary_index index, int capacity) {
+    p_dictionary_index_entry *buckets = calloc(capacity, sizeof(p_dictionary_index_entry));
+    if (!buckets)
+        return IPEE_ERROR_CODE__DICTIONARY__RECORD_CREATION_ERROR;
+
+    for (int i = 0; i < index->capacity; i++) {
+        p_dictionary_index_entry entry = index->buckets[i];
+        while (entry) {
+            p_dictionary_index_entry next = entry->next;
+            int bucket = entry->hash & (capacity - 1);
+            entry->next = buckets[bucket];
+            buckets[bucket] = entry;
+            entry = next;
+        }
+    }
+
+    free(index->buckets);
+    index->buckets = buckets;
+    index->capacity = capacity;
+    return 0;
+}
+
+static void reserve_dictionary_index(p_dictionary_index index, int count) {
+    if (index->trie)
+        return;
+
+    int capacity = index->capacity;
+    while (index->count + count > DICTIONARY_INDEX_MAX_LOAD * capacity)
+        capacity *= DICTIONARY_INDEX_RESIZE_FACTOR;
+    if (capacity != index->capacity)
+        resize_dictionary_index(index, capacity);
+}
+
+static p_dictionary_trie_node create_trie_node(const char *label, uint32_t length) {
+    p_dictionary_trie_node node = (p_dictionary_trie_node)malloc(sizeof(dictionary_trie_node_t) + length);
+    if (!node)
+        return NULL;
+
+    memset(&node->entry, 0, sizeof(node->entry));
+    node->child = NULL;
+    node->sibling = NULL;
+    node->length = length;
+    if (label)
+        memcpy(node->label, label, length);
+    return node;
+}
+
+static void delete_trie_node(p_dictionary_trie_node node) {
+    while (node) {
+        p_dictionary_trie_node sibling = node->sibling;
+        delete_trie_node(node->child);
+        free(node);
+        node = sibling;
+    }
+}
+
+static p_dictionary_trie_node *find_trie_link(p_dictionary_trie_node node, char byte) {
+    p_dictionary_trie_node *link = &node->child;
+    while (*link && (unsigned char)(*link)->label[0] < (unsigned char)byte)
+        link = &(*link)->sibling;
+    return link;
+}
+
+static p_dictionary_trie_node find_trie_node(p_dictionary_trie_node root, const char *key, int prefix) {
+    p_dictionary_trie_node node = root;
+    while (*key) {
+        p_dictionary_trie_node child = *find_trie_link(node, *key);
+        if (!child || child->label[0] != *key)
+            return NULL;
+
+        uint32_t common = 1;
+        while (common < child->length && key[common] == child->label[common])
+            common++;
+        if (common < child->length)
+            return prefix && !key[common] ? child : NULL;
+
+        key += common;
+        node = child;
+    }
+    return node;
+}
+
+static p_dictionary_index_entry insert_trie_entry(p_dictionary_trie_node root, const char *key) {
+    p_dictionary_trie_node node = root;
+    while (*key) {
+        p_dictionary_trie_node *link = find_trie_link(node, *key);
+        p_dictionary_trie_node child = *link;
+        if (!child || child->label[0] != *key) {
+            p_dictionary_trie_node leaf = create_trie_node(key, strlen(key));
+            if (!leaf)
+                return NULL;
+
+            leaf->sibling = child;
+            *link = leaf;
+            return &leaf->entry;
+        }
+
+        uint32_t common = 1;
+        while (common < child->length && key[common] == child->label[common])
+            common++;
+
+        // Key diverges inside the label, the shared part becomes a node of its own.
+        if (common < child->length) {
+            p_dictionary_trie_node middle = create_trie_node(child->label, common);
+            if (!middle)
+                return NULL;
+
+            child->length -= common;
+            memmove(child->label, child->label + common, child->length);
+            middle->sibling = child->sibling;
+            middle->child = child;
+            child->sibling = NULL;
+            *link = middle;
+            child = middle;
+        }
+
+        key += common;
+        node = child;
+    }
+    return &node->entry;
+}
+
+static void remove_trie_entry(p_dictionary_trie_node root, const char *key) {
+    p_dictionary_trie_node node = root;
+    p_dictionary_trie_node *link = NULL;
+    p_dictionary_trie_node *parent_link = NULL;
+    while (*key) {
+        p_dictionary_trie_node *child_link = find_trie_link(node, *key);
+        if (!*child_link)
+            return;
+
+        key += (*child_link)->length;
+        parent_link = link;
+        link = child_link;
+        node = *child_link;
+    }
+
+    if (!link)
+        return;
+    compact_trie_node(link);
+    if (parent_link)
+        compact_trie_node(parent_link);
+}
+
+static void compact_trie_node(p_dictionary_trie_node *link) {
+    p_dictionary_trie_node node = *link;
+    if (node->entry.count)
+        return;
+
+    if (!node->child) {
+        *link = node->sibling;
+        free(node);
+        return;
+    }
+    if (node->child->sibling)
+        return;
+
+    // Merging is an optimisation, the trie stays valid if it cannot be allocated.
+    p_dictionary_trie_node child = node->child;
+    p_dictionary_trie_node merged = create_trie_node(NULL, node->length + child->length);
+    if (!merged)
+        return;
+
+    memcpy(merged->label, node->label, node->length);
+    memcpy(merged->label + node->length, child->label, child->length);
+    merged->entry = child->entry;
+    merged->child = child->child;
+    merged->sibling = node->sibling;
+    *link = merged;
+    free(child);
+    free(node);
+}
+
+static int visit_trie_records(const p_dictionary_index index, p_dictionary_trie_node node,
+    dictionary_iteration_callback_with_args callback, void *args) {
+    int count = 0;
+    if (node->entry.count) {
+        for (p_record record = node->entry.first; record; record = get_record_chain(index, record)->next) {
+            callback(record->key, record->value, args);
+            count++;
+        }
+    }
+
+    for (p_dictionary_trie_node child = node->child; child; child = child->sibling)
+        count += visit_trie_records(index, child, callback, args);
+    return count;
+}
+
+static inline p_record_chain get_record_chain(const p_dictionary_index index, const p_record record) {
+    return (p_record_chain)((char *)record + index->chain_offset);
+}
+
+static inline const void *get_record_field(const p_dictionary_index index, const p_record record) {
+    return index->field == DICTIONARY_INDEX_FIELD_VALUE ? record->value : (const void *)record->key;
+}
+
+static inline uint32_t hash_field(const p_dictionary_index index, const p_record record, const void *field) {
+    if (index->field == DICTIONARY_INDEX_FIELD_KEY)
+        return ((p_record_key_hash)((char *)record + index->hash_offset))->hash;
+    return index->field == DICTIONARY_INDEX_FIELD_TRIE_KEY ? 0 : hash_pointer(field);
+}
+
+static inline int match_field(const p_dictionary_index index, const void *field1, const void *field2) {
+    if (index->field == DICTIONARY_INDEX_FIELD_KEY || index->field == DICTIONARY_INDEX_FIELD_TRIE_KEY)
+        return strcmp(field1, field2) == 0;
+    return field1 == field2;
+}
+
+static inline uint32_t hash_pointer(const void *value) {
+    // Fibonacci hashing spreads aligned pointers over all bits.
+    uint64_t hash = (uint64_t)(uintptr_t)value * 11400714819323198485ull;
+    return (uint32_t)(hash >> 32);
+}
+
+static inline p_record find_record(
+    const p_dictionary dict, p_record record, const char *key, uint32_t hash, uint32_t length) {
+    while (record && !match_record_key(dict, record, key, hash, length))
+        record = record->next;
+    return record;
+}
+
+static inline uint32_t hash_key(const p_dictionary dict, const char *key, uint32_t *length) {
+    *length = 0;
+    if (dict->mode & DICTIONARY_MODE_INT_KEYS)
+        return hash_pointer(key);
+    if (!(dict->mode & DICTIONARY_MODE_KEY_HASH))
+        return 0;
+
+    *length = strlen(key);
+    return hash_data(key, *length);
+}
+
+static inline int match_record_key(
+    const p_dictionary dict, const p_record record, const char *key, uint32_t hash, uint32_t length) {
+    if (dict->mode & DICTIONARY_MODE_INT_KEYS)
+        return record->key == key;
+    if (!(dict->mode & DICTIONARY_MODE_KEY_HASH))
+        return strcmp(record->key, key) == 0;
+    const p_record_key_hash key_hash = get_record_key_hash(dict, record);
+    return key_hash->hash == hash && key_hash->length == length && memcmp(record->key, key, length) == 0;
+}
+
+static p_dictionary_position_index create_position_index(void) {
+    p_dictionary_position_index index =
+        (p_dictionary_position_index)malloc(sizeof(dictionary_position_index_t));
+    if (!index)
+        return NULL;
+
+    index->root = NULL;
+    index->seed = POSITION_INDEX_SEED;
+    return index;
+}
+
+static void delete_position_index(p_dictionary_position_index index) {
+    if (!index)
+        return;
+
+    // Release nodes without recursion by rotating left subtrees into the right spine.
+    p_record_position node = index->root;
+    while (node) {
+        if (node->left) {
+            p_record_position left = node->left;
+            node->left = left->right;
+            left->right = node;
+            node = left;
+        } else {
+            p_record_position right = node->right;
+            free(node);
+            node = right;
+        }
+    }
+    free(index);
+}
+
+static int index_record_position(const p_dictionary dict, p_record record) {
+    p_dictionary_position_index index = dict->position_index;
+    p_record_position node = (p_record_position)malloc(sizeof(record_position_t));
+    if (!node)
+        return IPEE_ERROR_CODE__DICTIONARY__RECORD_CREATION_ERROR;
+
+    index->seed ^= index->seed << 13;
+    index->seed ^= index->seed >> 17;
+    index->seed ^= index->seed << 5;
+
+    node->left = NULL;
+    node->right = NULL;
+    node->parent = NULL;
+    node->record = record;
+    node->priority = index->seed;
+    node->size = 1;
+    *get_record_position(dict, record) = node;
+
+    // Record is already linked, so its position is defined by the following record.
+    int position = record->next
+        ? rank_record_position(*get_record_position(dict, record->next), NULL)
+        : position_size(index->root);
+
+    p_record_position left = NULL;
+    p_record_position right = NULL;
+    split_positions(index->root, position, &left, &right);
+    index->root = merge_positions(merge_positions(left, node), right);
+    index->root->parent = NULL;
+    return 0;
+}
+
+static void unindex_record_position(const p_dictionary dict, p_record record) {
+    p_dictionary_position_index index = dict->position_index;
+    p_record_position node = *get_record_position(dict, record);
+    p_record_position parent = node->parent;
+    p_record_position child = merge_positions(node->left, node->right);
+
+    if (child)
+        child->parent = parent;
+    if (!parent)
+        index->root = child;
+    else if (parent->left == node)
+        parent->left = child;
+    else
+        parent->right = child;
+
+    for (; parent; parent = parent->parent)
+        parent->size--;
+
+    *get_record_position(dict, record) = NULL;
+    free(node);
+}
+
+static p_record select_record_position(const p_dictionary_position_index index, int position) {
+    p_record_position node = index->root;
+    while (node) {
+        int left_size = position_size(node->left);
+        if (position < left_size) {
+            node = node->left;
+        } else if (position > left_size) {
+            position -= left_size + 1;
+            node = node->right;
+        } else {
+            return node->record;
+        }
+    }
+    return NULL;
+}
+
+static int rank_record_position(p_record_position node, p_record_position *root) {
+    int position = position_size(node->left);
+    while (node->parent) {
+        if (node->parent->right == node)
+            position += position_size(node->parent->left) + 1;
+        node = node->parent;
+    }
+
+    if (root)
+        *root = node;
+    return position;
+}
+
+static void split_positions(
+    p_record_position node, int count, p_record_position *left, p_record_position *right) {
+    if (!node) {
+        *left = NULL;
+        *right = NULL;
+        return;
+    }
+
+    int left_size = position_size(node->left);
+    if (left_size < count) {
+        split_positions(node->right, count - left_size - 1, &node->right, right);
+        update_position(node);
+        *left = node;
+    } else {
+        split_positions(node->left, count, left, &node->left);
+        update_position(node);
+        *right = node;
+    }
+}
+
+static p_record_position merge_positions(p_record_position left, p_record_position right) {
+    if (!left)
+        return right;
+    if (!right)
+        return left;
+
+    if (left->priority > right->priority) {
+        left->right = merge_positions(left->right, right);
+        update_position(left);
+        return left;
+    }
+
+    right->left = merge_positions(left, right->left);
+    update_position(right);
+    return right;
+}
+
+static inline void update_position(p_record_position node) {
+    node->size = 1 + position_size(node->left) + position_size(node->right);
+    if (node->left)
+        node->left->parent = node;
+    if (node->right)
+        node->right->parent = node;
+}
+
+static inline int position_size(const p_record_position node) {
+    return node ? node->size : 0;
+}
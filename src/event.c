@@ -8,10 +8,34 @@
 #include <dictionary.h>
 #include <macro.h>
 
+/*********************************************************************************************
+ * MACROS DECLARATIONS
+ ********************************************************************************************/
+
+#define EVENT_KEY_BUFFER_SIZE 128 // Subscriber keys formatted without allocation.
+
 /***********************************************************************************************
  * STATIC FUNCTIONS DECLARATIONS
  **********************************************************************************************/
 
+/**
+ * @brief Initialize events dictionary.
+ *
+ * @details
+ * Create events dictionary and record pool shared by all event dictionaries.
+ *
+ * @return Events dictionary.
+ */
+static p_dictionary init_events(void);
+
+/**
+ * @brief Release events dictionary.
+ *
+ * @details
+ * Delete empty events dictionary and release shared record pool.
+ */
+static void release_events(void);
+
 /**
  * @brief Initialize event context.
  *
@@ -35,17 +59,6 @@ static p_dictionary init_event_context(const char *context);
  */
 static p_dictionary init_event(p_dictionary event_context, const char *name);
 
-/**
- * @brief Callback invoker.
- *
- * @details
- * Invokes callback function.
- *
- * @param record Callback.
- * @param args Arguments.
- */
-static void callback_invoker(p_record record, void *args);
-
 /**
  * @brief Get number length.
  *
@@ -69,6 +82,15 @@ static int get_number_length(int number);
  */
 static p_dictionary events = NULL;
 
+/**
+ * @brief Event records pool.
+ *
+ * @details
+ * Records of contexts, events and subscribers are recycled through this
+ * pool, so subscribe/unsubscribe churn does not hit the heap allocator.
+ */
+static p_record_pool event_records = NULL;
+
 /*********************************************************************************************
  * FUNCTIONS DEFINITIONS
  ********************************************************************************************/
@@ -112,7 +134,7 @@ void subscribe_with_args(
     const char *context_name, const char *event_name,
     observable_callback_with_args callback, void *args) {
     if (!events)
-        events = create_dictionary();
+        init_events();
 
     p_dictionary context = (p_dictionary)get_value_from_dictionary(events, context_name);
     if (!context)
@@ -122,10 +144,18 @@ void subscribe_with_args(
     if (!event)
         event = init_event(context, event_name);
 
+    // Subscribers dictionary owns its keys, so a short name is only formatted on the stack.
     int sub_id = (int)(intptr_t)event->metadata;
     event->metadata = (void *)(intptr_t)(sub_id + 1);
-    char *key = prepare_event_name(context_name, event_name, sub_id);
+    char buffer[EVENT_KEY_BUFFER_SIZE];
+    const int length = format_event_name(buffer, sizeof(buffer), context_name, event_name, sub_id);
+    char *key = length >= 0 && length < (int)sizeof(buffer) ? buffer : prepare_event_name(context_name, event_name, sub_id);
+    if (!key)
+        return;
+
     add_record_to_dictionary_with_metadata(event, key, callback, args);
+    if (key != buffer)
+        free(key);
 }
 
 int global_unsubscribe(const char *event_name, observable_callback callback) {
@@ -148,9 +178,7 @@ int unsubscribe(const char *context_name, const char *event_name, observable_cal
     if (!record)
         return IPEE_ERROR_CODE__EVENT__INVALID_CALLBACK;
 
-    char *key = record->key;
-    remove_record_from_dictionary(event, record->key);
-    free(key);
+    remove_record_from_dictionary_by_ref(event, get_record_ref(event, record));
 
     if (!event->size) {
         remove_record_from_dictionary(context, event_name);
@@ -162,33 +190,25 @@ int unsubscribe(const char *context_name, const char *event_name, observable_cal
         delete_dictionary(context);
     }
 
-    if (!events->size) {
-        delete_dictionary(events);
-        events = NULL;
-    }
+    if (!events->size)
+        release_events();
 
     return 0;
 }
 
 int unsubscribe_from_event(const char *context, const char *event_name) {
     p_dictionary subscribers = get_context_event_subscribers(context, event_name);
-    p_record current = subscribers ? subscribers->head : NULL;
-    while (current) {
-        p_record next = current->next;
-        unsubscribe(context, event_name, current->value);
-        current = next;
-    }
+    for (dictionary_cursor_t cursor = begin_dictionary_cursor(subscribers);
+         !is_dictionary_cursor_done(&cursor); next_dictionary_cursor(&cursor))
+        unsubscribe(context, event_name, cursor.record->value);
     return 0;
 }
 
 int unsubscribe_from_context(const char *context) {
     p_dictionary context_events = get_context_events(context);
-    p_record current = context_events ? context_events->head : NULL;
-    while (current) {
-        p_record next = current->next;
-        unsubscribe_from_event(context, current->key);
-        current = next;
-    }
+    for (dictionary_cursor_t cursor = begin_dictionary_cursor(context_events);
+         !is_dictionary_cursor_done(&cursor); next_dictionary_cursor(&cursor))
+        unsubscribe_from_event(context, cursor.record->key);
     return 0;
 }
 
@@ -208,33 +228,61 @@ int notify(const char *context_name, const char *event_name, void *args) {
     if (!event)
         return IPEE_ERROR_CODE__EVENT__NOT_EXISTS;
 
-    iterate_over_dictionary_records_with_args(event, callback_invoker, args);
+    for (dictionary_cursor_t cursor = begin_dictionary_cursor(event);
+         !is_dictionary_cursor_done(&cursor); next_dictionary_cursor(&cursor)) {
+        observable_callback_with_args callback = cursor.record->value;
+        callback(args, cursor.record->metadata);
+    }
     return 0;
 }
 
 char *prepare_event_name(const char *context, const char *event, const int id) {
-    const int id_length = get_number_length(id);
+    const size_t size = strlen(context) + 1 + strlen(event) + 1 + get_number_length(id) + 1;
 
-    char *event_name = malloc(strlen(context) + 1 + strlen(event) + 1 + id_length + 1);
+    char *event_name = malloc(size);
     if (!event_name)
         return NULL;
 
-    sprintf(event_name, "%s_%s_%d", context, event, id);
+    format_event_name(event_name, size, context, event, id);
 
     return event_name;
 }
 
+int format_event_name(char *buffer, size_t size, const char *context, const char *event, const int id) {
+    return snprintf(buffer, size, "%s_%s_%d", context, event, id);
+}
+
 /***********************************************************************************************
  * STATIC FUNCTIONS DEFINITIONS
  **********************************************************************************************/
 
+static p_dictionary init_events(void) {
+    if (events)
+        return events;
+
+    // Subscribers own their keys, are indexed by value and join the pool after it is in use.
+    event_records = create_record_pool_with_mode(DICTIONARY_MODE_OWNED_KEYS | DICTIONARY_MODE_VALUE_INDEX);
+    // Context and event names share prefixes, so they are indexed by a trie.
+    events = create_dictionary_with_pool(DICTIONARY_MODE_KEY_TRIE, event_records, NULL);
+
+    return events;
+}
+
+static void release_events(void) {
+    delete_dictionary(events);
+    events = NULL;
+    delete_record_pool(event_records);
+    event_records = NULL;
+}
+
 static p_dictionary init_event_context(const char *context) {
     if (!events)
-        events = create_dictionary();
+        init_events();
     else if (contains_key_in_dictionary(events, context))
         return get_value_from_dictionary(events, context);
 
-    p_dictionary event_context = create_dictionary();
+    p_dictionary event_context = create_dictionary_with_pool(
+        DICTIONARY_MODE_KEY_TRIE, event_records, NULL);
     add_record_to_dictionary(events, context, event_context);
 
     return event_context;
@@ -244,17 +292,14 @@ static p_dictionary init_event(p_dictionary event_context, const char *name) {
     if (!event_context)
         return NULL;
 
-    p_dictionary event = create_dictionary();
+    // Subscribers are looked up by callback on unsubscribe and removed by reference.
+    p_dictionary event = create_dictionary_with_pool(
+        DICTIONARY_MODE_VALUE_INDEX | DICTIONARY_MODE_OWNED_KEYS, event_records, NULL);
     add_record_to_dictionary(event_context, name, event);
 
     return event;
 }
 
-static void callback_invoker(p_record record, void *args) {
-    observable_callback_with_args callback = record->value;
-    callback(args, record->metadata);
-}
-
 static int get_number_length(int number) {
     int length = 1;
     while (number > 9)
@@ -3,21 +3,29 @@
  ********************************************************************************************/
 
 #include <hashmap.h>
+#include <hash.h>
 
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include <macro.h>
 
 /*********************************************************************************************
  * MACROS DECLARATIONS
  ********************************************************************************************/
 
-#define HASHMAP_DEFAULT_CAPACITY 20
+#define HASHMAP_DEFAULT_CAPACITY 32
 #define HASHMAP_MAX_LOAD 0.75f
 #define HASHMAP_RESIZE_FACTOR 2
 
-#define HASHMAP_HASH_INIT 2166136261u
+#define HASHMAP_GROUP_WIDTH 16
+#define HASHMAP_CONTROL_EMPTY 0x80
+#define HASHMAP_FIBONACCI_MULTIPLIER 2654435769u
+#define HASHMAP_TAG_MASK 0x7F
 
 /*********************************************************************************************
  * STRUCTS DECLARATIONS
@@ -25,65 +33,307 @@
 
 typedef struct bucket_s {
     struct bucket_s *next;  // Next backet reference.
+    struct bucket_s *prev;  // Previous backet reference.
     p_key key;              // Bucket entry key.
     size_t ksize;           // Bucket entry key size.
     uint32_t hash;          // Bucket entry hash.
     void *value;            // Value in bucket entry.
 } bucket_t, *p_bucket;
 
-typedef struct hashmap_s {
-    p_bucket buckets;                           // Pointer to linked list of buckets.
-    int capacity;                               // Allocated size for the count of entries.
+typedef struct u64_bucket_s {
+    uint64_t key;           // Bucket entry key.
+    void *value;            // Value in bucket entry.
+} u64_bucket_t, *p_u64_bucket;
+
+typedef struct hashmap_table_s hashmap_table_t, *p_hashmap_table;
+
+/*
+ * Layout of table buckets. Hash of a bucket entry is needed to place it, the move
+ * callback lets buckets linked to each other follow the moved one.
+ *
+ * Table functions take the layout as an argument and every caller passes one of the
+ * constant layouts, so inlined copies call get_hash and on_move directly.
+ */
+typedef struct hashmap_table_type_s {
+    size_t bucket_size;                                     // Size of bucket in bytes.
+    uint32_t (*get_hash)(const void *bucket);               // Hash of bucket entry.
+    void (*on_move)(p_hashmap_table table, void *bucket);   // Bucket entry was moved, may be NULL.
+} hashmap_table_type_t, *p_hashmap_table_type;
+
+/*
+ * Every bucket has a control byte: EMPTY or the 7-bit tag of the entry hash.
+ * Probing compares a group of 16 control bytes at once and touches buckets only on
+ * tag matches. The first HASHMAP_GROUP_WIDTH - 1 control bytes are cloned after the
+ * last one, so a group starting at any bucket is read with a single load.
+ *
+ * Buckets are placed by Robin Hood linear probing: entries of a run are ordered by
+ * home bucket, so no entry is displaced much further than its neighbours. Removal
+ * shifts the rest of the run back instead of leaving a tombstone, and an empty
+ * bucket always ends a probe sequence.
+ *
+ * The table engine is shared by all hashmap variants, they differ in bucket layout.
+ */
+struct hashmap_table_s {
+    char *buckets;                              // Buckets storage.
+    uint8_t *controls;                          // Control bytes of buckets with cloned head.
+    int capacity;                               // Allocated size for the count of entries, a power of two.
+    int shift;                                  // Bits dropped from the mixed hash to get home bucket.
     int count;                                  // Count of set entries in the hash map.
-    int tombstone_count;                        // Tombstones are empty buckets after items have been removed.
+};
+
+typedef struct hashmap_probe_s {
+    uint32_t index;                             // First bucket of the current group.
+    uint32_t match;                             // Tag matches of the current group not visited yet.
+    uint32_t empty;                             // Empty buckets of the current group.
+    uint8_t tag;                                // Tag of the probed hash.
+} hashmap_probe_t, *p_hashmap_probe;
+
+typedef struct hashmap_s {
+    hashmap_table_t table;                      // Buckets table, the first member for move callbacks.
     p_bucket first;                             // Pointer to linked list of all valid entries arranged in order.
     p_bucket last;                              // Necessary to know where to add next entry.
 } hashmap_t, *p_hashmap;
 
+struct hashmap_u64_s {
+    hashmap_table_t table;                      // Buckets table.
+};
+
+struct hashmap_ptr_s {
+    hashmap_u64_t map;                          // Pointers are stored as integer keys.
+};
+
 /***********************************************************************************************
  * STATIC FUNCTIONS DECLARATIONS
  **********************************************************************************************/
 
 /**
- * @brief Put an old bucket into a resized hashmap.
+ * @brief Rezise hashmap.
  * 
  * @param map       Pointer to hashmap.
- * @param old_entry Old bucket entry.
  * 
- * @return Pointer to bucket entry.
+ * @return Error code.
  */
-static p_bucket resize_entry(p_hashmap map, p_bucket old_entry);
+static int hashmap_resize(p_hashmap map);
 
 /**
- * @brief Rezise hashmap.
+ * @brief Searching for an entry in hashmap.
  * 
  * @param map       Pointer to hashmap.
+ * @param key       Pointer to key for bucket entry.
+ * @param ksize     Key size for bucket entry.
+ * @param hash      Hash value.
  * 
- * @return Error code.
+ * @return Pointer to bucket entry, NULL if there is no entry.
  */
-static int hashmap_resize(p_hashmap map);
+static p_bucket find_entry(p_hashmap map, p_key key, size_t ksize, uint32_t hash);
 
 /**
- * @brief Jenkins one-at-a-time hash function.
+ * @brief Insert a new entry into hashmap.
  * 
- * @param data      Pointer to key for bucket entry.
- * @param size      Key size for bucket entry.
+ * @details
+ * Entry is linked last.
+ * 
+ * @param map       Pointer to hashmap.
+ * @param key       Pointer to key for bucket entry.
+ * @param ksize     Key size for bucket entry.
+ * @param hash      Hash value.
+ * 
+ * @return Pointer to bucket entry.
+ */
+static p_bucket insert_entry(p_hashmap map, p_key key, size_t ksize, uint32_t hash);
+
+/**
+ * @brief Remove an entry from hashmap.
+ * 
+ * @param map       Pointer to hashmap.
+ * @param entry     Pointer to bucket entry.
+ */
+static void erase_entry(p_hashmap map, p_bucket entry);
+
+/**
+ * @brief Get hash of bucket entry.
+ * 
+ * @param bucket    Pointer to bucket.
  * 
  * @return Hash value.
  */
-static inline uint32_t hash_data(const unsigned char *data, size_t size);
+static uint32_t get_bucket_hash(const void *bucket);
 
 /**
- * @brief Searching for an entry in hashmap.
+ * @brief Relink neighbours of moved bucket entry.
+ * 
+ * @param table     Pointer to table of hashmap.
+ * @param bucket    Pointer to bucket.
+ */
+static void relink_bucket(p_hashmap_table table, void *bucket);
+
+/**
+ * @brief Searching for an entry in integer keyed hashmap.
  * 
  * @param map       Pointer to hashmap.
- * @param key       Pointer to key for bucket entry.
- * @param ksize     Key size for bucket entry.
+ * @param key       Key for bucket entry.
  * @param hash      Hash value.
  * 
- * @return Pointer to bucket entry.
+ * @return Pointer to bucket entry, NULL if there is no entry.
  */
-static p_bucket find_entry(p_hashmap map, p_key key, size_t ksize, uint32_t hash);
+static p_u64_bucket find_u64_entry(p_hashmap_u64 map, uint64_t key, uint32_t hash);
+
+/**
+ * @brief Get hash of integer keyed bucket entry.
+ * 
+ * @param bucket    Pointer to bucket.
+ * 
+ * @return Hash value.
+ */
+static uint32_t get_u64_bucket_hash(const void *bucket);
+
+/**
+ * @brief Start probing for hash.
+ * 
+ * @param table     Pointer to table.
+ * @param hash      Hash value.
+ * @param probe     Probe state output.
+ */
+static inline void begin_probe(const p_hashmap_table table, uint32_t hash, p_hashmap_probe probe);
+
+/**
+ * @brief Get the next bucket whose tag matches the probed hash.
+ * 
+ * @param table     Pointer to table.
+ * @param probe     Probe state.
+ * @param index     Bucket index output.
+ * 
+ * @return 1 if there is a candidate, 0 if probing is over.
+ */
+static inline int next_candidate(const p_hashmap_table table, p_hashmap_probe probe, uint32_t *index);
+
+/**
+ * @brief Take a bucket for a new entry.
+ * 
+ * @details
+ * The entry takes the first bucket of its run holding a less displaced entry,
+ * the rest of the run is shifted forward by one bucket. Control byte of the
+ * bucket is set, the bucket itself is filled by the caller.
+ * 
+ * @param table     Pointer to table.
+ * @param type      Layout of buckets.
+ * @param hash      Hash value.
+ * 
+ * @return Bucket index.
+ */
+static inline uint32_t insert_bucket(
+    p_hashmap_table table, const hashmap_table_type_t *type, uint32_t hash);
+
+/**
+ * @brief Release bucket of a removed entry.
+ * 
+ * @details
+ * Following displaced entries of the run are shifted back by one bucket.
+ * 
+ * @param table     Pointer to table.
+ * @param type      Layout of buckets.
+ * @param index     Bucket index.
+ */
+static inline void erase_bucket(p_hashmap_table table, const hashmap_table_type_t *type, uint32_t index);
+
+/**
+ * @brief Move bucket entry.
+ * 
+ * @param table     Pointer to table.
+ * @param type      Layout of buckets.
+ * @param from      Source bucket index.
+ * @param to        Destination bucket index.
+ */
+static inline void move_bucket(
+    p_hashmap_table table, const hashmap_table_type_t *type, uint32_t from, uint32_t to);
+
+/**
+ * @brief Rezise table, entries are reinserted in bucket order.
+ * 
+ * @param table     Pointer to table.
+ * @param type      Layout of buckets.
+ * 
+ * @return Error code.
+ */
+static int resize_table(p_hashmap_table table, const hashmap_table_type_t *type);
+
+/**
+ * @brief Get bucket by index.
+ * 
+ * @param table     Pointer to table.
+ * @param type      Layout of buckets.
+ * @param index     Bucket index.
+ * 
+ * @return Pointer to bucket.
+ */
+static inline void *get_bucket(
+    const p_hashmap_table table, const hashmap_table_type_t *type, uint32_t index);
+
+/**
+ * @brief Get distance of bucket entry from its home bucket.
+ * 
+ * @param table     Pointer to table.
+ * @param type      Layout of buckets.
+ * @param index     Bucket index.
+ * 
+ * @return Count of buckets.
+ */
+static inline uint32_t get_displacement(
+    const p_hashmap_table table, const hashmap_table_type_t *type, uint32_t index);
+
+/**
+ * @brief Get home bucket of hash.
+ * 
+ * @details
+ * Fibonacci hashing: the top bits of the multiplied hash select the bucket,
+ * so every bit of the hash takes part and the tag bits are not reused.
+ * 
+ * @param table     Pointer to table.
+ * @param hash      Hash value.
+ * 
+ * @return Index of bucket.
+ */
+static inline uint32_t get_home_index(const p_hashmap_table table, uint32_t hash);
+
+/**
+ * @brief Set control byte of bucket and its clone.
+ * 
+ * @param table     Pointer to table.
+ * @param index     Bucket index.
+ * @param control   Control byte.
+ */
+static inline void set_control(p_hashmap_table table, uint32_t index, uint8_t control);
+
+/**
+ * @brief Match a group of control bytes.
+ * 
+ * @param group     Pointer to the first control byte of group.
+ * @param control   Control byte to match.
+ * 
+ * @return Bit mask of matching bytes, bit i stands for byte i.
+ */
+static inline uint32_t match_group(const uint8_t *group, uint8_t control);
+
+/**
+ * @brief Allocate buckets and control bytes.
+ * 
+ * @param table     Pointer to table.
+ * @param type      Layout of buckets.
+ * @param capacity  Count of buckets, a power of two.
+ * 
+ * @return Error code.
+ */
+static int allocate_buckets(p_hashmap_table table, const hashmap_table_type_t *type, int capacity);
+
+/*********************************************************************************************
+ * STATIC VARIABLES
+ ********************************************************************************************/
+
+static const hashmap_table_type_t bucket_type = {
+    .bucket_size = sizeof(bucket_t), .get_hash = get_bucket_hash, .on_move = relink_bucket};
+
+static const hashmap_table_type_t u64_bucket_type = {
+    .bucket_size = sizeof(u64_bucket_t), .get_hash = get_u64_bucket_hash, .on_move = NULL};
 
 /***********************************************************************************************
  * FUNCTIONS DEFINITIONS
@@ -96,13 +346,9 @@ p_hashmap hashmap_create(void) {
         return NULL;
     }
 
-    map->capacity = HASHMAP_DEFAULT_CAPACITY;
-    map->count = 0;
-    map->tombstone_count = 0;
+    map->table.count = 0;
 
-    map->buckets = calloc(HASHMAP_DEFAULT_CAPACITY, sizeof(bucket_t));
-
-    if (!map->buckets) {
+    if (allocate_buckets(&map->table, &bucket_type, HASHMAP_DEFAULT_CAPACITY) == -1) {
         free(map);
         return NULL;
     }
@@ -116,25 +362,22 @@ p_hashmap hashmap_create(void) {
 void hashmap_set_entry(p_hashmap map, p_key key, void *value) {
     if (!map) exit(IPEE_ERROR_CODE__HASHMAP__NOT_EXISTS);
 
-    if (map->count + 1 > HASHMAP_MAX_LOAD * map->capacity) {
+    hashmap_set_entry_n(map, key, strlen(key), value);
+}
+
+void hashmap_set_entry_n(p_hashmap map, p_key key, size_t ksize, void *value) {
+    if (!map) exit(IPEE_ERROR_CODE__HASHMAP__NOT_EXISTS);
+
+    if (map->table.count + 1 > HASHMAP_MAX_LOAD * map->table.capacity) {
         if (hashmap_resize(map) == -1)
             exit(IPEE_ERROR_CODE__HASHMAP__ALLOCATION_ERROR);
     }
 
-    size_t ksize = strlen(key);
-
     uint32_t hash = hash_data(key, ksize);
     p_bucket entry = find_entry(map, key, ksize, hash);
-    if (!entry->key) {
-        map->last->next = entry;
-        map->last = entry;
-        entry->next = NULL;
-
-        ++map->count;
-
-        entry->key = key;
-        entry->ksize = ksize;
-        entry->hash = hash;
+    if (!entry) {
+        entry = insert_entry(map, key, ksize, hash);
+        ++map->table.count;
     }
 
     entry->value = value;
@@ -143,7 +386,11 @@ void hashmap_set_entry(p_hashmap map, p_key key, void *value) {
 void *hashmap_get_entry(p_hashmap map, p_key key) {
     if (!map) return NULL;
 
-    size_t ksize = strlen(key);
+    return hashmap_get_entry_n(map, key, strlen(key));
+}
+
+void *hashmap_get_entry_n(p_hashmap map, p_key key, size_t ksize) {
+    if (!map) return NULL;
 
     uint32_t hash = hash_data(key, ksize);
     p_bucket entry = find_entry(map, key, ksize, hash);
@@ -154,14 +401,18 @@ void *hashmap_get_entry(p_hashmap map, p_key key) {
 void hashmap_remove_entry(p_hashmap map, p_key key) {
     if (!map) exit(IPEE_ERROR_CODE__HASHMAP__NOT_EXISTS);
 
-    size_t ksize = strlen(key);
+    hashmap_remove_entry_n(map, key, strlen(key));
+}
+
+void hashmap_remove_entry_n(p_hashmap map, p_key key, size_t ksize) {
+    if (!map) exit(IPEE_ERROR_CODE__HASHMAP__NOT_EXISTS);
 
     uint32_t hash = hash_data(key, ksize);
     p_bucket entry = find_entry(map, key, ksize, hash);
 
-    if (entry->key) {
-        entry->key = NULL;
-        ++map->tombstone_count;
+    if (entry) {
+        erase_entry(map, entry);
+        --map->table.count;
     }
 }
 
@@ -178,15 +429,12 @@ void hashmap_remove_all_entries(p_hashmap map) {
         current = current->next;
     }
 
-    map->capacity = HASHMAP_DEFAULT_CAPACITY;
-    map->count = 0;
-    map->tombstone_count = 0;
+    map->table.count = 0;
 
-    free(map->buckets);
+    free(map->table.buckets);
+    free(map->table.controls);
 
-    map->buckets = calloc(HASHMAP_DEFAULT_CAPACITY, sizeof(bucket_t));
-
-    if (!map->buckets) {
+    if (allocate_buckets(&map->table, &bucket_type, HASHMAP_DEFAULT_CAPACITY) == -1) {
         exit(IPEE_ERROR_CODE__HASHMAP__ALLOCATION_ERROR);
     }
 
@@ -207,8 +455,10 @@ void hashmap_remove(p_hashmap *map) {
         current = current->next;
     }
 
-    free((*map)->buckets);
-    (*map)->buckets = NULL;
+    free((*map)->table.buckets);
+    (*map)->table.buckets = NULL;
+    free((*map)->table.controls);
+    (*map)->table.controls = NULL;
 
     free(*map);
     (*map) = NULL;
@@ -217,7 +467,7 @@ void hashmap_remove(p_hashmap *map) {
 int hashmap_get_count(p_hashmap map) {
     if (!map) return -1;
 
-    return map->count - map->tombstone_count;
+    return map->table.count;
 }
 
 void hashmap_iterate(p_hashmap map, hashmap_iteration_callback callback) {
@@ -234,58 +484,203 @@ void hashmap_iterate(p_hashmap map, hashmap_iteration_callback callback) {
     }
 }
 
-/***********************************************************************************************
- * STATIC FUNCTIONS DEFINITIONS
- **********************************************************************************************/
+void hashmap_iterate_n(p_hashmap map, hashmap_iteration_callback_n callback) {
+    if (!map) exit(IPEE_ERROR_CODE__HASHMAP__NOT_EXISTS);
 
-static p_bucket resize_entry(p_hashmap map, p_bucket old_entry) {
-    uint32_t index = old_entry->hash % map->capacity;
-    p_bucket entry = NULL;
+    for (p_bucket current = map->first; current; current = current->next) {
+        callback(current->key, current->ksize, current->value);
+    }
+}
 
-    while (1) {
-        entry = &map->buckets[index];
+p_hashmap_u64 hashmap_u64_create(void) {
+    p_hashmap_u64 map = malloc(sizeof(hashmap_u64_t));
 
-        if (!entry->key) {
-            *entry = *old_entry;
-            return entry;
-        }
+    if (!map) {
+        return NULL;
+    }
+
+    map->table.count = 0;
 
-        index = (index + 1) % map->capacity;
+    if (allocate_buckets(&map->table, &u64_bucket_type, HASHMAP_DEFAULT_CAPACITY) == -1) {
+        free(map);
+        return NULL;
     }
+
+    return map;
 }
 
-static int hashmap_resize(p_hashmap map) {
-    int old_capacity = map->capacity;
-    p_bucket old_buckets = map->buckets;
-    p_bucket current = NULL;
+void hashmap_u64_set_entry(p_hashmap_u64 map, uint64_t key, void *value) {
+    if (!map) exit(IPEE_ERROR_CODE__HASHMAP__NOT_EXISTS);
 
-    map->capacity *= HASHMAP_RESIZE_FACTOR;
-    map->buckets = calloc(map->capacity, sizeof(bucket_t));
+    if (map->table.count + 1 > HASHMAP_MAX_LOAD * map->table.capacity) {
+        if (resize_table(&map->table, &u64_bucket_type) == -1)
+            exit(IPEE_ERROR_CODE__HASHMAP__ALLOCATION_ERROR);
+    }
 
-    if (!map->buckets) {
-        map->capacity = old_capacity;
-        map->buckets = old_buckets;
-        return -1;
+    uint32_t hash = hash_u64(key);
+    p_u64_bucket entry = find_u64_entry(map, key, hash);
+    if (!entry) {
+        uint32_t index = insert_bucket(&map->table, &u64_bucket_type, hash);
+        entry = get_bucket(&map->table, &u64_bucket_type, index);
+        entry->key = key;
+        ++map->table.count;
     }
 
-    map->last = (p_bucket)&map->first;
+    entry->value = value;
+}
+
+void *hashmap_u64_get_entry(p_hashmap_u64 map, uint64_t key) {
+    if (!map) return NULL;
 
-    map->count -= map->tombstone_count;
-    map->tombstone_count = 0;
+    p_u64_bucket entry = find_u64_entry(map, key, hash_u64(key));
 
-    do {
-        current = map->last->next;
-        if (!current->key)
-        {
-            map->last->next = current->next;
-            continue;
+    return entry ? entry->value : NULL;
+}
+
+void hashmap_u64_remove_entry(p_hashmap_u64 map, uint64_t key) {
+    if (!map) exit(IPEE_ERROR_CODE__HASHMAP__NOT_EXISTS);
+
+    p_u64_bucket entry = find_u64_entry(map, key, hash_u64(key));
+
+    if (entry) {
+        erase_bucket(&map->table, &u64_bucket_type, entry - (p_u64_bucket)map->table.buckets);
+        --map->table.count;
+    }
+}
+
+void hashmap_u64_remove_all_entries(p_hashmap_u64 map) {
+    if (!map) exit(IPEE_ERROR_CODE__HASHMAP__NOT_EXISTS);
+
+    map->table.count = 0;
+
+    free(map->table.buckets);
+    free(map->table.controls);
+
+    if (allocate_buckets(&map->table, &u64_bucket_type, HASHMAP_DEFAULT_CAPACITY) == -1) {
+        exit(IPEE_ERROR_CODE__HASHMAP__ALLOCATION_ERROR);
+    }
+}
+
+void hashmap_u64_remove(p_hashmap_u64 *map) {
+    if (!map || !(*map)) return;
+
+    free((*map)->table.buckets);
+    free((*map)->table.controls);
+
+    free(*map);
+    (*map) = NULL;
+}
+
+int hashmap_u64_get_count(p_hashmap_u64 map) {
+    if (!map) return -1;
+
+    return map->table.count;
+}
+
+void hashmap_u64_iterate(p_hashmap_u64 map, hashmap_u64_iteration_callback callback) {
+    if (!map) exit(IPEE_ERROR_CODE__HASHMAP__NOT_EXISTS);
+
+    p_u64_bucket buckets = (p_u64_bucket)map->table.buckets;
+    for (int i = 0; i < map->table.capacity; ++i) {
+        if (map->table.controls[i] != HASHMAP_CONTROL_EMPTY) {
+            callback(buckets[i].key, buckets[i].value);
+        }
+    }
+}
+
+p_hashmap_ptr hashmap_ptr_create(void) {
+    p_hashmap_ptr map = malloc(sizeof(hashmap_ptr_t));
+
+    if (!map) {
+        return NULL;
+    }
+
+    map->map.table.count = 0;
+
+    if (allocate_buckets(&map->map.table, &u64_bucket_type, HASHMAP_DEFAULT_CAPACITY) == -1) {
+        free(map);
+        return NULL;
+    }
+
+    return map;
+}
+
+void hashmap_ptr_set_entry(p_hashmap_ptr map, const void *key, void *value) {
+    if (!map) exit(IPEE_ERROR_CODE__HASHMAP__NOT_EXISTS);
+
+    hashmap_u64_set_entry(&map->map, (uintptr_t)key, value);
+}
+
+void *hashmap_ptr_get_entry(p_hashmap_ptr map, const void *key) {
+    if (!map) return NULL;
+
+    return hashmap_u64_get_entry(&map->map, (uintptr_t)key);
+}
+
+void hashmap_ptr_remove_entry(p_hashmap_ptr map, const void *key) {
+    if (!map) exit(IPEE_ERROR_CODE__HASHMAP__NOT_EXISTS);
+
+    hashmap_u64_remove_entry(&map->map, (uintptr_t)key);
+}
+
+void hashmap_ptr_remove_all_entries(p_hashmap_ptr map) {
+    if (!map) exit(IPEE_ERROR_CODE__HASHMAP__NOT_EXISTS);
+
+    hashmap_u64_remove_all_entries(&map->map);
+}
+
+void hashmap_ptr_remove(p_hashmap_ptr *map) {
+    if (!map || !(*map)) return;
+
+    free((*map)->map.table.buckets);
+    free((*map)->map.table.controls);
+
+    free(*map);
+    (*map) = NULL;
+}
+
+int hashmap_ptr_get_count(p_hashmap_ptr map) {
+    if (!map) return -1;
+
+    return map->map.table.count;
+}
+
+void hashmap_ptr_iterate(p_hashmap_ptr map, hashmap_ptr_iteration_callback callback) {
+    if (!map) exit(IPEE_ERROR_CODE__HASHMAP__NOT_EXISTS);
+
+    p_u64_bucket buckets = (p_u64_bucket)map->map.table.buckets;
+    for (int i = 0; i < map->map.table.capacity; ++i) {
+        if (map->map.table.controls[i] != HASHMAP_CONTROL_EMPTY) {
+            callback((const void *)(uintptr_t)buckets[i].key, buckets[i].value);
         }
+    }
+}
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DEFINITIONS
+ **********************************************************************************************/
+
+static int hashmap_resize(p_hashmap map) {
+    char *old_buckets = map->table.buckets;
+    uint8_t *old_controls = map->table.controls;
+    p_bucket current = map->first;
+
+    if (allocate_buckets(&map->table, &bucket_type, map->table.capacity * HASHMAP_RESIZE_FACTOR) == -1) {
+        return -1;
+    }
+
+    map->first = NULL;
+    map->last = (p_bucket)&map->first;
 
-        map->last->next = resize_entry(map, map->last->next);
-        map->last = map->last->next;
-    } while (map->last->next);
+    // Entries are reinserted in order, so the new list keeps the insertion order.
+    while (current) {
+        p_bucket entry = insert_entry(map, current->key, current->ksize, current->hash);
+        entry->value = current->value;
+        current = current->next;
+    }
 
     free(old_buckets);
+    free(old_controls);
     return 0;
 }
 
@@ -307,57 +702,233 @@ static inline size_t hashmap_hash_default(const void *data, size_t size)
     return hash;
 }
 
-static inline uint32_t hash_data(const unsigned char *data, size_t size)
-{
-    size_t nblocks = size / 8;
-    uint64_t hash = HASHMAP_HASH_INIT;
-    for (size_t i = 0; i < nblocks; ++i) {
-        hash ^= (uint64_t)data[0] << 0 | (uint64_t)data[1] << 8 |
-                (uint64_t)data[2] << 16 | (uint64_t)data[3] << 24 |
-                (uint64_t)data[4] << 32 | (uint64_t)data[5] << 40 |
-                (uint64_t)data[6] << 48 | (uint64_t)data[7] << 56;
-        hash *= 0xbf58476d1ce4e5b9;
-        data += 8;
-    }
-
-    uint64_t last = size & 0xff;
-    switch (size % 8) {
-    case 7:
-        last |= (uint64_t)data[6] << 56;
-    case 6:
-        last |= (uint64_t)data[5] << 48;
-    case 5:
-        last |= (uint64_t)data[4] << 40;
-    case 4:
-        last |= (uint64_t)data[3] << 32;
-    case 3:
-        last |= (uint64_t)data[2] << 24;
-    case 2:
-        last |= (uint64_t)data[1] << 16;
-    case 1:
-        last |= (uint64_t)data[0] << 8;
-        hash ^= last;
-        hash *= 0xd6e8feb86659fd93;
-    }
-
-    return (uint32_t)(hash ^ hash >> 32);
+static p_bucket find_entry(p_hashmap map, p_key key, size_t ksize, uint32_t hash) {
+    hashmap_probe_t probe;
+    uint32_t index;
+
+    begin_probe(&map->table, hash, &probe);
+    while (next_candidate(&map->table, &probe, &index)) {
+        p_bucket entry = &((p_bucket)map->table.buckets)[index];
+
+        if (entry->ksize == ksize  &&
+            entry->hash == hash    &&
+            memcmp(entry->key, key, ksize) == 0) {
+            return entry;
+        }
+    }
+
+    return NULL;
 }
 
-static p_bucket find_entry(p_hashmap map, p_key key, size_t ksize, uint32_t hash) {
-    uint32_t index = hash % map->capacity;
-    p_bucket entry = NULL;
+static p_bucket insert_entry(p_hashmap map, p_key key, size_t ksize, uint32_t hash) {
+    uint32_t index = insert_bucket(&map->table, &bucket_type, hash);
+    p_bucket entry = get_bucket(&map->table, &bucket_type, index);
 
-    while (1) {
-        entry = &map->buckets[index];
+    entry->key = key;
+    entry->ksize = ksize;
+    entry->hash = hash;
+    entry->next = NULL;
+    entry->prev = map->last;
+
+    map->last->next = entry;
+    map->last = entry;
+
+    return entry;
+}
+
+static void erase_entry(p_hashmap map, p_bucket entry) {
+    entry->prev->next = entry->next;
+    if (entry->next)
+        entry->next->prev = entry->prev;
+    else
+        map->last = entry->prev;
+
+    erase_bucket(&map->table, &bucket_type, entry - (p_bucket)map->table.buckets);
+}
+
+static uint32_t get_bucket_hash(const void *bucket) {
+    return ((const bucket_t *)bucket)->hash;
+}
 
-        if ((!entry->key && !entry->value) ||
-            (entry->key             &&
-             entry->ksize == ksize  &&
-             entry->hash == hash    &&
-             memcmp(entry->key, key, ksize) == 0)) {
+static void relink_bucket(p_hashmap_table table, void *bucket) {
+    p_hashmap map = (p_hashmap)table;
+    p_bucket entry = bucket;
+
+    entry->prev->next = entry;
+    if (entry->next)
+        entry->next->prev = entry;
+    else
+        map->last = entry;
+}
+
+static p_u64_bucket find_u64_entry(p_hashmap_u64 map, uint64_t key, uint32_t hash) {
+    hashmap_probe_t probe;
+    uint32_t index;
+
+    // Tag match and key compare are enough, integer keys have no size or stored hash.
+    begin_probe(&map->table, hash, &probe);
+    while (next_candidate(&map->table, &probe, &index)) {
+        p_u64_bucket entry = &((p_u64_bucket)map->table.buckets)[index];
+
+        if (entry->key == key) {
             return entry;
         }
+    }
+
+    return NULL;
+}
+
+static uint32_t get_u64_bucket_hash(const void *bucket) {
+    return hash_u64(((const u64_bucket_t *)bucket)->key);
+}
+
+static inline void begin_probe(const p_hashmap_table table, uint32_t hash, p_hashmap_probe probe) {
+    probe->index = get_home_index(table, hash);
+    probe->tag = hash & HASHMAP_TAG_MASK;
+    probe->match = match_group(&table->controls[probe->index], probe->tag);
+    probe->empty = match_group(&table->controls[probe->index], HASHMAP_CONTROL_EMPTY);
+}
+
+static inline int next_candidate(const p_hashmap_table table, p_hashmap_probe probe, uint32_t *index) {
+    const uint32_t mask = table->capacity - 1;
+
+    // Load factor keeps an empty bucket in the table, so probing always stops.
+    while (!probe->match) {
+        if (probe->empty)
+            return 0;
+
+        probe->index = (probe->index + HASHMAP_GROUP_WIDTH) & mask;
+        probe->match = match_group(&table->controls[probe->index], probe->tag);
+        probe->empty = match_group(&table->controls[probe->index], HASHMAP_CONTROL_EMPTY);
+    }
+
+    *index = (probe->index + __builtin_ctz(probe->match)) & mask;
+    probe->match &= probe->match - 1;
+    return 1;
+}
+
+static inline uint32_t insert_bucket(
+    p_hashmap_table table, const hashmap_table_type_t *type, uint32_t hash) {
+    const uint32_t mask = table->capacity - 1;
+    uint32_t index = get_home_index(table, hash);
+
+    // Entry goes before the first one which is closer to its home than the entry to its own.
+    for (uint32_t distance = 0; table->controls[index] != HASHMAP_CONTROL_EMPTY; ++distance) {
+        if (get_displacement(table, type, index) < distance)
+            break;
 
-        index = (index + 1) % map->capacity;
+        index = (index + 1) & mask;
     }
+
+    if (table->controls[index] != HASHMAP_CONTROL_EMPTY) {
+        uint32_t empty = index;
+        while (table->controls[empty] != HASHMAP_CONTROL_EMPTY)
+            empty = (empty + 1) & mask;
+
+        for (; empty != index; empty = (empty - 1) & mask)
+            move_bucket(table, type, (empty - 1) & mask, empty);
+    }
+
+    set_control(table, index, hash & HASHMAP_TAG_MASK);
+    return index;
+}
+
+static inline void erase_bucket(p_hashmap_table table, const hashmap_table_type_t *type, uint32_t index) {
+    const uint32_t mask = table->capacity - 1;
+
+    uint32_t next = (index + 1) & mask;
+    while (table->controls[next] != HASHMAP_CONTROL_EMPTY && get_displacement(table, type, next) > 0) {
+        move_bucket(table, type, next, index);
+        index = next;
+        next = (next + 1) & mask;
+    }
+
+    set_control(table, index, HASHMAP_CONTROL_EMPTY);
+    memset(get_bucket(table, type, index), 0, type->bucket_size);
+}
+
+static inline void move_bucket(
+    p_hashmap_table table, const hashmap_table_type_t *type, uint32_t from, uint32_t to) {
+    void *bucket = get_bucket(table, type, to);
+
+    memcpy(bucket, get_bucket(table, type, from), type->bucket_size);
+    set_control(table, to, table->controls[from]);
+
+    if (type->on_move)
+        type->on_move(table, bucket);
+}
+
+static int resize_table(p_hashmap_table table, const hashmap_table_type_t *type) {
+    char *old_buckets = table->buckets;
+    uint8_t *old_controls = table->controls;
+    int old_capacity = table->capacity;
+
+    if (allocate_buckets(table, type, old_capacity * HASHMAP_RESIZE_FACTOR) == -1) {
+        return -1;
+    }
+
+    for (int i = 0; i < old_capacity; ++i) {
+        if (old_controls[i] == HASHMAP_CONTROL_EMPTY)
+            continue;
+
+        void *old_bucket = old_buckets + (size_t)i * type->bucket_size;
+        uint32_t index = insert_bucket(table, type, type->get_hash(old_bucket));
+        memcpy(get_bucket(table, type, index), old_bucket, type->bucket_size);
+    }
+
+    free(old_buckets);
+    free(old_controls);
+    return 0;
+}
+
+static inline void *get_bucket(
+    const p_hashmap_table table, const hashmap_table_type_t *type, uint32_t index) {
+    return table->buckets + (size_t)index * type->bucket_size;
+}
+
+static inline uint32_t get_displacement(
+    const p_hashmap_table table, const hashmap_table_type_t *type, uint32_t index) {
+    uint32_t hash = type->get_hash(get_bucket(table, type, index));
+    return (index - get_home_index(table, hash)) & (table->capacity - 1);
+}
+
+static inline uint32_t get_home_index(const p_hashmap_table table, uint32_t hash) {
+    return (hash * HASHMAP_FIBONACCI_MULTIPLIER) >> table->shift;
+}
+
+static inline void set_control(p_hashmap_table table, uint32_t index, uint8_t control) {
+    table->controls[index] = control;
+    if (index < HASHMAP_GROUP_WIDTH - 1)
+        table->controls[table->capacity + index] = control;
+}
+
+static inline uint32_t match_group(const uint8_t *group, uint8_t control) {
+#if defined(__SSE2__)
+    __m128i controls = _mm_loadu_si128((const __m128i *)group);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(controls, _mm_set1_epi8((char)control)));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < HASHMAP_GROUP_WIDTH; ++i)
+        mask |= (uint32_t)(group[i] == control) << i;
+    return mask;
+#endif
+}
+
+static int allocate_buckets(p_hashmap_table table, const hashmap_table_type_t *type, int capacity) {
+    char *buckets = calloc(capacity, type->bucket_size);
+    uint8_t *controls = malloc(capacity + HASHMAP_GROUP_WIDTH - 1);
+
+    if (!buckets || !controls) {
+        free(buckets);
+        free(controls);
+        return -1;
+    }
+
+    memset(controls, HASHMAP_CONTROL_EMPTY, capacity + HASHMAP_GROUP_WIDTH - 1);
+
+    table->buckets = buckets;
+    table->controls = controls;
+    table->capacity = capacity;
+    table->shift = 32 - __builtin_ctz(capacity);
+    return 0;
 }
@@ -0,0 +1,357 @@
+#include <mapped_dictionary.h>
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <hash.h>
+
+/*********************************************************************************************
+ * MACROS DECLARATIONS
+ ********************************************************************************************/
+
+#define MAPPED_DICTIONARY_MAGIC "IPEEDICT"
+#define MAPPED_DICTIONARY_VERSION 1
+#define MAPPED_DICTIONARY_ALIGNMENT 8
+#define MAPPED_DICTIONARY_EMPTY_BUCKET UINT32_MAX
+
+/**
+ * @brief Round size up to record alignment.
+ */
+#define align_mapped_size(size) \
+    (((size) + MAPPED_DICTIONARY_ALIGNMENT - 1) & ~(uint64_t)(MAPPED_DICTIONARY_ALIGNMENT - 1))
+
+/*********************************************************************************************
+ * STRUCTS DECLARATIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Dictionary file header.
+ */
+typedef struct mapped_dictionary_header_s {
+    char magic[8];     // File magic.
+    uint32_t version;  // Format version.
+    uint32_t size;     // Count of records.
+    uint32_t capacity; // Count of hash table buckets, power of two.
+    uint32_t reserved; // Reserved, zero.
+    uint64_t length;   // File length.
+} mapped_dictionary_header_t, *p_mapped_dictionary_header;
+
+/**
+ * @brief Dictionary file record.
+ *
+ * @details
+ * Key bytes with terminator follow the record, value follows the key
+ * aligned to 8 bytes.
+ */
+typedef struct mapped_record_s {
+    uint32_t hash;         // Key hash.
+    uint32_t key_length;   // Key length without terminator.
+    uint64_t value_length; // Value length.
+    char key[];            // Key.
+} mapped_record_t, *p_mapped_record;
+
+struct mapped_dictionary_s {
+    const uint8_t *data;                      // Mapping.
+    size_t length;                            // Mapping length.
+    const mapped_dictionary_header_t *header; // File header.
+    const uint64_t *offsets;                  // Records offsets.
+    const uint32_t *buckets;                  // Hash table of records numbers.
+};
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ **********************************************************************************************/
+
+/**
+ * @brief Save dictionary to file.
+ *
+ * @param dict Dictionary.
+ * @param path File path.
+ * @param value_size Size of each value, used if callback is NULL.
+ * @param callback Callback function returning size of each value.
+ * @return 0 on success, error code otherwise.
+ */
+static int write_dictionary(
+    const p_dictionary dict, const char *path, size_t value_size, dictionary_value_size_callback callback);
+
+/**
+ * @brief Write zero bytes up to alignment.
+ *
+ * @param file File.
+ * @param length Count of bytes written since an aligned position.
+ * @return 1 on success, 0 otherwise.
+ */
+static int write_padding(FILE *file, uint64_t length);
+
+/**
+ * @brief Get record of mapped dictionary by number.
+ *
+ * @param dict Mapped dictionary.
+ * @param number Record number.
+ * @return Record, NULL if it is misaligned, does not fit the mapping or its key is not terminated.
+ */
+static p_mapped_record get_mapped_record(const p_mapped_dictionary dict, uint32_t number);
+
+/**
+ * @brief Get value of mapped record.
+ *
+ * @param record Record.
+ * @return Record value.
+ */
+static const void *get_mapped_value(const p_mapped_record record);
+
+/*********************************************************************************************
+ * FUNCTIONS DEFINITIONS
+ ********************************************************************************************/
+
+int save_dictionary(const p_dictionary dict, const char *path, size_t value_size) {
+    return write_dictionary(dict, path, value_size, NULL);
+}
+
+int save_dictionary_with_sizes(
+    const p_dictionary dict, const char *path, dictionary_value_size_callback callback) {
+    return write_dictionary(dict, path, 0, callback);
+}
+
+p_mapped_dictionary load_dictionary(const char *path) {
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+
+    struct stat stat;
+    if (fstat(fd, &stat) || (size_t)stat.st_size < sizeof(mapped_dictionary_header_t)) {
+        close(fd);
+        return NULL;
+    }
+
+    const size_t length = (size_t)stat.st_size;
+    const uint8_t *data = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return NULL;
+
+    const mapped_dictionary_header_t *header = (const mapped_dictionary_header_t *)data;
+    const uint64_t tables_length = (uint64_t)header->size * sizeof(uint64_t) +
+                                   (uint64_t)header->capacity * sizeof(uint32_t);
+    if (memcmp(header->magic, MAPPED_DICTIONARY_MAGIC, sizeof(header->magic)) ||
+        header->version != MAPPED_DICTIONARY_VERSION || header->length != length ||
+        header->capacity == 0 || (header->capacity & (header->capacity - 1)) ||
+        header->capacity <= header->size || sizeof(mapped_dictionary_header_t) + tables_length > length) {
+        munmap((void *)data, length);
+        return NULL;
+    }
+
+    p_mapped_dictionary dict = malloc(sizeof(mapped_dictionary_t));
+    if (!dict) {
+        munmap((void *)data, length);
+        return NULL;
+    }
+
+    dict->data = data;
+    dict->length = length;
+    dict->header = header;
+    dict->offsets = (const uint64_t *)(data + sizeof(mapped_dictionary_header_t));
+    dict->buckets = (const uint32_t *)(dict->offsets + header->size);
+
+    return dict;
+}
+
+int unload_dictionary(p_mapped_dictionary dict) {
+    if (!dict)
+        return IPEE_ERROR_CODE__MAPPED_DICTIONARY__NOT_EXISTS;
+
+    munmap((void *)dict->data, dict->length);
+    free(dict);
+    return 0;
+}
+
+int get_mapped_dictionary_size(const p_mapped_dictionary dict) {
+    if (!dict)
+        return IPEE_ERROR_CODE__MAPPED_DICTIONARY__NOT_EXISTS;
+
+    return (int)dict->header->size;
+}
+
+const void *get_value_from_mapped_dictionary(const p_mapped_dictionary dict, const char *key, size_t *length) {
+    if (!dict)
+        return NULL;
+
+    // NULL keys are saved as empty strings.
+    key = key ? key : "";
+    const size_t key_length = strlen(key);
+    const uint32_t hash = hash_data(key, key_length);
+    const uint32_t mask = dict->header->capacity - 1;
+    uint32_t bucket = hash & mask;
+    for (uint32_t probe = 0; probe < dict->header->capacity; probe++, bucket = (bucket + 1) & mask) {
+        const uint32_t number = dict->buckets[bucket];
+        if (number == MAPPED_DICTIONARY_EMPTY_BUCKET)
+            return NULL;
+
+        p_mapped_record record = get_mapped_record(dict, number);
+        if (!record)
+            return NULL;
+        if (record->hash == hash && record->key_length == key_length && !memcmp(record->key, key, key_length)) {
+            if (length)
+                *length = (size_t)record->value_length;
+            return get_mapped_value(record);
+        }
+    }
+
+    return NULL;
+}
+
+int get_record_from_mapped_dictionary_by_index(
+    const p_mapped_dictionary dict, int index, p_record record, size_t *length) {
+    if (!dict)
+        return IPEE_ERROR_CODE__MAPPED_DICTIONARY__NOT_EXISTS;
+    if (index < 0 || (uint32_t)index >= dict->header->size)
+        return IPEE_ERROR_CODE__MAPPED_DICTIONARY__INDEX_OUT_OF_RANGE;
+
+    p_mapped_record mapped = get_mapped_record(dict, (uint32_t)index);
+    if (!mapped)
+        return IPEE_ERROR_CODE__MAPPED_DICTIONARY__INVALID_FORMAT;
+
+    *record = (record_t){.key = mapped->key, .value = get_mapped_value(mapped)};
+    if (length)
+        *length = (size_t)mapped->value_length;
+    return 0;
+}
+
+int iterate_over_mapped_dictionary_with_args(
+    const p_mapped_dictionary dict, dictionary_iteration_callback_with_args callback, void *args) {
+    if (!dict)
+        return IPEE_ERROR_CODE__MAPPED_DICTIONARY__NOT_EXISTS;
+
+    for (uint32_t number = 0; number < dict->header->size; number++) {
+        p_mapped_record record = get_mapped_record(dict, number);
+        if (!record)
+            return IPEE_ERROR_CODE__MAPPED_DICTIONARY__INVALID_FORMAT;
+        callback(record->key, get_mapped_value(record), args);
+    }
+
+    return 0;
+}
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DEFINITIONS
+ **********************************************************************************************/
+
+static int write_dictionary(
+    const p_dictionary dict, const char *path, size_t value_size, dictionary_value_size_callback callback) {
+    if (!dict)
+        return IPEE_ERROR_CODE__MAPPED_DICTIONARY__NOT_EXISTS;
+
+    // Table is kept at most half full, so probes stay short.
+    const uint32_t size = (uint32_t)dict->size;
+    uint32_t capacity = 2;
+    while (capacity < 2 * size)
+        capacity <<= 1;
+
+    uint64_t *offsets = malloc(((size_t)size + 1) * sizeof(uint64_t));
+    uint32_t *buckets = malloc((size_t)capacity * sizeof(uint32_t));
+    p_record *records = malloc(((size_t)size + 1) * sizeof(p_record));
+    if (!offsets || !buckets || !records) {
+        free(offsets);
+        free(buckets);
+        free(records);
+        return IPEE_ERROR_CODE__MAPPED_DICTIONARY__ALLOCATION_ERROR;
+    }
+    memset(buckets, 0xff, (size_t)capacity * sizeof(uint32_t));
+
+    // First pass lays records out and puts first occurrences of keys into the hash table.
+    const uint64_t tables_length = (uint64_t)size * sizeof(uint64_t) + (uint64_t)capacity * sizeof(uint32_t);
+    uint64_t offset = align_mapped_size(sizeof(mapped_dictionary_header_t) + tables_length);
+    uint32_t number = 0;
+    for (p_record record = dict->head; record; record = record->next, number++) {
+        const char *key = record->key ? record->key : "";
+        const size_t key_length = strlen(key);
+        const uint32_t hash = hash_data(key, key_length);
+        const uint32_t mask = capacity - 1;
+        uint32_t bucket = hash & mask;
+        while (buckets[bucket] != MAPPED_DICTIONARY_EMPTY_BUCKET) {
+            const char *other = records[buckets[bucket]]->key;
+            if (!strcmp(key, other ? other : ""))
+                break;
+            bucket = (bucket + 1) & mask;
+        }
+        if (buckets[bucket] == MAPPED_DICTIONARY_EMPTY_BUCKET)
+            buckets[bucket] = number;
+
+        records[number] = record;
+        offsets[number] = offset;
+        const uint64_t length = callback ? callback(record) : value_size;
+        offset += align_mapped_size(sizeof(mapped_record_t) + key_length + 1) + align_mapped_size(length);
+    }
+
+    mapped_dictionary_header_t header = {
+        .version = MAPPED_DICTIONARY_VERSION, .size = size, .capacity = capacity, .length = offset};
+    memcpy(header.magic, MAPPED_DICTIONARY_MAGIC, sizeof(header.magic));
+
+    FILE *file = fopen(path, "wb");
+    int written = file && fwrite(&header, sizeof(header), 1, file) == 1 &&
+                  fwrite(offsets, sizeof(uint64_t), size, file) == size &&
+                  fwrite(buckets, sizeof(uint32_t), capacity, file) == capacity &&
+                  write_padding(file, sizeof(header) + tables_length);
+
+    for (number = 0; written && number < size; number++) {
+        p_record record = records[number];
+        const char *key = record->key ? record->key : "";
+        const size_t key_length = strlen(key);
+        const uint64_t length = callback ? callback(record) : value_size;
+        const mapped_record_t mapped = {
+            .hash = hash_data(key, key_length), .key_length = (uint32_t)key_length, .value_length = length};
+
+        written = fwrite(&mapped, sizeof(mapped), 1, file) == 1 &&
+                  fwrite(key, 1, key_length + 1, file) == key_length + 1 &&
+                  write_padding(file, sizeof(mapped) + key_length + 1);
+        if (written && record->value)
+            written = fwrite(record->value, 1, length, file) == length;
+        else if (written)
+            for (uint64_t i = 0; written && i < length; i++)
+                written = fputc(0, file) != EOF;
+        written = written && write_padding(file, length);
+    }
+
+    if (file && fclose(file))
+        written = 0;
+
+    free(offsets);
+    free(buckets);
+    free(records);
+    return written ? 0 : IPEE_ERROR_CODE__MAPPED_DICTIONARY__FILE_ERROR;
+}
+
+static int write_padding(FILE *file, uint64_t length) {
+    static const uint8_t zeros[MAPPED_DICTIONARY_ALIGNMENT] = {0};
+    const size_t padding = (size_t)(align_mapped_size(length) - length);
+    return fwrite(zeros, 1, padding, file) == padding;
+}
+
+static p_mapped_record get_mapped_record(const p_mapped_dictionary dict, uint32_t number) {
+    if (number >= dict->header->size)
+        return NULL;
+
+    // Sizes are compared with what is left of the mapping, so crafted ones cannot wrap around.
+    const uint64_t offset = dict->offsets[number];
+    if (offset % MAPPED_DICTIONARY_ALIGNMENT || offset > dict->length ||
+        sizeof(mapped_record_t) > dict->length - offset)
+        return NULL;
+
+    p_mapped_record record = (p_mapped_record)(dict->data + offset);
+    const uint64_t left = dict->length - offset;
+    const uint64_t value_offset = align_mapped_size(sizeof(mapped_record_t) + (uint64_t)record->key_length + 1);
+    if (value_offset > left || record->value_length > left - value_offset)
+        return NULL;
+
+    // Keys are handed out as C strings.
+    return record->key[record->key_length] == '\0' ? record : NULL;
+}
+
+static const void *get_mapped_value(const p_mapped_record record) {
+    return (const uint8_t *)record + align_mapped_size(sizeof(mapped_record_t) + record->key_length + 1);
+}
@@ -0,0 +1,276 @@
+#include <ordered_dictionary.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*********************************************************************************************
+ * MACROS DECLARATIONS
+ ********************************************************************************************/
+
+#define ORDERED_DICTIONARY_MAX_LEVEL 16
+#define ORDERED_DICTIONARY_LEVEL_SEED 2463534242u
+
+/*********************************************************************************************
+ * STRUCTS DECLARATIONS
+ ********************************************************************************************/
+
+struct ordered_dictionary_s {
+    p_ordered_record head; // Sentinel linked on every level.
+    int level;             // Count of levels in use.
+    int size;              // Count of records.
+    uint32_t seed;         // Level generator state.
+};
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ **********************************************************************************************/
+
+/**
+ * @brief Compare keys, NULL key is less than any other.
+ *
+ * @param a First key.
+ * @param b Second key.
+ * @return Negative, zero or positive as for strcmp.
+ */
+static int compare_keys(const char *a, const char *b);
+
+/**
+ * @brief Allocate record linked on specified count of levels.
+ *
+ * @param level Count of levels.
+ * @return Record, NULL on allocation failure.
+ */
+static p_ordered_record allocate_record(int level);
+
+/**
+ * @brief Draw level of a new record.
+ *
+ * @details
+ * Each next level is taken with probability 1/4.
+ *
+ * @param dict Dictionary.
+ * @return Count of levels.
+ */
+static int random_level(const p_ordered_dictionary dict);
+
+/**
+ * @brief Find last records before key on each level.
+ *
+ * @param dict Dictionary.
+ * @param key Record key.
+ * @param inclusive Nonzero to stop before records equal to key, zero to pass them.
+ * @param update Last records before key by level output, may be NULL.
+ * @return Record following the last one on level 0.
+ */
+static p_ordered_record find_predecessors(
+    const p_ordered_dictionary dict, const char *key, int inclusive, p_ordered_record *update);
+
+/*********************************************************************************************
+ * FUNCTIONS DEFINITIONS
+ ********************************************************************************************/
+
+p_ordered_dictionary create_ordered_dictionary(void) {
+    p_ordered_dictionary dict = (p_ordered_dictionary)malloc(sizeof(ordered_dictionary_t));
+    if (!dict)
+        return NULL;
+
+    dict->head = allocate_record(ORDERED_DICTIONARY_MAX_LEVEL);
+    if (!dict->head) {
+        free(dict);
+        return NULL;
+    }
+
+    dict->head->key = NULL;
+    dict->head->value = NULL;
+    dict->level = 1;
+    dict->size = 0;
+    dict->seed = ORDERED_DICTIONARY_LEVEL_SEED;
+    return dict;
+}
+
+int delete_ordered_dictionary(p_ordered_dictionary dict) {
+    if (!dict)
+        return IPEE_ERROR_CODE__ORDERED_DICTIONARY__NOT_EXISTS;
+
+    p_ordered_record record = dict->head;
+    while (record) {
+        p_ordered_record next = record->next[0];
+        free(record);
+        record = next;
+    }
+    free(dict);
+    return 0;
+}
+
+int add_record_to_ordered_dictionary(const p_ordered_dictionary dict, char *key, void *value) {
+    if (!dict)
+        return IPEE_ERROR_CODE__ORDERED_DICTIONARY__NOT_EXISTS;
+
+    p_ordered_record update[ORDERED_DICTIONARY_MAX_LEVEL];
+    p_ordered_record record = find_predecessors(dict, key, 1, update);
+    if (record && compare_keys(record->key, key) == 0) {
+        record->value = value;
+        return 0;
+    }
+
+    int level = random_level(dict);
+    record = allocate_record(level);
+    if (!record)
+        return IPEE_ERROR_CODE__ORDERED_DICTIONARY__RECORD_CREATION_ERROR;
+
+    for (; dict->level < level; dict->level++)
+        update[dict->level] = dict->head;
+
+    record->key = key;
+    record->value = value;
+    for (int i = 0; i < level; i++) {
+        record->next[i] = update[i]->next[i];
+        update[i]->next[i] = record;
+    }
+    dict->size++;
+    return 0;
+}
+
+void *remove_record_from_ordered_dictionary(const p_ordered_dictionary dict, const char *key) {
+    if (!dict)
+        return NULL;
+
+    p_ordered_record update[ORDERED_DICTIONARY_MAX_LEVEL];
+    p_ordered_record record = find_predecessors(dict, key, 1, update);
+    if (!record || compare_keys(record->key, key) != 0)
+        return NULL;
+
+    for (int i = 0; i < record->level; i++)
+        update[i]->next[i] = record->next[i];
+    while (dict->level > 1 && !dict->head->next[dict->level - 1])
+        dict->level--;
+
+    void *removed_value = record->value;
+    free(record);
+    dict->size--;
+    return removed_value;
+}
+
+p_ordered_record get_record_from_ordered_dictionary(const p_ordered_dictionary dict, const char *key) {
+    p_ordered_record record = lower_bound_in_ordered_dictionary(dict, key);
+    return record && compare_keys(record->key, key) == 0 ? record : NULL;
+}
+
+void *get_value_from_ordered_dictionary(const p_ordered_dictionary dict, const char *key) {
+    p_ordered_record record = get_record_from_ordered_dictionary(dict, key);
+    return record ? record->value : NULL;
+}
+
+int get_ordered_dictionary_size(const p_ordered_dictionary dict) {
+    if (!dict)
+        return IPEE_ERROR_CODE__ORDERED_DICTIONARY__NOT_EXISTS;
+
+    return dict->size;
+}
+
+p_ordered_record get_first_record_from_ordered_dictionary(const p_ordered_dictionary dict) {
+    return dict ? dict->head->next[0] : NULL;
+}
+
+p_ordered_record lower_bound_in_ordered_dictionary(const p_ordered_dictionary dict, const char *key) {
+    return dict ? find_predecessors(dict, key, 1, NULL) : NULL;
+}
+
+p_ordered_record upper_bound_in_ordered_dictionary(const p_ordered_dictionary dict, const char *key) {
+    return dict ? find_predecessors(dict, key, 0, NULL) : NULL;
+}
+
+int iterate_over_ordered_dictionary_with_args(
+    const p_ordered_dictionary dict, dictionary_iteration_callback_with_args callback, void *args) {
+    if (!dict)
+        return IPEE_ERROR_CODE__ORDERED_DICTIONARY__NOT_EXISTS;
+
+    for (p_ordered_record record = dict->head->next[0]; record; record = record->next[0])
+        callback(record->key, record->value, args);
+    return 0;
+}
+
+int iterate_over_ordered_dictionary_range_with_args(
+    const p_ordered_dictionary dict, const char *from, const char *to,
+    dictionary_iteration_callback_with_args callback, void *args) {
+    if (!dict)
+        return IPEE_ERROR_CODE__ORDERED_DICTIONARY__NOT_EXISTS;
+
+    int count = 0;
+    p_ordered_record record = from ? find_predecessors(dict, from, 1, NULL) : dict->head->next[0];
+    for (; record && (!to || compare_keys(record->key, to) < 0); record = record->next[0]) {
+        callback(record->key, record->value, args);
+        count++;
+    }
+    return count;
+}
+
+int iterate_over_ordered_dictionary_prefix_with_args(
+    const p_ordered_dictionary dict, const char *prefix,
+    dictionary_iteration_callback_with_args callback, void *args) {
+    if (!dict || !prefix)
+        return IPEE_ERROR_CODE__ORDERED_DICTIONARY__NOT_EXISTS;
+
+    // Keys with the prefix form one run starting at its lower bound.
+    const size_t length = strlen(prefix);
+    int count = 0;
+    p_ordered_record record = find_predecessors(dict, prefix, 1, NULL);
+    for (; record && record->key && strncmp(record->key, prefix, length) == 0; record = record->next[0]) {
+        callback(record->key, record->value, args);
+        count++;
+    }
+    return count;
+}
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DEFINITIONS
+ **********************************************************************************************/
+
+static int compare_keys(const char *a, const char *b) {
+    if (!a || !b)
+        return (a != NULL) - (b != NULL);
+    return strcmp(a, b);
+}
+
+static p_ordered_record allocate_record(int level) {
+    p_ordered_record record = (p_ordered_record)malloc(
+        sizeof(ordered_record_t) + level * sizeof(p_ordered_record));
+    if (!record)
+        return NULL;
+
+    record->level = level;
+    for (int i = 0; i < level; i++)
+        record->next[i] = NULL;
+    return record;
+}
+
+static int random_level(const p_ordered_dictionary dict) {
+    dict->seed ^= dict->seed << 13;
+    dict->seed ^= dict->seed >> 17;
+    dict->seed ^= dict->seed << 5;
+
+    int level = 1;
+    uint32_t bits = dict->seed;
+    while (level < ORDERED_DICTIONARY_MAX_LEVEL && !(bits & 3)) {
+        level++;
+        bits >>= 2;
+    }
+    return level;
+}
+
+static p_ordered_record find_predecessors(
+    const p_ordered_dictionary dict, const char *key, int inclusive, p_ordered_record *update) {
+    p_ordered_record record = dict->head;
+    for (int i = dict->level - 1; i >= 0; i--) {
+        while (record->next[i]) {
+            int order = compare_keys(record->next[i]->key, key);
+            if (order > 0 || (order == 0 && inclusive))
+                break;
+            record = record->next[i];
+        }
+        if (update)
+            update[i] = record;
+    }
+    return record->next[0];
+}
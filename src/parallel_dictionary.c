@@ -0,0 +1,369 @@
+#include <parallel_dictionary.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <threadpool.h>
+
+/*********************************************************************************************
+ * MACROS DECLARATIONS
+ ********************************************************************************************/
+
+#define PARALLEL_DICTIONARY_MIN_CHUNK_SIZE 64
+
+/*********************************************************************************************
+ * STRUCTS DECLARATIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Parallel operation.
+ */
+typedef enum parallel_operation_e {
+    PARALLEL_OPERATION_MAP    = 0, // Map records.
+    PARALLEL_OPERATION_FILTER = 1, // Filter records.
+    PARALLEL_OPERATION_REDUCE = 2, // Reduce records.
+} parallel_operation_t;
+
+/**
+ * @brief Parallel job.
+ *
+ * @details
+ * Operation over the whole dictionary shared by all chunks.
+ */
+typedef struct parallel_job_s {
+    parallel_operation_t operation;                                   // Operation.
+    p_dictionary dict;                                                // Source dictionary.
+    dictionary_iteration_callback_map map;                            // Map callback.
+    dictionary_iteration_callback_map_with_args map_with_args;        // Map callback with arguments.
+    dictionary_iteration_callback_filter filter;                      // Filter callback.
+    dictionary_iteration_callback_filter_with_args filter_with_args;  // Filter callback with arguments.
+    dictionary_iteration_callback_reduce reduce;                      // Reduce callback.
+    dictionary_iteration_callback_reduce_with_args reduce_with_args;  // Reduce callback with arguments.
+    void *args;                                                       // Arguments for callback function.
+} parallel_job_t, *p_parallel_job;
+
+/**
+ * @brief Chunk of a parallel job.
+ *
+ * @details
+ * Contiguous range of records. Map and filter write surviving records into
+ * their own slice of the shared results array, reduce - into its own accumulator.
+ */
+typedef struct parallel_chunk_s {
+    p_parallel_job job;  // Parallel job.
+    p_record first;      // First record of the chunk.
+    int first_index;     // Index of the first record.
+    int count;           // Count of records in the chunk.
+    p_record results;    // Results slice.
+    int results_count;   // Count of results.
+    void *acc;           // Chunk accumulator.
+    p_task task;         // Task processing the chunk, NULL if processed by the caller.
+} parallel_chunk_t, *p_parallel_chunk;
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ **********************************************************************************************/
+
+/**
+ * @brief Run parallel job.
+ *
+ * @details
+ * Split records into chunks, process them on the thread pool and in the
+ * calling thread, and wait for all of them.
+ *
+ * @param job Parallel job.
+ * @param acc_size Size of chunk accumulators, used by reduce only.
+ * @param identity Initial value of chunk accumulators, used by reduce only.
+ * @param chunks_count Receives count of chunks.
+ * @return Processed chunks, or NULL on failure.
+ */
+static p_parallel_chunk run_parallel_job(
+    p_parallel_job job, size_t acc_size, const void *identity, int *chunks_count);
+
+/**
+ * @brief Release chunks of a parallel job.
+ *
+ * @param chunks Chunks.
+ */
+static void release_parallel_chunks(p_parallel_chunk chunks);
+
+/**
+ * @brief Process chunk of records.
+ *
+ * @param chunk Chunk.
+ * @return The chunk.
+ */
+static void *process_chunk(void *chunk);
+
+/**
+ * @brief Collect results of chunks into a new dictionary.
+ *
+ * @param chunks Chunks.
+ * @param chunks_count Count of chunks.
+ * @return Dictionary.
+ */
+static p_dictionary collect_chunks(const p_parallel_chunk chunks, int chunks_count);
+
+/**
+ * @brief Combine accumulators of chunks.
+ *
+ * @param chunks Chunks.
+ * @param chunks_count Count of chunks.
+ * @param combiner Combiner of partial accumulators.
+ * @param acc Accumulator.
+ * @return Accumulator.
+ */
+static void *combine_chunks(
+    const p_parallel_chunk chunks, int chunks_count,
+    dictionary_iteration_callback_combine combiner, void *acc);
+
+/*********************************************************************************************
+ * FUNCTIONS DEFINITIONS
+ ********************************************************************************************/
+
+p_dictionary parallel_map_dictionary(
+    const p_dictionary dict, dictionary_iteration_callback_map callback) {
+    if (!dict)
+        return NULL;
+
+    parallel_job_t job = {.operation = PARALLEL_OPERATION_MAP, .dict = dict, .map = callback};
+    int chunks_count = 0;
+    p_parallel_chunk chunks = run_parallel_job(&job, 0, NULL, &chunks_count);
+    p_dictionary new_dict = collect_chunks(chunks, chunks_count);
+    release_parallel_chunks(chunks);
+    return new_dict;
+}
+
+p_dictionary parallel_map_dictionary_with_args(
+    const p_dictionary dict, dictionary_iteration_callback_map_with_args callback, void *args) {
+    if (!dict)
+        return NULL;
+
+    parallel_job_t job = {
+        .operation = PARALLEL_OPERATION_MAP, .dict = dict, .map_with_args = callback, .args = args};
+    int chunks_count = 0;
+    p_parallel_chunk chunks = run_parallel_job(&job, 0, NULL, &chunks_count);
+    p_dictionary new_dict = collect_chunks(chunks, chunks_count);
+    release_parallel_chunks(chunks);
+    return new_dict;
+}
+
+p_dictionary parallel_filter_dictionary(
+    const p_dictionary dict, dictionary_iteration_callback_filter callback) {
+    if (!dict)
+        return NULL;
+
+    parallel_job_t job = {.operation = PARALLEL_OPERATION_FILTER, .dict = dict, .filter = callback};
+    int chunks_count = 0;
+    p_parallel_chunk chunks = run_parallel_job(&job, 0, NULL, &chunks_count);
+    p_dictionary new_dict = collect_chunks(chunks, chunks_count);
+    release_parallel_chunks(chunks);
+    return new_dict;
+}
+
+p_dictionary parallel_filter_dictionary_with_args(
+    const p_dictionary dict, dictionary_iteration_callback_filter_with_args callback, void *args) {
+    if (!dict)
+        return NULL;
+
+    parallel_job_t job = {
+        .operation = PARALLEL_OPERATION_FILTER, .dict = dict, .filter_with_args = callback, .args = args};
+    int chunks_count = 0;
+    p_parallel_chunk chunks = run_parallel_job(&job, 0, NULL, &chunks_count);
+    p_dictionary new_dict = collect_chunks(chunks, chunks_count);
+    release_parallel_chunks(chunks);
+    return new_dict;
+}
+
+void *parallel_reduce_dictionary(
+    const p_dictionary dict, dictionary_iteration_callback_reduce callback,
+    dictionary_iteration_callback_combine combiner, void *acc, size_t acc_size, const void *identity) {
+    if (!dict)
+        return NULL;
+
+    parallel_job_t job = {.operation = PARALLEL_OPERATION_REDUCE, .dict = dict, .reduce = callback};
+    int chunks_count = 0;
+    p_parallel_chunk chunks = run_parallel_job(&job, acc_size, identity, &chunks_count);
+    void *result = combine_chunks(chunks, chunks_count, combiner, acc);
+    release_parallel_chunks(chunks);
+    return result;
+}
+
+void *parallel_reduce_dictionary_with_args(
+    const p_dictionary dict, dictionary_iteration_callback_reduce_with_args callback,
+    dictionary_iteration_callback_combine combiner, void *acc, size_t acc_size,
+    const void *identity, void *args) {
+    if (!dict)
+        return NULL;
+
+    parallel_job_t job = {
+        .operation = PARALLEL_OPERATION_REDUCE, .dict = dict, .reduce_with_args = callback, .args = args};
+    int chunks_count = 0;
+    p_parallel_chunk chunks = run_parallel_job(&job, acc_size, identity, &chunks_count);
+    void *result = combine_chunks(chunks, chunks_count, combiner, acc);
+    release_parallel_chunks(chunks);
+    return result;
+}
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DEFINITIONS
+ **********************************************************************************************/
+
+static p_parallel_chunk run_parallel_job(
+    p_parallel_job job, size_t acc_size, const void *identity, int *chunks_count) {
+    const int size = job->dict->size;
+    const int workers = get_threadpool_size();
+
+    // The calling thread takes a chunk too, small dictionaries are not split at all.
+    int count = (workers > 0 ? workers : 0) + 1;
+    int max_count = (size + PARALLEL_DICTIONARY_MIN_CHUNK_SIZE - 1) / PARALLEL_DICTIONARY_MIN_CHUNK_SIZE;
+    if (count > max_count)
+        count = max_count > 0 ? max_count : 1;
+
+    p_parallel_chunk chunks = (p_parallel_chunk)calloc(count, sizeof(parallel_chunk_t));
+    if (!chunks)
+        return NULL;
+
+    // Results and accumulators of all chunks live in one block owned by the first chunk.
+    if (job->operation == PARALLEL_OPERATION_REDUCE) {
+        chunks->acc = malloc(count * acc_size);
+        if (acc_size && !chunks->acc) {
+            free(chunks);
+            return NULL;
+        }
+    } else if (size) {
+        chunks->results = (p_record)malloc(size * sizeof(record_t));
+        if (!chunks->results) {
+            free(chunks);
+            return NULL;
+        }
+    }
+
+    p_record record = job->dict->head;
+    int index = 0;
+    for (int i = 0; i < count; i++) {
+        p_parallel_chunk chunk = &chunks[i];
+        chunk->job = job;
+        chunk->first = record;
+        chunk->first_index = index;
+        chunk->count = size / count + (i < size % count);
+
+        if (job->operation == PARALLEL_OPERATION_REDUCE) {
+            chunk->acc = (char *)chunks->acc + i * acc_size;
+            if (identity)
+                memcpy(chunk->acc, identity, acc_size);
+            else
+                memset(chunk->acc, 0, acc_size);
+        } else {
+            chunk->results = chunks->results + index;
+        }
+
+        for (int j = 0; j < chunk->count; j++)
+            record = record->next;
+        index += chunk->count;
+    }
+
+    // All tasks are made before any of them runs, so the task counter is never shared with workers.
+    for (int i = 1; i < count; i++)
+        chunks[i].task = make_task(process_chunk, &chunks[i]);
+    for (int i = 1; i < count; i++) {
+        if (chunks[i].task && !try_run_task(chunks[i].task)) {
+            release_task(chunks[i].task);
+            chunks[i].task = NULL;
+        }
+    }
+
+    int failed = 0;
+    for (int i = 0; i < count; i++) {
+        if (!chunks[i].task)
+            process_chunk(&chunks[i]);
+        else if (!await_task(chunks[i].task))
+            failed = 1;
+    }
+
+    if (failed) {
+        release_parallel_chunks(chunks);
+        return NULL;
+    }
+
+    *chunks_count = count;
+    return chunks;
+}
+
+static void release_parallel_chunks(p_parallel_chunk chunks) {
+    if (!chunks)
+        return;
+
+    free(chunks->results);
+    free(chunks->acc);
+    free(chunks);
+}
+
+static void *process_chunk(void *chunk) {
+    p_parallel_chunk current = (p_parallel_chunk)chunk;
+    p_parallel_job job = current->job;
+    p_record record = current->first;
+
+    for (int i = 0; i < current->count; i++, record = record->next) {
+        int index = current->first_index + i;
+
+        switch (job->operation) {
+        case PARALLEL_OPERATION_MAP: {
+            p_record new_record = job->map
+                ? job->map(record, index, job->dict)
+                : job->map_with_args(record, index, job->dict, job->args);
+            if (new_record)
+                current->results[current->results_count++] =
+                    (record_t){.key = new_record->key, .value = new_record->value};
+            break;
+        }
+
+        case PARALLEL_OPERATION_FILTER:
+            if (job->filter
+                    ? job->filter(record, index, job->dict)
+                    : job->filter_with_args(record, index, job->dict, job->args))
+                current->results[current->results_count++] =
+                    (record_t){.key = record->key, .value = record->value};
+            break;
+
+        case PARALLEL_OPERATION_REDUCE:
+            if (job->reduce)
+                job->reduce(current->acc, record, index, job->dict);
+            else
+                job->reduce_with_args(current->acc, record, index, job->dict, job->args);
+            break;
+
+        default:
+            break;
+        }
+    }
+    return chunk;
+}
+
+static p_dictionary collect_chunks(const p_parallel_chunk chunks, int chunks_count) {
+    if (!chunks)
+        return NULL;
+
+    p_dictionary new_dict = create_dictionary();
+    if (!new_dict)
+        return NULL;
+
+    for (int i = 0; i < chunks_count; i++) {
+        if (append_records_to_dictionary(new_dict, chunks[i].results, chunks[i].results_count)) {
+            delete_dictionary(new_dict);
+            return NULL;
+        }
+    }
+    return new_dict;
+}
+
+static void *combine_chunks(
+    const p_parallel_chunk chunks, int chunks_count,
+    dictionary_iteration_callback_combine combiner, void *acc) {
+    if (!chunks)
+        return NULL;
+
+    for (int i = 0; i < chunks_count; i++)
+        combiner(acc, chunks[i].acc);
+    return acc;
+}
@@ -0,0 +1,451 @@
+#include <persistent_dictionary.h>
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <hash.h>
+
+/*********************************************************************************************
+ * STRUCTS DECLARATIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Persistent dictionary treap node.
+ *
+ * @details
+ * Node is referenced by its parents in the dictionary and in snapshots and
+ * by snapshots it is the root of. A node referenced once belongs to the
+ * dictionary alone and can be changed in place.
+ */
+typedef struct persistent_node_s {
+    struct persistent_node_s *left;  // Left subtree, keys less than node key.
+    struct persistent_node_s *right; // Right subtree, keys greater than node key.
+    char *key;                       // Record key.
+    void *value;                     // Record value.
+    uint32_t priority;               // Heap priority, hash of key.
+    atomic_int refs;                 // Count of references.
+} persistent_node_t, *p_persistent_node;
+
+struct persistent_dictionary_s {
+    p_persistent_node root;  // Root node.
+    int size;                // Count of records.
+    p_persistent_node spare; // Reserved nodes linked by left pointer.
+    int spare_count;         // Count of reserved nodes.
+};
+
+struct dictionary_snapshot_s {
+    p_persistent_node root; // Root node.
+    int size;               // Count of records.
+};
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ **********************************************************************************************/
+
+/**
+ * @brief Compare keys, NULL key is less than any other.
+ *
+ * @param a First key.
+ * @param b Second key.
+ * @return Negative, zero or positive as for strcmp.
+ */
+static int compare_keys(const char *a, const char *b);
+
+/**
+ * @brief Find node with specified key.
+ *
+ * @param node Subtree root.
+ * @param key Record key.
+ * @param depth Count of visited nodes output, may be NULL.
+ * @return Node, NULL if there is no node.
+ */
+static p_persistent_node find_node(p_persistent_node node, const char *key, int *depth);
+
+/**
+ * @brief Reserve nodes for a mutation.
+ *
+ * @details
+ * Mutation takes copies only from reserved nodes, so it either fails before
+ * changing anything or completes.
+ *
+ * @param dict Dictionary.
+ * @param count Count of nodes mutation may take.
+ * @return 0 on success, error code otherwise.
+ */
+static int reserve_nodes(const p_persistent_dictionary dict, int count);
+
+/**
+ * @brief Take reserved node.
+ *
+ * @param dict Dictionary.
+ * @return Node.
+ */
+static p_persistent_node take_node(const p_persistent_dictionary dict);
+
+/**
+ * @brief Add reference to node.
+ *
+ * @param node Node.
+ */
+static void retain_node(p_persistent_node node);
+
+/**
+ * @brief Drop reference to node, free subtree parts nobody references.
+ *
+ * @param node Node.
+ */
+static void release_node(p_persistent_node node);
+
+/**
+ * @brief Make node owned by dictionary alone.
+ *
+ * @details
+ * Shared node is replaced by a copy taking over the reference of the caller.
+ *
+ * @param dict Dictionary.
+ * @param node Node.
+ * @return Owned node.
+ */
+static p_persistent_node own_node(const p_persistent_dictionary dict, p_persistent_node node);
+
+/**
+ * @brief Insert or update record in subtree.
+ *
+ * @param dict Dictionary.
+ * @param node Subtree root.
+ * @param key Record key.
+ * @param value Record value.
+ * @param priority Record priority.
+ * @return New subtree root.
+ */
+static p_persistent_node insert_node(
+    const p_persistent_dictionary dict, p_persistent_node node, char *key, void *value, uint32_t priority);
+
+/**
+ * @brief Remove existing record from subtree.
+ *
+ * @param dict Dictionary.
+ * @param node Subtree root.
+ * @param key Record key.
+ * @param value Value of removed record output.
+ * @return New subtree root.
+ */
+static p_persistent_node remove_node(
+    const p_persistent_dictionary dict, p_persistent_node node, const char *key, void **value);
+
+/**
+ * @brief Merge subtrees, all keys of left are less than keys of right.
+ *
+ * @param dict Dictionary.
+ * @param left Left subtree.
+ * @param right Right subtree.
+ * @return Merged subtree root.
+ */
+static p_persistent_node merge_nodes(
+    const p_persistent_dictionary dict, p_persistent_node left, p_persistent_node right);
+
+/**
+ * @brief Iterate over subtree in key order.
+ *
+ * @param node Subtree root.
+ * @param callback Callback function.
+ * @param args Arguments for callback function.
+ */
+static void iterate_nodes(p_persistent_node node, dictionary_iteration_callback_with_args callback, void *args);
+
+/*********************************************************************************************
+ * FUNCTIONS DEFINITIONS
+ ********************************************************************************************/
+
+p_persistent_dictionary create_persistent_dictionary(void) {
+    return calloc(1, sizeof(persistent_dictionary_t));
+}
+
+int delete_persistent_dictionary(p_persistent_dictionary dict) {
+    if (!dict)
+        return IPEE_ERROR_CODE__PERSISTENT_DICTIONARY__NOT_EXISTS;
+
+    release_node(dict->root);
+    while (dict->spare) {
+        p_persistent_node node = dict->spare;
+        dict->spare = node->left;
+        free(node);
+    }
+
+    free(dict);
+    return 0;
+}
+
+int add_record_to_persistent_dictionary(const p_persistent_dictionary dict, char *key, void *value) {
+    if (!dict)
+        return IPEE_ERROR_CODE__PERSISTENT_DICTIONARY__NOT_EXISTS;
+
+    // Every node on the path may be shared, plus the node of a new record.
+    int depth = 0;
+    find_node(dict->root, key, &depth);
+    if (reserve_nodes(dict, depth + 1))
+        return IPEE_ERROR_CODE__PERSISTENT_DICTIONARY__RECORD_CREATION_ERROR;
+
+    const uint32_t priority = key ? hash_data(key, strlen(key)) : 0;
+    dict->root = insert_node(dict, dict->root, key, value, priority);
+    return 0;
+}
+
+void *remove_record_from_persistent_dictionary(const p_persistent_dictionary dict, char *key) {
+    if (!dict)
+        return NULL;
+
+    int depth = 0;
+    p_persistent_node node = find_node(dict->root, key, &depth);
+    if (!node)
+        return NULL;
+
+    // Path above the record and the spines merged in its place may be shared.
+    for (p_persistent_node spine = node->left; spine; spine = spine->right)
+        depth++;
+    for (p_persistent_node spine = node->right; spine; spine = spine->left)
+        depth++;
+    if (reserve_nodes(dict, depth))
+        return NULL;
+
+    void *value = NULL;
+    dict->root = remove_node(dict, dict->root, key, &value);
+    return value;
+}
+
+void *get_value_from_persistent_dictionary(const p_persistent_dictionary dict, char *key) {
+    if (!dict)
+        return NULL;
+
+    p_persistent_node node = find_node(dict->root, key, NULL);
+    return node ? node->value : NULL;
+}
+
+int get_persistent_dictionary_size(const p_persistent_dictionary dict) {
+    if (!dict)
+        return IPEE_ERROR_CODE__PERSISTENT_DICTIONARY__NOT_EXISTS;
+
+    return dict->size;
+}
+
+p_dictionary_snapshot snapshot_dictionary(const p_persistent_dictionary dict) {
+    if (!dict)
+        return NULL;
+
+    p_dictionary_snapshot snapshot = malloc(sizeof(dictionary_snapshot_t));
+    if (!snapshot)
+        return NULL;
+
+    retain_node(dict->root);
+    snapshot->root = dict->root;
+    snapshot->size = dict->size;
+
+    return snapshot;
+}
+
+int release_dictionary_snapshot(p_dictionary_snapshot snapshot) {
+    if (!snapshot)
+        return IPEE_ERROR_CODE__PERSISTENT_DICTIONARY__SNAPSHOT_NOT_EXISTS;
+
+    release_node(snapshot->root);
+    free(snapshot);
+    return 0;
+}
+
+void *get_value_from_dictionary_snapshot(const p_dictionary_snapshot snapshot, char *key) {
+    if (!snapshot)
+        return NULL;
+
+    p_persistent_node node = find_node(snapshot->root, key, NULL);
+    return node ? node->value : NULL;
+}
+
+int get_dictionary_snapshot_size(const p_dictionary_snapshot snapshot) {
+    if (!snapshot)
+        return IPEE_ERROR_CODE__PERSISTENT_DICTIONARY__SNAPSHOT_NOT_EXISTS;
+
+    return snapshot->size;
+}
+
+int iterate_over_dictionary_snapshot_with_args(
+    const p_dictionary_snapshot snapshot, dictionary_iteration_callback_with_args callback, void *args) {
+    if (!snapshot)
+        return IPEE_ERROR_CODE__PERSISTENT_DICTIONARY__SNAPSHOT_NOT_EXISTS;
+
+    iterate_nodes(snapshot->root, callback, args);
+    return 0;
+}
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DEFINITIONS
+ **********************************************************************************************/
+
+static int compare_keys(const char *a, const char *b) {
+    if (a == b)
+        return 0;
+    if (!a)
+        return -1;
+    if (!b)
+        return 1;
+    return strcmp(a, b);
+}
+
+static p_persistent_node find_node(p_persistent_node node, const char *key, int *depth) {
+    while (node) {
+        if (depth)
+            (*depth)++;
+
+        const int cmp = compare_keys(key, node->key);
+        if (!cmp)
+            return node;
+        node = cmp < 0 ? node->left : node->right;
+    }
+
+    return NULL;
+}
+
+static int reserve_nodes(const p_persistent_dictionary dict, int count) {
+    while (dict->spare_count < count) {
+        p_persistent_node node = malloc(sizeof(persistent_node_t));
+        if (!node)
+            return IPEE_ERROR_CODE__PERSISTENT_DICTIONARY__RECORD_CREATION_ERROR;
+
+        node->left = dict->spare;
+        dict->spare = node;
+        dict->spare_count++;
+    }
+
+    return 0;
+}
+
+static p_persistent_node take_node(const p_persistent_dictionary dict) {
+    p_persistent_node node = dict->spare;
+    dict->spare = node->left;
+    dict->spare_count--;
+    return node;
+}
+
+static void retain_node(p_persistent_node node) {
+    if (node)
+        atomic_fetch_add_explicit(&node->refs, 1, memory_order_relaxed);
+}
+
+static void release_node(p_persistent_node node) {
+    while (node && atomic_fetch_sub_explicit(&node->refs, 1, memory_order_acq_rel) == 1) {
+        release_node(node->left);
+        p_persistent_node right = node->right;
+        free(node);
+        node = right;
+    }
+}
+
+static p_persistent_node own_node(const p_persistent_dictionary dict, p_persistent_node node) {
+    if (atomic_load_explicit(&node->refs, memory_order_acquire) == 1)
+        return node;
+
+    p_persistent_node copy = take_node(dict);
+    copy->left = node->left;
+    copy->right = node->right;
+    copy->key = node->key;
+    copy->value = node->value;
+    copy->priority = node->priority;
+    atomic_init(&copy->refs, 1);
+    retain_node(copy->left);
+    retain_node(copy->right);
+    release_node(node);
+
+    return copy;
+}
+
+static p_persistent_node insert_node(
+    const p_persistent_dictionary dict, p_persistent_node node, char *key, void *value, uint32_t priority) {
+    if (!node) {
+        node = take_node(dict);
+        node->left = NULL;
+        node->right = NULL;
+        node->key = key;
+        node->value = value;
+        node->priority = priority;
+        atomic_init(&node->refs, 1);
+        dict->size++;
+        return node;
+    }
+
+    node = own_node(dict, node);
+    const int cmp = compare_keys(key, node->key);
+    if (!cmp) {
+        node->value = value;
+    } else if (cmp < 0) {
+        node->left = insert_node(dict, node->left, key, value, priority);
+        if (node->left->priority > node->priority) {
+            p_persistent_node left = node->left;
+            node->left = left->right;
+            left->right = node;
+            node = left;
+        }
+    } else {
+        node->right = insert_node(dict, node->right, key, value, priority);
+        if (node->right->priority > node->priority) {
+            p_persistent_node right = node->right;
+            node->right = right->left;
+            right->left = node;
+            node = right;
+        }
+    }
+
+    return node;
+}
+
+static p_persistent_node remove_node(
+    const p_persistent_dictionary dict, p_persistent_node node, const char *key, void **value) {
+    const int cmp = compare_keys(key, node->key);
+    if (cmp) {
+        node = own_node(dict, node);
+        if (cmp < 0)
+            node->left = remove_node(dict, node->left, key, value);
+        else
+            node->right = remove_node(dict, node->right, key, value);
+        return node;
+    }
+
+    *value = node->value;
+    p_persistent_node left = node->left;
+    p_persistent_node right = node->right;
+    if (atomic_load_explicit(&node->refs, memory_order_acquire) == 1) {
+        free(node);
+    } else {
+        retain_node(left);
+        retain_node(right);
+        release_node(node);
+    }
+    dict->size--;
+
+    return merge_nodes(dict, left, right);
+}
+
+static p_persistent_node merge_nodes(
+    const p_persistent_dictionary dict, p_persistent_node left, p_persistent_node right) {
+    if (!left)
+        return right;
+    if (!right)
+        return left;
+
+    if (left->priority > right->priority) {
+        left = own_node(dict, left);
+        left->right = merge_nodes(dict, left->right, right);
+        return left;
+    }
+
+    right = own_node(dict, right);
+    right->left = merge_nodes(dict, left, right->left);
+    return right;
+}
+
+static void iterate_nodes(p_persistent_node node, dictionary_iteration_callback_with_args callback, void *args) {
+    while (node) {
+        iterate_nodes(node->left, callback, args);
+        callback(node->key, node->value, args);
+        node = node->right;
+    }
+}
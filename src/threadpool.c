@@ -32,6 +32,16 @@ static void *task_invoker(p_thread thread);
  */
 static void set_task_to_thread(p_thread thread, p_task task);
 
+/**
+ * @brief Give task to the first idle thread.
+ *
+ * @param task The task.
+ * @param args Task arguments.
+ * @param deadline Time to wait for an idle thread until, NULL to not wait.
+ * @return Task, NULL if no thread became idle in time.
+ */
+static p_task dispatch_task(p_task task, void *args, const struct timespec *deadline);
+
 /**
  * @brief Filter available threads.
  *
@@ -63,6 +73,16 @@ static void destroy_thread(const p_thread thread);
  */
 static void emit_on_complete(p_task task);
 
+/**
+ * @brief Unlock mutex.
+ *
+ * @details
+ * Cleanup handler for cancelled threads.
+ *
+ * @param mutex The mutex.
+ */
+static void unlock_mutex(void *mutex);
+
 /*********************************************************************************************
  * STATIC VARIABLES
  ********************************************************************************************/
@@ -119,6 +139,12 @@ int set_threadpool_size(int size) {
     return 0;
 }
 
+int get_threadpool_size(void) {
+    if (!thread_pool)
+        return IPEE_ERROR_CODE__THREADPOOL__SERVICE_UNINITIALIZED;
+    return thread_pool->size;
+}
+
 int set_internal_task_counter_limit(int limit) {
     if (thread_pool)
         return IPEE_ERROR_CODE__THREADPOOL__SERVICE_ALREADY_INITIALIZED;
@@ -135,7 +161,7 @@ int init_thread_pool(void) {
         return 0;
 
     pthread_mutex_init(&mutex, NULL);
-    thread_pool = create_dictionary();
+    thread_pool = create_int_dictionary();
     task_bitset = init_bitset(INTERNAL_TASK_COUNTER_LIMIT);
 
     for (int i = 0; i < THREAD_POOL_SIZE; i++) {
@@ -153,7 +179,7 @@ int init_thread_pool(void) {
         pthread_cond_init(&thread->cond, NULL);
 
         pthread_create(&thread->thread, NULL, task_invoker, thread);
-        add_record_to_dictionary(thread_pool, i, thread);
+        add_record_to_int_dictionary(thread_pool, i, thread);
 
         pthread_mutex_unlock(&mutex);
     }
@@ -186,7 +212,7 @@ p_task make_task(threadpool_task_callback callback, void *args) {
     set_bit(task_bitset, internal_task_counter);
 
     metadata->task_id = internal_task_counter;
-    metadata->task_event_name = prepare_event_name(
+    format_event_name(metadata->task_event_name, sizeof(metadata->task_event_name),
         threadpool_context_name, threadpool_complete_event_name, metadata->task_id);
     metadata->callback = callback;
     metadata->args = args;
@@ -207,8 +233,6 @@ p_task run_task_with_args(p_task task, void *args) {
     if (!thread_pool || !task)
         return NULL;
 
-    pthread_mutex_lock(&mutex);
-
     struct timespec deadline;
     clock_gettime(CLOCK_REALTIME, &deadline);
     deadline.tv_sec  += TASK_WAITING_TIMEOUT / 1000;
@@ -218,29 +242,14 @@ p_task run_task_with_args(p_task task, void *args) {
         deadline.tv_nsec -= 1000000000L;
     }
 
-    p_dictionary available_threads = filter_dictionary(thread_pool, filter_threads);
-    while (!available_threads->size) {
-        delete_dictionary(available_threads);
-        if (pthread_cond_timedwait(&pool_cond, &mutex, &deadline) == ETIMEDOUT) {
-            pthread_mutex_unlock(&mutex);
-            return NULL;
-        }
-        available_threads = filter_dictionary(thread_pool, filter_threads);
-    }
-
-    task->metadata->args = args;
-    p_thread thread = get_head_value_from_dictionary(available_threads);
-    delete_dictionary(available_threads);
+    return dispatch_task(task, args, &deadline);
+}
 
-    if (!thread) {
-        pthread_mutex_unlock(&mutex);
+p_task try_run_task(p_task task) {
+    if (!thread_pool || !task)
         return NULL;
-    }
-    set_task_to_thread(thread, task);
-
-    pthread_mutex_unlock(&mutex);
 
-    return task;
+    return dispatch_task(task, task->metadata->args, NULL);
 }
 
 p_task start_task(threadpool_task_callback callback, void *args) {
@@ -279,6 +288,15 @@ void *await_task(p_task task) {
     return result;
 }
 
+int release_task(p_task task) {
+    if (!task || !task->metadata || task->is_running)
+        return IPEE_ERROR_CODE__THREADPOOL__INVALID_TASK;
+
+    if (task->metadata->release_callback)
+        task->metadata->release_callback(task);
+    return 0;
+}
+
 int cancel_task(p_task task) {
     if (!thread_pool)
         return IPEE_ERROR_CODE__THREADPOOL__SERVICE_UNINITIALIZED;
@@ -367,8 +385,12 @@ static void *task_invoker(p_thread thread) {
 
     pthread_mutex_lock(&mutex);
     while (thread->is_running) {
-        while (thread->is_running && !thread->task)
+        while (thread->is_running && !thread->task) {
+            // Cancellation inside the wait reacquires the mutex, release it on the way out.
+            pthread_cleanup_push(unlock_mutex, &mutex);
             pthread_cond_wait(&thread->cond, &mutex);
+            pthread_cleanup_pop(0);
+        }
 
         if (!thread->task)
             break;
@@ -410,6 +432,35 @@ static void set_task_to_thread(p_thread thread, p_task task) {
     pthread_cond_signal(&thread->cond);
 }
 
+static p_task dispatch_task(p_task task, void *args, const struct timespec *deadline) {
+    pthread_mutex_lock(&mutex);
+
+    dictionary_query_t available_threads;
+    filter_dictionary_query(init_dictionary_query(&available_threads, thread_pool), filter_threads);
+
+    p_record available_thread = get_first_record_from_dictionary_query(&available_threads);
+    while (!available_thread) {
+        if (!deadline || pthread_cond_timedwait(&pool_cond, &mutex, deadline) == ETIMEDOUT) {
+            pthread_mutex_unlock(&mutex);
+            return NULL;
+        }
+        available_thread = get_first_record_from_dictionary_query(&available_threads);
+    }
+
+    task->metadata->args = args;
+    p_thread thread = available_thread->value;
+
+    if (!thread) {
+        pthread_mutex_unlock(&mutex);
+        return NULL;
+    }
+    set_task_to_thread(thread, task);
+
+    pthread_mutex_unlock(&mutex);
+
+    return task;
+}
+
 static int filter_threads(const p_record record, int _1, const p_dictionary _2) {
     if (!record || !record->value)
         return 0;
@@ -437,8 +488,6 @@ static void default_task_release_callback(p_task task) {
         return;
 
     p_task_metadata metadata = task->metadata;
-    free(task->metadata->task_event_name);
-    task->metadata->task_event_name = NULL;
     task->metadata->thread = NULL;
     reset_bit(task_bitset, task->metadata->task_id);
     free(metadata);
@@ -461,3 +510,7 @@ static void emit_on_complete(p_task task) {
         unsubscribe_from_event(threadpool_context_name, event_name);
     }
 }
+
+static void unlock_mutex(void *mutex) {
+    pthread_mutex_unlock((pthread_mutex_t *)mutex);
+}
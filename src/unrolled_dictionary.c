@@ -0,0 +1,571 @@
+#include <unrolled_dictionary.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+/*********************************************************************************************
+ * MACROS DECLARATIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Minimal count of records in a node that is not the only one.
+ */
+#define UNROLLED_DICTIONARY_MIN_COUNT (UNROLLED_DICTIONARY_BLOCK_SIZE / 2)
+
+/**
+ * @brief Make temporary record view of a slot.
+ */
+#define unrolled_dictionary_record(node, slot) \
+    ((record_t){.key = (node)->keys[slot], .value = (node)->values[slot], \
+                .metadata = (node)->records_metadata[slot]})
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ **********************************************************************************************/
+
+/**
+ * @brief Create empty node and link it after specified node.
+ *
+ * @param dict Unrolled dictionary.
+ * @param after Node to link after, NULL to link at the head.
+ * @return Node, or NULL on allocation failure.
+ */
+static p_unrolled_dictionary_node create_node(const p_unrolled_dictionary dict, p_unrolled_dictionary_node after);
+
+/**
+ * @brief Unlink and free node.
+ *
+ * @param dict Unrolled dictionary.
+ * @param node Node.
+ */
+static void delete_node(const p_unrolled_dictionary dict, p_unrolled_dictionary_node node);
+
+/**
+ * @brief Move records of a slot range between nodes.
+ *
+ * @param to Destination node.
+ * @param to_slot Destination slot.
+ * @param from Source node.
+ * @param from_slot Source slot.
+ * @param count Count of records.
+ */
+static void move_slots(
+    p_unrolled_dictionary_node to, int to_slot, p_unrolled_dictionary_node from, int from_slot, int count);
+
+/**
+ * @brief Find slot of first matching key.
+ *
+ * @param dict Unrolled dictionary.
+ * @param key Record key.
+ * @param node Node output.
+ * @return Slot index, or -1.
+ */
+static int find_key_slot(const p_unrolled_dictionary dict, const char *key, p_unrolled_dictionary_node *node);
+
+/**
+ * @brief Find slot of record by index.
+ *
+ * @details
+ * Walk from the closer end of the list, skipping whole nodes.
+ *
+ * @param dict Unrolled dictionary.
+ * @param index Record index, size is allowed and yields the slot past the last record.
+ * @param node Node output.
+ * @return Slot index, or -1.
+ */
+static int find_index_slot(const p_unrolled_dictionary dict, int index, p_unrolled_dictionary_node *node);
+
+/**
+ * @brief Insert record into a slot.
+ *
+ * @details
+ * Full node is split in halves first.
+ *
+ * @param dict Unrolled dictionary.
+ * @param node Node.
+ * @param slot Slot index.
+ * @param key Record key.
+ * @param value Record value.
+ * @param metadata Record metadata.
+ * @return 0 on success, or a negative error code.
+ */
+static int insert_slot(const p_unrolled_dictionary dict, p_unrolled_dictionary_node node, int slot,
+                       char *key, void *value, void *metadata);
+
+/**
+ * @brief Remove record from a slot.
+ *
+ * @details
+ * Underfilled node takes records of the next node, or is merged into a
+ * neighbour when both fit into one block.
+ *
+ * @param dict Unrolled dictionary.
+ * @param node Node.
+ * @param slot Slot index.
+ * @return Value of removed record.
+ */
+static void *remove_slot(const p_unrolled_dictionary dict, p_unrolled_dictionary_node node, int slot);
+
+/*********************************************************************************************
+ * FUNCTIONS DEFINITIONS
+ ********************************************************************************************/
+
+p_unrolled_dictionary create_unrolled_dictionary(void) {
+    return create_unrolled_dictionary_with_metadata(NULL);
+}
+
+p_unrolled_dictionary create_unrolled_dictionary_with_metadata(void *metadata) {
+    p_unrolled_dictionary dict = (p_unrolled_dictionary)malloc(sizeof(unrolled_dictionary_t));
+    if (!dict)
+        return NULL;
+
+    dict->head = NULL;
+    dict->tail = NULL;
+    dict->size = 0;
+    dict->nodes = 0;
+    dict->metadata = metadata;
+    return dict;
+}
+
+int delete_unrolled_dictionary(p_unrolled_dictionary dict) {
+    if (!dict)
+        return IPEE_ERROR_CODE__UNROLLED_DICTIONARY__NOT_EXISTS;
+
+    p_unrolled_dictionary_node node = dict->head;
+    while (node) {
+        p_unrolled_dictionary_node next = node->next;
+        free(node);
+        node = next;
+    }
+    free(dict);
+    return 0;
+}
+
+int add_record_to_unrolled_dictionary(const p_unrolled_dictionary dict, char *key, void *value) {
+    return add_record_to_unrolled_dictionary_with_metadata(dict, key, value, NULL);
+}
+
+int add_record_to_unrolled_dictionary_with_metadata(
+    const p_unrolled_dictionary dict, char *key, void *value, void *metadata) {
+    if (!dict)
+        return IPEE_ERROR_CODE__UNROLLED_DICTIONARY__NOT_EXISTS;
+
+    // Appending never splits, a full tail is followed by a new node.
+    p_unrolled_dictionary_node node = dict->tail;
+    if (!node || node->count == UNROLLED_DICTIONARY_BLOCK_SIZE) {
+        node = create_node(dict, dict->tail);
+        if (!node)
+            return IPEE_ERROR_CODE__UNROLLED_DICTIONARY__ALLOCATION_ERROR;
+    }
+
+    int slot = node->count++;
+    node->keys[slot] = key;
+    node->values[slot] = value;
+    node->records_metadata[slot] = metadata;
+    dict->size++;
+    return 0;
+}
+
+int emplace_record_to_unrolled_dictionary(const p_unrolled_dictionary dict, char *key, void *value) {
+    return add_record_to_unrolled_dictionary_by_index_with_metadata(dict, 0, key, value, NULL);
+}
+
+int add_record_to_unrolled_dictionary_by_index(
+    const p_unrolled_dictionary dict, int index, char *key, void *value) {
+    return add_record_to_unrolled_dictionary_by_index_with_metadata(dict, index, key, value, NULL);
+}
+
+int add_record_to_unrolled_dictionary_by_index_with_metadata(
+    const p_unrolled_dictionary dict, int index, char *key, void *value, void *metadata) {
+    if (!dict)
+        return IPEE_ERROR_CODE__UNROLLED_DICTIONARY__NOT_EXISTS;
+    if (index < 0 || index > dict->size)
+        return IPEE_ERROR_CODE__UNROLLED_DICTIONARY__INDEX_OUT_OF_RANGE;
+    if (index == dict->size)
+        return add_record_to_unrolled_dictionary_with_metadata(dict, key, value, metadata);
+
+    p_unrolled_dictionary_node node = NULL;
+    int slot = find_index_slot(dict, index, &node);
+    return insert_slot(dict, node, slot, key, value, metadata);
+}
+
+void *remove_record_from_unrolled_dictionary(const p_unrolled_dictionary dict, char *key) {
+    p_unrolled_dictionary_node node = NULL;
+    int slot = find_key_slot(dict, key, &node);
+    return slot < 0 ? NULL : remove_slot(dict, node, slot);
+}
+
+void *remove_record_from_unrolled_dictionary_by_index(const p_unrolled_dictionary dict, int index) {
+    if (!dict || index >= dict->size)
+        return NULL;
+
+    p_unrolled_dictionary_node node = NULL;
+    int slot = find_index_slot(dict, index, &node);
+    return slot < 0 ? NULL : remove_slot(dict, node, slot);
+}
+
+void *update_record_in_unrolled_dictionary(const p_unrolled_dictionary dict, char *key, void *value) {
+    p_unrolled_dictionary_node node = NULL;
+    int slot = find_key_slot(dict, key, &node);
+    if (slot < 0)
+        return NULL;
+
+    void *old_value = node->values[slot];
+    node->values[slot] = value;
+    return old_value;
+}
+
+void *update_record_in_unrolled_dictionary_by_index(
+    const p_unrolled_dictionary dict, int index, void *value) {
+    if (!dict || index >= dict->size)
+        return NULL;
+
+    p_unrolled_dictionary_node node = NULL;
+    int slot = find_index_slot(dict, index, &node);
+    if (slot < 0)
+        return NULL;
+
+    void *old_value = node->values[slot];
+    node->values[slot] = value;
+    return old_value;
+}
+
+int contains_key_in_unrolled_dictionary(const p_unrolled_dictionary dict, char *key) {
+    p_unrolled_dictionary_node node = NULL;
+    return find_key_slot(dict, key, &node) >= 0;
+}
+
+int contains_value_in_unrolled_dictionary(const p_unrolled_dictionary dict, void *value) {
+    if (!dict)
+        return 0;
+
+    for (p_unrolled_dictionary_node node = dict->head; node; node = node->next) {
+        for (int slot = 0; slot < node->count; slot++) {
+            if (node->values[slot] == value)
+                return 1;
+        }
+    }
+    return 0;
+}
+
+void *get_value_from_unrolled_dictionary(const p_unrolled_dictionary dict, char *key) {
+    p_unrolled_dictionary_node node = NULL;
+    int slot = find_key_slot(dict, key, &node);
+    return slot < 0 ? NULL : node->values[slot];
+}
+
+void *get_value_from_unrolled_dictionary_by_index(const p_unrolled_dictionary dict, int index) {
+    if (!dict || index >= dict->size)
+        return NULL;
+
+    p_unrolled_dictionary_node node = NULL;
+    int slot = find_index_slot(dict, index, &node);
+    return slot < 0 ? NULL : node->values[slot];
+}
+
+char *get_key_from_unrolled_dictionary_by_index(const p_unrolled_dictionary dict, int index) {
+    if (!dict || index >= dict->size)
+        return NULL;
+
+    p_unrolled_dictionary_node node = NULL;
+    int slot = find_index_slot(dict, index, &node);
+    return slot < 0 ? NULL : node->keys[slot];
+}
+
+int get_index_from_unrolled_dictionary_by_key(const p_unrolled_dictionary dict, char *key) {
+    if (!dict)
+        return IPEE_ERROR_CODE__UNROLLED_DICTIONARY__NOT_EXISTS;
+
+    int index = 0;
+    for (p_unrolled_dictionary_node node = dict->head; node; node = node->next) {
+        for (int slot = 0; slot < node->count; slot++) {
+            if (strcmp(node->keys[slot], key) == 0)
+                return index + slot;
+        }
+        index += node->count;
+    }
+    return -1;
+}
+
+int iterate_over_unrolled_dictionary(
+    const p_unrolled_dictionary dict, dictionary_iteration_callback callback) {
+    if (!dict)
+        return IPEE_ERROR_CODE__UNROLLED_DICTIONARY__NOT_EXISTS;
+
+    for (p_unrolled_dictionary_node node = dict->head; node; node = node->next) {
+        for (int slot = 0; slot < node->count; slot++)
+            callback(node->keys[slot], node->values[slot]);
+    }
+    return 0;
+}
+
+int iterate_over_unrolled_dictionary_with_args(
+    const p_unrolled_dictionary dict, dictionary_iteration_callback_with_args callback, void *args) {
+    if (!dict)
+        return IPEE_ERROR_CODE__UNROLLED_DICTIONARY__NOT_EXISTS;
+
+    for (p_unrolled_dictionary_node node = dict->head; node; node = node->next) {
+        for (int slot = 0; slot < node->count; slot++)
+            callback(node->keys[slot], node->values[slot], args);
+    }
+    return 0;
+}
+
+int iterate_over_unrolled_dictionary_keys(
+    const p_unrolled_dictionary dict, dictionary_iteration_keys_callback callback) {
+    if (!dict)
+        return IPEE_ERROR_CODE__UNROLLED_DICTIONARY__NOT_EXISTS;
+
+    for (p_unrolled_dictionary_node node = dict->head; node; node = node->next) {
+        for (int slot = 0; slot < node->count; slot++)
+            callback(node->keys[slot]);
+    }
+    return 0;
+}
+
+int iterate_over_unrolled_dictionary_keys_with_args(
+    const p_unrolled_dictionary dict, dictionary_iteration_keys_callback_with_args callback, void *args) {
+    if (!dict)
+        return IPEE_ERROR_CODE__UNROLLED_DICTIONARY__NOT_EXISTS;
+
+    for (p_unrolled_dictionary_node node = dict->head; node; node = node->next) {
+        for (int slot = 0; slot < node->count; slot++)
+            callback(node->keys[slot], args);
+    }
+    return 0;
+}
+
+int iterate_over_unrolled_dictionary_values(
+    const p_unrolled_dictionary dict, dictionary_iteration_values_callback callback) {
+    if (!dict)
+        return IPEE_ERROR_CODE__UNROLLED_DICTIONARY__NOT_EXISTS;
+
+    for (p_unrolled_dictionary_node node = dict->head; node; node = node->next) {
+        for (int slot = 0; slot < node->count; slot++)
+            callback(node->values[slot]);
+    }
+    return 0;
+}
+
+int iterate_over_unrolled_dictionary_values_with_args(
+    const p_unrolled_dictionary dict, dictionary_iteration_values_callback_with_args callback, void *args) {
+    if (!dict)
+        return IPEE_ERROR_CODE__UNROLLED_DICTIONARY__NOT_EXISTS;
+
+    for (p_unrolled_dictionary_node node = dict->head; node; node = node->next) {
+        for (int slot = 0; slot < node->count; slot++)
+            callback(node->values[slot], args);
+    }
+    return 0;
+}
+
+p_unrolled_dictionary filter_unrolled_dictionary(
+    const p_unrolled_dictionary dict, unrolled_dictionary_iteration_callback_filter callback) {
+    if (!dict)
+        return NULL;
+
+    p_unrolled_dictionary new_dict = create_unrolled_dictionary();
+    int index = 0;
+    for (p_unrolled_dictionary_node node = dict->head; node; node = node->next) {
+        for (int slot = 0; slot < node->count; slot++) {
+            record_t record = unrolled_dictionary_record(node, slot);
+            if (callback(&record, index++, dict))
+                add_record_to_unrolled_dictionary(new_dict, node->keys[slot], node->values[slot]);
+        }
+    }
+    return new_dict;
+}
+
+p_unrolled_dictionary filter_unrolled_dictionary_with_args(
+    const p_unrolled_dictionary dict,
+    unrolled_dictionary_iteration_callback_filter_with_args callback, void *args) {
+    if (!dict)
+        return NULL;
+
+    p_unrolled_dictionary new_dict = create_unrolled_dictionary();
+    int index = 0;
+    for (p_unrolled_dictionary_node node = dict->head; node; node = node->next) {
+        for (int slot = 0; slot < node->count; slot++) {
+            record_t record = unrolled_dictionary_record(node, slot);
+            if (callback(&record, index++, dict, args))
+                add_record_to_unrolled_dictionary(new_dict, node->keys[slot], node->values[slot]);
+        }
+    }
+    return new_dict;
+}
+
+void *reduce_unrolled_dictionary(
+    const p_unrolled_dictionary dict, unrolled_dictionary_iteration_callback_reduce callback, void *acc) {
+    if (!dict)
+        return NULL;
+
+    int index = 0;
+    for (p_unrolled_dictionary_node node = dict->head; node; node = node->next) {
+        for (int slot = 0; slot < node->count; slot++) {
+            record_t record = unrolled_dictionary_record(node, slot);
+            callback(acc, &record, index++, dict);
+        }
+    }
+    return acc;
+}
+
+void *reduce_unrolled_dictionary_with_args(
+    const p_unrolled_dictionary dict,
+    unrolled_dictionary_iteration_callback_reduce_with_args callback, void *acc, void *args) {
+    if (!dict)
+        return NULL;
+
+    int index = 0;
+    for (p_unrolled_dictionary_node node = dict->head; node; node = node->next) {
+        for (int slot = 0; slot < node->count; slot++) {
+            record_t record = unrolled_dictionary_record(node, slot);
+            callback(acc, &record, index++, dict, args);
+        }
+    }
+    return acc;
+}
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DEFINITIONS
+ **********************************************************************************************/
+
+static p_unrolled_dictionary_node create_node(const p_unrolled_dictionary dict, p_unrolled_dictionary_node after) {
+    p_unrolled_dictionary_node node = (p_unrolled_dictionary_node)malloc(sizeof(unrolled_dictionary_node_t));
+    if (!node)
+        return NULL;
+
+    node->count = 0;
+    node->prev = after;
+    node->next = after ? after->next : dict->head;
+    if (node->next)
+        node->next->prev = node;
+    else
+        dict->tail = node;
+    if (after)
+        after->next = node;
+    else
+        dict->head = node;
+
+    dict->nodes++;
+    return node;
+}
+
+static void delete_node(const p_unrolled_dictionary dict, p_unrolled_dictionary_node node) {
+    if (node->prev)
+        node->prev->next = node->next;
+    else
+        dict->head = node->next;
+    if (node->next)
+        node->next->prev = node->prev;
+    else
+        dict->tail = node->prev;
+
+    dict->nodes--;
+    free(node);
+}
+
+static void move_slots(
+    p_unrolled_dictionary_node to, int to_slot, p_unrolled_dictionary_node from, int from_slot, int count) {
+    memmove(&to->keys[to_slot], &from->keys[from_slot], count * sizeof(char *));
+    memmove(&to->values[to_slot], &from->values[from_slot], count * sizeof(void *));
+    memmove(&to->records_metadata[to_slot], &from->records_metadata[from_slot], count * sizeof(void *));
+}
+
+static int find_key_slot(const p_unrolled_dictionary dict, const char *key, p_unrolled_dictionary_node *node) {
+    if (!dict)
+        return -1;
+
+    for (p_unrolled_dictionary_node current = dict->head; current; current = current->next) {
+        for (int slot = 0; slot < current->count; slot++) {
+            if (strcmp(current->keys[slot], key) == 0) {
+                *node = current;
+                return slot;
+            }
+        }
+    }
+    return -1;
+}
+
+static int find_index_slot(const p_unrolled_dictionary dict, int index, p_unrolled_dictionary_node *node) {
+    if (!dict || index < 0 || index > dict->size || !dict->head)
+        return -1;
+
+    p_unrolled_dictionary_node current = NULL;
+    if (index < dict->size / 2) {
+        current = dict->head;
+        while (index >= current->count) {
+            index -= current->count;
+            current = current->next;
+        }
+    } else {
+        index = dict->size - index;
+        current = dict->tail;
+        while (index > current->count) {
+            index -= current->count;
+            current = current->prev;
+        }
+        index = current->count - index;
+    }
+
+    *node = current;
+    return index;
+}
+
+static int insert_slot(const p_unrolled_dictionary dict, p_unrolled_dictionary_node node, int slot,
+                       char *key, void *value, void *metadata) {
+    if (node->count == UNROLLED_DICTIONARY_BLOCK_SIZE) {
+        p_unrolled_dictionary_node next = create_node(dict, node);
+        if (!next)
+            return IPEE_ERROR_CODE__UNROLLED_DICTIONARY__ALLOCATION_ERROR;
+
+        int half = UNROLLED_DICTIONARY_BLOCK_SIZE / 2;
+        move_slots(next, 0, node, half, node->count - half);
+        next->count = node->count - half;
+        node->count = half;
+        if (slot > half) {
+            node = next;
+            slot -= half;
+        }
+    }
+
+    move_slots(node, slot + 1, node, slot, node->count - slot);
+    node->keys[slot] = key;
+    node->values[slot] = value;
+    node->records_metadata[slot] = metadata;
+    node->count++;
+    dict->size++;
+    return 0;
+}
+
+static void *remove_slot(const p_unrolled_dictionary dict, p_unrolled_dictionary_node node, int slot) {
+    void *removed_value = node->values[slot];
+    move_slots(node, slot, node, slot + 1, node->count - slot - 1);
+    node->count--;
+    dict->size--;
+
+    if (!node->count) {
+        delete_node(dict, node);
+        return removed_value;
+    }
+    if (node->count >= UNROLLED_DICTIONARY_MIN_COUNT)
+        return removed_value;
+
+    p_unrolled_dictionary_node next = node->next;
+    if (next && node->count + next->count <= UNROLLED_DICTIONARY_BLOCK_SIZE) {
+        move_slots(node, node->count, next, 0, next->count);
+        node->count += next->count;
+        delete_node(dict, next);
+    } else if (next) {
+        // Take one record from the next node, which stays at least half full.
+        move_slots(node, node->count, next, 0, 1);
+        move_slots(next, 0, next, 1, next->count - 1);
+        node->count++;
+        next->count--;
+    } else if (node->prev && node->prev->count + node->count <= UNROLLED_DICTIONARY_BLOCK_SIZE) {
+        p_unrolled_dictionary_node prev = node->prev;
+        move_slots(prev, prev->count, node, 0, node->count);
+        prev->count += node->count;
+        delete_node(dict, node);
+    }
+    return removed_value;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file array_dictionary.test.c
+ * @author chcp (cmewhou@yandex.ru)
+ * @brief Array dictionary tests
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#include "utils/helper.h"
+
+#include <array_dictionary.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ **********************************************************************************************/
+
+/**
+ * @brief Filter records with even values.
+ *
+ * @param record Record.
+ * @param index Record index.
+ * @param dict Array dictionary.
+ * @return 1 if value is even, 0 otherwise.
+ */
+static int filter_even_callback(const p_record record, int index, const p_array_dictionary dict);
+
+/**
+ * @brief Sum record values.
+ *
+ * @param acc Accumulator.
+ * @param record Record.
+ * @param index Record index.
+ * @param dict Array dictionary.
+ */
+static void reduce_sum_callback(
+    void *acc, const p_record record, int index, const p_array_dictionary dict);
+
+/*********************************************************************************************
+ * FUNCTIONS DECLARATIONS
+ ********************************************************************************************/
+
+/** @brief Array dictionary initialisation test. */
+int array_dictionary_getValidValue_OK(void);
+
+/** @brief Array dictionary removal and compaction test. */
+int array_dictionary_removeCompact_OK(void);
+
+/** @brief Array dictionary filter and reduce test. */
+int array_dictionary_filterReduce_OK(void);
+
+/*********************************************************************************************
+ * FUNCTIONS DEFINITIONS
+ ********************************************************************************************/
+
+int array_dictionary_test(int argc, char *argv[]) {
+    int exit_result = 0;
+
+    exit_result |= array_dictionary_getValidValue_OK();
+    exit_result |= array_dictionary_removeCompact_OK();
+    exit_result |= array_dictionary_filterReduce_OK();
+
+    return exit_result;
+}
+
+int array_dictionary_getValidValue_OK(void) {
+    p_array_dictionary dictionary = create_array_dictionary();
+
+    add_record_to_array_dictionary(dictionary, "firstKey", "firstValue");
+    add_record_to_array_dictionary(dictionary, "secondKey", "secondValue");
+    add_record_to_array_dictionary(dictionary, "thirdKey", "thirdValue");
+    emplace_record_to_array_dictionary(dictionary, "zeroKey", "zeroValue");
+
+    int result = is_equal("thirdValue", get_value_from_array_dictionary(dictionary, "thirdKey"));
+    result &= is_equal("zeroValue", get_value_from_array_dictionary_by_index(dictionary, 0));
+    result &= get_index_from_array_dictionary_by_key(dictionary, "thirdKey") == 3;
+    result &= dictionary->size == 4;
+    delete_array_dictionary(dictionary);
+
+    return ORDER_RESULT(result, 0);
+}
+
+int array_dictionary_removeCompact_OK(void) {
+    p_array_dictionary dictionary = create_array_dictionary();
+    for (int i = 0; i < 100; i++)
+        add_record_to_array_dictionary(dictionary, "filler", (void *)(intptr_t)i);
+    add_record_to_array_dictionary(dictionary, "lastKey", "lastValue");
+
+    for (int i = 0; i < 80; i++)
+        remove_record_from_array_dictionary(dictionary, "filler");
+
+    int result = dictionary->size == 21 && dictionary->length == 101;
+    result &= get_value_from_array_dictionary(dictionary, "filler") == (void *)(intptr_t)80;
+    result &= get_index_from_array_dictionary_by_key(dictionary, "lastKey") == 20;
+
+    remove_record_from_array_dictionary(dictionary, "lastKey");
+    result &= dictionary->length == 100;
+
+    // Reads skip removed slots without compacting, positional writes compact.
+    result &= get_value_from_array_dictionary_by_index(dictionary, 1) == (void *)(intptr_t)81;
+    result &= dictionary->length == 100;
+    result &= update_record_in_array_dictionary_by_index(dictionary, 1, (void *)(intptr_t)81) ==
+              (void *)(intptr_t)81;
+    result &= dictionary->length == 20;
+    result &= !contains_key_in_array_dictionary(dictionary, "lastKey");
+    delete_array_dictionary(dictionary);
+
+    return ORDER_RESULT(result, 1);
+}
+
+int array_dictionary_filterReduce_OK(void) {
+    p_array_dictionary dictionary = create_array_dictionary();
+    for (int i = 0; i < 10; i++)
+        add_record_to_array_dictionary(dictionary, "key", (void *)(intptr_t)i);
+    remove_record_from_array_dictionary_by_index(dictionary, 4);
+
+    p_array_dictionary even = filter_array_dictionary(dictionary, filter_even_callback);
+    intptr_t sum = 0;
+    reduce_array_dictionary(even, reduce_sum_callback, &sum);
+
+    int result = even->size == 4 && sum == 16;
+    delete_array_dictionary(even);
+    delete_array_dictionary(dictionary);
+
+    return ORDER_RESULT(result, 2);
+}
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DEFINITIONS
+ **********************************************************************************************/
+
+static int filter_even_callback(const p_record record, int index, const p_array_dictionary dict) {
+    return ((intptr_t)record->value & 1) == 0;
+}
+
+static void reduce_sum_callback(
+    void *acc, const p_record record, int index, const p_array_dictionary dict) {
+    *(intptr_t *)acc += (intptr_t)record->value;
+}
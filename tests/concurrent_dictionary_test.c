@@ -0,0 +1,251 @@
+/**
+ * @file concurrent_dictionary.test.c
+ * @author chcp (cmewhou@yandex.ru)
+ * @brief Concurrent dictionary tests
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#include "utils/helper.h"
+
+#include <concurrent_dictionary.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <unistd.h>
+
+/*********************************************************************************************
+ * MACROS DECLARATIONS
+ ********************************************************************************************/
+
+#define CONCURRENT_TEST_READERS 4
+#define CONCURRENT_TEST_KEYS 16
+#define CONCURRENT_TEST_ROUNDS 2000
+#define CONCURRENT_TEST_RECORDS 100
+#define CONCURRENT_TEST_REMOVED 70
+
+/*********************************************************************************************
+ * STRUCTS DECLARATIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Shared state of concurrent test threads.
+ */
+typedef struct concurrent_test_s {
+    p_concurrent_dictionary dict;         // Dictionary.
+    char keys[CONCURRENT_TEST_KEYS][16];  // Churned keys.
+    volatile int done;                    // Writer finished.
+} concurrent_test_t, *p_concurrent_test;
+
+/**
+ * @brief Shared state of writing iteration test threads.
+ */
+typedef struct concurrent_write_test_s {
+    p_concurrent_dictionary dict;            // Dictionary.
+    char keys[CONCURRENT_TEST_RECORDS][16];  // Initial keys.
+    volatile int inside;                     // Iteration reached the callback.
+    volatile int removing;                   // Remover started.
+    int added;                               // Callback added its record.
+} concurrent_write_test_t, *p_concurrent_write_test;
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ **********************************************************************************************/
+
+/**
+ * @brief Sum values of records.
+ *
+ * @param key Record key.
+ * @param value Record value.
+ * @param args Sum.
+ */
+static void sum_values_callback(char *key, void *value, void *args);
+
+/**
+ * @brief Check that record holds one of the values the test writes.
+ *
+ * @param key Record key.
+ * @param value Record value.
+ * @param args Result to clear on unexpected value.
+ */
+static void check_value_callback(char *key, void *value, void *args);
+
+/**
+ * @brief Add a record from inside of iteration once remover has started.
+ *
+ * @param key Record key.
+ * @param value Record value.
+ * @param args Shared test state.
+ */
+static void add_record_callback(char *key, void *value, void *args);
+
+/**
+ * @brief Iterate with a callback writing to the dictionary.
+ *
+ * @param args Shared test state.
+ * @return NULL.
+ */
+static void *writing_reader_thread(void *args);
+
+/**
+ * @brief Look up stable record and iterate while writer churns records.
+ *
+ * @param args Shared test state.
+ * @return 1 if every read was consistent, 0 otherwise.
+ */
+static void *reader_thread(void *args);
+
+/*********************************************************************************************
+ * FUNCTIONS DECLARATIONS
+ ********************************************************************************************/
+
+/** @brief Concurrent dictionary single thread operations test. */
+int concurrent_dictionary_operations_OK(void);
+
+/** @brief Concurrent dictionary readers with a churning writer test. */
+int concurrent_dictionary_readersWithWriter_OK(void);
+
+/** @brief Concurrent dictionary iteration callback writing while records are reclaimed test. */
+int concurrent_dictionary_writingIteration_OK(void);
+
+/*********************************************************************************************
+ * FUNCTIONS DEFINITIONS
+ ********************************************************************************************/
+
+int concurrent_dictionary_test(int argc, char *argv[]) {
+    int exit_result = 0;
+
+    exit_result |= concurrent_dictionary_operations_OK();
+    exit_result |= concurrent_dictionary_readersWithWriter_OK();
+    exit_result |= concurrent_dictionary_writingIteration_OK();
+
+    return exit_result;
+}
+
+int concurrent_dictionary_operations_OK(void) {
+    p_concurrent_dictionary dictionary = create_concurrent_dictionary();
+    add_record_to_concurrent_dictionary(dictionary, "first", (void *)1);
+    add_record_to_concurrent_dictionary(dictionary, "second", (void *)2);
+    add_record_to_concurrent_dictionary(dictionary, "third", (void *)3);
+
+    int result = get_concurrent_dictionary_size(dictionary) == 3;
+    result &= get_value_from_concurrent_dictionary(dictionary, "second") == (void *)2;
+    result &= update_record_in_concurrent_dictionary(dictionary, "second", (void *)20) == (void *)2;
+    result &= remove_record_from_concurrent_dictionary(dictionary, "first") == (void *)1;
+    result &= remove_record_from_concurrent_dictionary(dictionary, "third") == (void *)3;
+    result &= !contains_key_in_concurrent_dictionary(dictionary, "first");
+    result &= remove_record_from_concurrent_dictionary(dictionary, "missing") == NULL;
+    add_record_to_concurrent_dictionary(dictionary, "fourth", (void *)4);
+
+    intptr_t sum = 0;
+    iterate_over_concurrent_dictionary_with_args(dictionary, sum_values_callback, &sum);
+    result &= sum == 24 && get_concurrent_dictionary_size(dictionary) == 2;
+    result &= synchronize_concurrent_dictionary(dictionary) == 0;
+    delete_concurrent_dictionary(dictionary);
+
+    return ORDER_RESULT(result, 0);
+}
+
+int concurrent_dictionary_readersWithWriter_OK(void) {
+    concurrent_test_t test = {.dict = create_concurrent_dictionary(), .done = 0};
+    add_record_to_concurrent_dictionary(test.dict, "stable", (void *)7);
+    for (int i = 0; i < CONCURRENT_TEST_KEYS; i++)
+        sprintf(test.keys[i], "key%d", i);
+
+    pthread_t readers[CONCURRENT_TEST_READERS];
+    for (int i = 0; i < CONCURRENT_TEST_READERS; i++)
+        pthread_create(&readers[i], NULL, reader_thread, &test);
+
+    for (int round = 0; round < CONCURRENT_TEST_ROUNDS; round++) {
+        char *key = test.keys[round % CONCURRENT_TEST_KEYS];
+        add_record_to_concurrent_dictionary(test.dict, key, (void *)1);
+        // Each key lives for half of the keys cycle, so at most half of them are present.
+        if (round >= CONCURRENT_TEST_KEYS / 2) {
+            char *removed = test.keys[(round - CONCURRENT_TEST_KEYS / 2) % CONCURRENT_TEST_KEYS];
+            remove_record_from_concurrent_dictionary(test.dict, removed);
+        }
+    }
+    test.done = 1;
+
+    int result = 1;
+    for (int i = 0; i < CONCURRENT_TEST_READERS; i++) {
+        void *reader_result = NULL;
+        pthread_join(readers[i], &reader_result);
+        result &= reader_result == (void *)1;
+    }
+    result &= get_concurrent_dictionary_size(test.dict) == 1 + CONCURRENT_TEST_KEYS / 2;
+    delete_concurrent_dictionary(test.dict);
+
+    return ORDER_RESULT(result, 1);
+}
+
+int concurrent_dictionary_writingIteration_OK(void) {
+    concurrent_write_test_t test = {.dict = create_concurrent_dictionary()};
+    for (int i = 0; i < CONCURRENT_TEST_RECORDS; i++) {
+        sprintf(test.keys[i], "key%d", i);
+        add_record_to_concurrent_dictionary(test.dict, test.keys[i], (void *)1);
+    }
+
+    pthread_t reader;
+    pthread_create(&reader, NULL, writing_reader_thread, &test);
+    while (!test.inside)
+        sched_yield();
+
+    // Enough removals to reclaim while the reader waits for the writers mutex in its callback.
+    test.removing = 1;
+    int result = 1;
+    for (int i = 0; i < CONCURRENT_TEST_REMOVED; i++)
+        result &= remove_record_from_concurrent_dictionary(test.dict, test.keys[i]) == (void *)1;
+    pthread_join(reader, NULL);
+
+    result &= test.added && get_concurrent_dictionary_size(test.dict) == CONCURRENT_TEST_RECORDS - CONCURRENT_TEST_REMOVED + 1;
+    delete_concurrent_dictionary(test.dict);
+
+    return ORDER_RESULT(result, 2);
+}
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DEFINITIONS
+ **********************************************************************************************/
+
+static void sum_values_callback(char *key, void *value, void *args) {
+    *(intptr_t *)args += (intptr_t)value;
+}
+
+static void check_value_callback(char *key, void *value, void *args) {
+    *(intptr_t *)args &= value == (void *)1 || value == (void *)7;
+}
+
+static void add_record_callback(char *key, void *value, void *args) {
+    p_concurrent_write_test test = (p_concurrent_write_test)args;
+    if (test->added)
+        return;
+
+    test->inside = 1;
+    while (!test->removing)
+        sched_yield();
+    usleep(10000);
+    test->added = add_record_to_concurrent_dictionary(test->dict, "added", (void *)2) == 0;
+}
+
+static void *writing_reader_thread(void *args) {
+    p_concurrent_write_test test = (p_concurrent_write_test)args;
+    iterate_over_concurrent_dictionary_with_args(test->dict, add_record_callback, test);
+    return NULL;
+}
+
+static void *reader_thread(void *args) {
+    p_concurrent_test test = (p_concurrent_test)args;
+    intptr_t result = 1;
+    while (!test->done) {
+        result &= get_value_from_concurrent_dictionary(test->dict, "stable") == (void *)7;
+
+        // Removed records may still be visited, but never after they are freed.
+        iterate_over_concurrent_dictionary_with_args(test->dict, check_value_callback, &result);
+    }
+    return (void *)result;
+}
@@ -12,6 +12,65 @@
 
 #include <dictionary.h>
 
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ **********************************************************************************************/
+
+/**
+ * @brief Compare records by value.
+ *
+ * @param record1 Record 1.
+ * @param record2 Record 2.
+ * @return 1 if first value is greater, 0 otherwise.
+ */
+static int sort_by_value_callback(const p_record record1, const p_record record2);
+
+/**
+ * @brief Filter records with odd values.
+ *
+ * @param record Record.
+ * @param index Record index.
+ * @param dict Dictionary.
+ * @return 1 if value is odd, 0 otherwise.
+ */
+static int filter_odd_callback(const p_record record, int index, const p_dictionary dict);
+
+/**
+ * @brief Map record to record with doubled value.
+ *
+ * @param record Record.
+ * @param index Record index.
+ * @param dict Dictionary.
+ * @param args Record storage.
+ * @return Mapped record.
+ */
+static p_record map_double_callback(
+    const p_record record, int index, const p_dictionary dict, void *args);
+
+/**
+ * @brief Sum record values.
+ *
+ * @param acc Accumulator.
+ * @param record Record.
+ * @param index Record index.
+ * @param dict Dictionary.
+ */
+static void reduce_sum_callback(void *acc, const p_record record, int index, const p_dictionary dict);
+
+/**
+ * @brief Add visited record to a dictionary.
+ *
+ * @param key Record key.
+ * @param value Record value.
+ * @param args Dictionary, may be NULL.
+ */
+static void collect_record_callback(char *key, void *value, void *args);
+
 /*********************************************************************************************
  * FUNCTIONS DECLARATIONS
  ********************************************************************************************/
@@ -19,6 +78,45 @@
 /** @brief Dictionary collection initialisation test. */
 int dictionary_getValidValue_OK(void);
 
+/** @brief Indexed dictionary keyed lookup and removal test. */
+int dictionary_indexedLookup_OK(void);
+
+/** @brief Pooled dictionary records recycling test. */
+int dictionary_recordPool_OK(void);
+
+/** @brief Stable dictionary sort test. */
+int dictionary_sortStable_OK(void);
+
+/** @brief Lazy dictionary query test. */
+int dictionary_lazyQuery_OK(void);
+
+/** @brief Position indexed dictionary positional operations test. */
+int dictionary_positionIndex_OK(void);
+
+/** @brief Value indexed dictionary lookup by value test. */
+int dictionary_valueIndex_OK(void);
+
+/** @brief Dictionary with cached key hashes lookup test. */
+int dictionary_keyHash_OK(void);
+
+/** @brief Dictionary cursor iteration with removal test. */
+int dictionary_cursor_OK(void);
+
+/** @brief Dictionary with owned keys copies and recycles keys test. */
+int dictionary_ownedKeys_OK(void);
+
+/** @brief Integer keyed dictionary test. */
+int dictionary_intKeys_OK(void);
+
+/** @brief Dictionary removal and update by record reference test. */
+int dictionary_recordRef_OK(void);
+
+/** @brief Dictionary radix trie key index and prefix enumeration test. */
+int dictionary_keyTrie_OK(void);
+
+/** @brief Dictionary batch append, splice and merge test. */
+int dictionary_bulkOperations_OK(void);
+
 /*********************************************************************************************
  * FUNCTIONS DEFINITIONS
  ********************************************************************************************/
@@ -27,8 +125,22 @@ int dictionary_test(int argc, char *argv[]) {
     int exit_result = 0;
 
     exit_result |= dictionary_getValidValue_OK();
+    exit_result |= dictionary_indexedLookup_OK();
+    exit_result |= dictionary_recordPool_OK();
+    exit_result |= dictionary_sortStable_OK();
+    exit_result |= dictionary_lazyQuery_OK();
+    exit_result |= dictionary_positionIndex_OK();
+    exit_result |= dictionary_valueIndex_OK();
+    exit_result |= dictionary_keyHash_OK();
+    exit_result |= dictionary_cursor_OK();
+    exit_result |= dictionary_ownedKeys_OK();
+    exit_result |= dictionary_intKeys_OK();
+    exit_result |= dictionary_recordRef_OK();
+    exit_result |= dictionary_keyTrie_OK();
+    exit_result |= dictionary_bulkOperations_OK();
 
-    return exit_result;
+    // Exit status keeps only the low 8 bits, later failures would read as success.
+    return exit_result != 0;
 }
 
 int dictionary_getValidValue_OK(void) {
@@ -45,4 +157,533 @@ int dictionary_getValidValue_OK(void) {
 
     const int result = is_equal(expected, actual);
     return ORDER_RESULT(result, 0);
-}
\ No newline at end of file
+}
+
+int dictionary_indexedLookup_OK(void) {
+    p_dictionary dictionary = create_indexed_dictionary();
+
+    for (int i = 0; i < 100; i++)
+        add_record_to_dictionary(dictionary, "filler", (void *)(intptr_t)i);
+    add_record_to_dictionary(dictionary, "firstKey", "firstValue");
+    add_record_to_dictionary(dictionary, "secondKey", "secondValue");
+    add_record_to_dictionary(dictionary, "firstKey", "duplicateValue");
+    emplace_record_to_dictionary(dictionary, "secondKey", "emplacedValue");
+
+    int result = is_equal("firstValue", get_value_from_dictionary(dictionary, "firstKey"));
+    result &= is_equal("emplacedValue", get_value_from_dictionary(dictionary, "secondKey"));
+
+    remove_record_from_dictionary(dictionary, "firstKey");
+    result &= is_equal("duplicateValue", get_value_from_dictionary(dictionary, "firstKey"));
+    remove_record_from_dictionary(dictionary, "firstKey");
+    result &= !contains_key_in_dictionary(dictionary, "firstKey");
+
+    remove_record_from_dictionary_by_index(dictionary, 0);
+    result &= is_equal("secondValue", get_value_from_dictionary(dictionary, "secondKey"));
+    result &= get_index_from_dictionary_by_key(dictionary, "secondKey") == 100;
+    result &= dictionary->size == 101;
+
+    // Duplicate inserted in the middle takes its place among records with the key.
+    add_record_to_dictionary_by_index(dictionary, 50, "filler", "middleValue");
+    p_dictionary fillers = get_records_from_dictionary(dictionary, "filler");
+    result &= fillers->size == 101 && fillers->tail->value == (void *)99;
+    result &= is_equal("middleValue", get_record_from_dictionary_by_index(fillers, 50)->value);
+    delete_dictionary(fillers);
+    delete_dictionary(dictionary);
+
+    return ORDER_RESULT(result, 1);
+}
+
+int dictionary_recordPool_OK(void) {
+    p_dictionary dictionary = create_dictionary_with_mode(DICTIONARY_MODE_RECORD_POOL, NULL);
+    for (int i = 0; i < 1000; i++)
+        add_record_to_dictionary(dictionary, "key", (void *)(intptr_t)i);
+
+    p_record removed = get_record_from_dictionary_by_index(dictionary, 500);
+    remove_record_from_dictionary_by_index(dictionary, 500);
+    add_record_to_dictionary(dictionary, "recycledKey", "recycledValue");
+
+    int result = get_tail_record_from_dictionary(dictionary) == removed;
+    result &= is_equal("recycledValue", get_value_from_dictionary(dictionary, "recycledKey"));
+    result &= dictionary->size == 1000;
+    delete_dictionary(dictionary);
+
+    p_record_pool pool = create_record_pool();
+    p_dictionary first = create_dictionary_with_pool(DICTIONARY_MODE_KEY_INDEX, pool, NULL);
+    p_dictionary second = create_dictionary_with_pool(DICTIONARY_MODE_DEFAULT, pool, NULL);
+    add_record_to_dictionary(first, "firstKey", "firstValue");
+    add_record_to_dictionary(second, "secondKey", "secondValue");
+    delete_dictionary(first);
+    add_record_to_dictionary(second, "thirdKey", "thirdValue");
+
+    result &= is_equal("thirdValue", get_value_from_dictionary(second, "thirdKey"));
+    // Records already handed out cannot grow for value index links.
+    result &= !create_dictionary_with_pool(DICTIONARY_MODE_VALUE_INDEX, pool, NULL);
+    delete_dictionary(second);
+    delete_record_pool(pool);
+
+    return ORDER_RESULT(result, 2);
+}
+
+int dictionary_sortStable_OK(void) {
+    p_dictionary dictionary = create_indexed_dictionary();
+    const char *keys[] = {"a", "b", "c", "d", "e", "f", "g"};
+    const intptr_t values[] = {3, 1, 2, 1, 3, 0, 1};
+    for (int i = 0; i < 7; i++)
+        add_record_to_dictionary_with_metadata(
+            dictionary, keys[i], (void *)values[i], (void *)(intptr_t)i);
+
+    p_dictionary sorted = sort_dictionary(dictionary, sort_by_value_callback);
+    sort_dictionary_in_place(dictionary, sort_by_value_callback);
+
+    const char *expected = "fbdgcae";
+    int result = sorted->size == 7 && dictionary->size == 7;
+    p_record copy = sorted->head;
+    p_record current = dictionary->head;
+    for (int i = 0; i < 7; i++, copy = copy->next, current = current->next) {
+        result &= current->key[0] == expected[i] && copy->key[0] == expected[i];
+        result &= current->metadata == copy->metadata;
+        result &= !current->next || current->next->prev == current;
+    }
+    result &= dictionary->tail->key[0] == 'e';
+    result &= get_index_from_dictionary_by_key(dictionary, "a") == 5;
+
+    delete_dictionary(sorted);
+    delete_dictionary(dictionary);
+
+    return ORDER_RESULT(result, 3);
+}
+
+int dictionary_lazyQuery_OK(void) {
+    p_dictionary dictionary = create_dictionary();
+    for (int i = 0; i < 10; i++)
+        add_record_to_dictionary(dictionary, "key", (void *)(intptr_t)i);
+
+    record_t mapped;
+    dictionary_query_t query;
+    map_dictionary_query_with_args(
+        filter_dictionary_query(init_dictionary_query(&query, dictionary), filter_odd_callback),
+        map_double_callback, &mapped);
+
+    intptr_t sum = 0;
+    reduce_dictionary_query(&query, reduce_sum_callback, &sum);
+    p_record first = get_first_record_from_dictionary_query(&query);
+
+    int result = sum == 50;
+    result &= first == &mapped && (intptr_t)first->value == 2;
+
+    p_dictionary collected = collect_dictionary_query(&query);
+    result &= count_dictionary_query(&query) == 5 && any_in_dictionary_query(&query);
+    result &= collected->size == 5 && (intptr_t)get_tail_value_from_dictionary(collected) == 18;
+
+    dictionary_query_t empty;
+    filter_dictionary_query(init_dictionary_query(&empty, collected), filter_odd_callback);
+    result &= !any_in_dictionary_query(&empty);
+
+    delete_dictionary(collected);
+    delete_dictionary(dictionary);
+
+    return ORDER_RESULT(result, 4);
+}
+
+int dictionary_positionIndex_OK(void) {
+    p_dictionary dictionary = create_dictionary_with_mode(
+        DICTIONARY_MODE_POSITION_INDEX | DICTIONARY_MODE_KEY_INDEX, NULL);
+    for (int i = 0; i < 1000; i++)
+        add_record_to_dictionary(dictionary, "key", (void *)(intptr_t)(2 * i));
+    for (int i = 0; i < 1000; i++)
+        add_record_to_dictionary_by_index(dictionary, 2 * i + 1, "odd", (void *)(intptr_t)(2 * i + 1));
+    emplace_record_to_dictionary(dictionary, "head", (void *)(intptr_t)-1);
+
+    int result = dictionary->size == 2001;
+    for (int i = 0; i < 2001; i += 97)
+        result &= get_record_from_dictionary_by_index(dictionary, i)->value == (void *)(intptr_t)(i - 1);
+
+    remove_record_from_dictionary_by_index(dictionary, 0);
+    for (int i = 0; i < 500; i++)
+        remove_record_from_dictionary_by_index(dictionary, i);
+    result &= get_record_from_dictionary_by_index(dictionary, 499)->value == (void *)(intptr_t)999;
+    result &= get_record_from_dictionary_by_index(dictionary, 500)->value == (void *)(intptr_t)1000;
+    result &= get_index_from_dictionary_by_key(dictionary, "key") == 500;
+
+    sort_dictionary_in_place(dictionary, sort_by_value_callback);
+    result &= get_index_from_dictionary_by_key(dictionary, "odd") == 0;
+    result &= get_index_from_dictionary_by_ref_record(dictionary, dictionary->tail) == 1499;
+    for (int i = 1; i < 1500; i += 101)
+        result &= get_record_from_dictionary_by_index(dictionary, i)->prev ==
+            get_record_from_dictionary_by_index(dictionary, i - 1);
+    delete_dictionary(dictionary);
+
+    return ORDER_RESULT(result, 5);
+}
+
+int dictionary_valueIndex_OK(void) {
+    p_dictionary dictionary = create_dictionary_with_mode(DICTIONARY_MODE_VALUE_INDEX, NULL);
+    for (int i = 0; i < 100; i++)
+        add_record_to_dictionary(dictionary, "filler", (void *)(intptr_t)i);
+    add_record_to_dictionary(dictionary, "firstKey", "sharedValue");
+    add_record_to_dictionary(dictionary, "secondKey", "sharedValue");
+    emplace_record_to_dictionary(dictionary, "headKey", "sharedValue");
+
+    int result = is_equal("headKey", get_record_from_dictionary_by_value(dictionary, "sharedValue")->key);
+    result &= contains_value_in_dictionary(dictionary, (void *)(intptr_t)42);
+
+    p_dictionary shared = get_records_from_dictionary_by_value(dictionary, "sharedValue");
+    result &= shared->size == 3 && is_equal("secondKey", shared->tail->key);
+    delete_dictionary(shared);
+
+    remove_record_from_dictionary(dictionary, "headKey");
+    result &= is_equal("firstKey", get_record_from_dictionary_by_value(dictionary, "sharedValue")->key);
+
+    update_record_in_dictionary(dictionary, "firstKey", "updatedValue");
+    update_record_in_dictionary_by_index(dictionary, 42, "updatedValue");
+    result &= !contains_value_in_dictionary(dictionary, (void *)(intptr_t)42);
+    result &= is_equal("filler", get_record_from_dictionary_by_value(dictionary, "updatedValue")->key);
+    result &= is_equal("secondKey", get_record_from_dictionary_by_value(dictionary, "sharedValue")->key);
+    delete_dictionary(dictionary);
+
+    // Duplicates inserted in the middle are chained in dictionary order, with or without positions.
+    const int modes[] = {DICTIONARY_MODE_VALUE_INDEX, DICTIONARY_MODE_VALUE_INDEX | DICTIONARY_MODE_POSITION_INDEX};
+    for (int i = 0; i < 2; i++) {
+        p_dictionary chained = create_dictionary_with_mode(modes[i], NULL);
+        for (int j = 0; j < 10; j++)
+            add_record_to_dictionary(chained, "filler", (void *)(intptr_t)j);
+        add_record_to_dictionary(chained, "tailKey", "sharedValue");
+        add_record_to_dictionary_by_index(chained, 5, "middleKey", "sharedValue");
+        add_record_to_dictionary_by_index(chained, 1, "frontKey", "sharedValue");
+
+        shared = get_records_from_dictionary_by_value(chained, "sharedValue");
+        result &= shared->size == 3 && is_equal("frontKey", shared->head->key) &&
+                  is_equal("middleKey", shared->head->next->key) && is_equal("tailKey", shared->tail->key);
+        delete_dictionary(shared);
+
+        update_record_in_dictionary(chained, "frontKey", (void *)(intptr_t)3);
+        shared = get_records_from_dictionary_by_value(chained, (void *)(intptr_t)3);
+        result &= shared->size == 2 && is_equal("frontKey", shared->head->key);
+        result &= is_equal("middleKey", get_record_from_dictionary_by_value(chained, "sharedValue")->key);
+        delete_dictionary(shared);
+        delete_dictionary(chained);
+    }
+
+    return ORDER_RESULT(result, 6);
+}
+
+int dictionary_keyHash_OK(void) {
+    p_dictionary dictionary = create_dictionary_with_mode(DICTIONARY_MODE_KEY_HASH, NULL);
+    p_dictionary indexed = create_indexed_dictionary();
+    const char *keys[] = {"key", "keyA", "keyB", "keyA", "longer key with tail"};
+    for (int i = 0; i < 5; i++) {
+        add_record_to_dictionary(dictionary, keys[i], (void *)(intptr_t)i);
+        add_record_to_dictionary(indexed, keys[i], (void *)(intptr_t)i);
+    }
+
+    uint32_t hash = hash_dictionary_key("keyA");
+    int result = get_record_from_dictionary_hashed(dictionary, "keyA", hash)->value == (void *)1;
+    result &= get_record_from_dictionary_hashed(indexed, "keyA", hash)->value == (void *)1;
+    result &= !get_record_from_dictionary_hashed(dictionary, "keyB", hash);
+    result &= dictionary->record_size == (int)(sizeof(record_t) + 2 * sizeof(uint32_t));
+    result &= get_value_from_dictionary(dictionary, "longer key with tail") == (void *)4;
+    result &= get_index_from_dictionary_by_key(dictionary, "keyB") == 2;
+    result &= !contains_key_in_dictionary(dictionary, "keyC");
+
+    p_dictionary records = get_records_from_dictionary(dictionary, "keyA");
+    result &= records->size == 2 && records->tail->value == (void *)3;
+    delete_dictionary(records);
+    delete_dictionary(indexed);
+    delete_dictionary(dictionary);
+
+    return ORDER_RESULT(result, 7);
+}
+
+int dictionary_cursor_OK(void) {
+    p_dictionary dictionary = create_dictionary();
+    const char *keys[] = {"key0", "key1", "key2", "key3", "key4"};
+    for (int i = 0; i < 5; i++)
+        add_record_to_dictionary(dictionary, keys[i], (void *)(intptr_t)i);
+
+    int result = 1;
+    intptr_t expected = 0;
+    for (dictionary_cursor_t cursor = begin_dictionary_cursor(dictionary);
+         !is_dictionary_cursor_done(&cursor); next_dictionary_cursor(&cursor))
+        result &= cursor.record->value == (void *)expected++;
+    result &= expected == 5;
+
+    for (dictionary_cursor_t cursor = begin_reverse_dictionary_cursor(dictionary);
+         !is_dictionary_cursor_done(&cursor); next_dictionary_cursor(&cursor))
+        result &= cursor.record->value == (void *)--expected;
+    result &= expected == 0;
+
+    for (dictionary_cursor_t cursor = begin_dictionary_cursor(dictionary);
+         !is_dictionary_cursor_done(&cursor); next_dictionary_cursor(&cursor))
+        if ((intptr_t)cursor.record->value % 2 == 0)
+            remove_record_from_dictionary(dictionary, cursor.record->key);
+    result &= dictionary->size == 2 && dictionary->head->value == (void *)1 && dictionary->tail->value == (void *)3;
+
+    dictionary_cursor_t cursor = begin_dictionary_cursor(NULL);
+    result &= is_dictionary_cursor_done(&cursor);
+    delete_dictionary(dictionary);
+
+    return ORDER_RESULT(result, 8);
+}
+
+int dictionary_ownedKeys_OK(void) {
+    p_record_pool pool = create_record_pool();
+    p_dictionary dictionary = create_dictionary_with_pool(DICTIONARY_MODE_OWNED_KEYS, pool, NULL);
+    p_dictionary indexed = create_dictionary_with_mode(DICTIONARY_MODE_OWNED_KEYS | DICTIONARY_MODE_KEY_INDEX, NULL);
+
+    char key[300];
+    memset(key, 'k', sizeof(key) - 1);
+    key[sizeof(key) - 1] = '\0';
+    add_record_to_dictionary(indexed, key, (void *)3);
+    strcpy(key, "short");
+    add_record_to_dictionary(dictionary, key, (void *)1);
+    strcpy(key, "a key longer than inline");
+    add_record_to_dictionary(dictionary, key, (void *)2);
+    add_record_to_dictionary(indexed, key, (void *)4);
+    strcpy(key, "overwritten");
+
+    int result = get_value_from_dictionary(dictionary, "short") == (void *)1;
+    // Short key is stored inside its record.
+    result &= (size_t)(dictionary->head->key - (char *)dictionary->head) < (size_t)dictionary->record_size;
+    result &= dictionary->record_size == 64;
+    result &= get_value_from_dictionary(dictionary, "a key longer than inline") == (void *)2;
+    result &= get_value_from_dictionary(indexed, "a key longer than inline") == (void *)4;
+    result &= strlen(indexed->head->key) == sizeof(key) - 1;
+
+    // Block of removed key is reused by the next key of its size class.
+    char *block = dictionary->tail->key;
+    remove_record_from_dictionary(dictionary, "a key longer than inline");
+    add_record_to_dictionary(dictionary, "another longer key here", (void *)5);
+    result &= dictionary->tail->key == block && is_equal(block, "another longer key here");
+
+    delete_dictionary(dictionary);
+    delete_dictionary(indexed);
+    delete_record_pool(pool);
+
+    return ORDER_RESULT(result, 9);
+}
+
+int dictionary_intKeys_OK(void) {
+    p_dictionary dictionary = create_int_dictionary();
+    for (intptr_t i = -100; i < 1000; i++)
+        add_record_to_int_dictionary(dictionary, i, (void *)(i * 2));
+
+    int result = dictionary->size == 1100;
+    result &= get_value_from_int_dictionary(dictionary, 0) == (void *)0;
+    result &= get_value_from_int_dictionary(dictionary, -100) == (void *)-200;
+    result &= get_value_from_int_dictionary(dictionary, 777) == (void *)1554;
+    result &= !contains_key_in_int_dictionary(dictionary, 1000);
+
+    // Key 0 is a valid key, not a NULL string.
+    result &= remove_record_from_int_dictionary(dictionary, 0) == (void *)0;
+    result &= !contains_key_in_int_dictionary(dictionary, 0);
+    result &= update_record_in_int_dictionary(dictionary, 42, (void *)-1) == (void *)84;
+    result &= get_record_from_int_dictionary(dictionary, 42)->value == (void *)-1;
+    result &= get_index_from_dictionary_by_key(dictionary, (char *)5) == 104;
+    result &= dictionary->size == 1099;
+
+    p_dictionary filtered = filter_dictionary(dictionary, filter_odd_callback);
+    result &= filtered->size == 1 && get_value_from_int_dictionary(filtered, 42) == (void *)-1;
+    // Integer keys have no string hash, precomputed hash lookups are refused.
+    result &= !get_record_from_dictionary_hashed(dictionary, (char *)42, hash_dictionary_key("42"));
+    result &= !get_record_from_dictionary_hashed(filtered, (char *)42, 0);
+    result &= iterate_over_dictionary_prefix_with_args(filtered, "4", NULL, NULL) ==
+              IPEE_ERROR_CODE__DICTIONARY__INCOMPATIBLE_MODE;
+    delete_dictionary(filtered);
+
+    delete_dictionary(dictionary);
+
+    return ORDER_RESULT(result, 10);
+}
+
+int dictionary_recordRef_OK(void) {
+    p_dictionary dictionary = create_dictionary_with_mode(
+        DICTIONARY_MODE_RECORD_POOL | DICTIONARY_MODE_KEY_INDEX | DICTIONARY_MODE_VALUE_INDEX, NULL);
+    add_record_to_dictionary(dictionary, "first", (void *)1);
+    add_record_to_dictionary(dictionary, "second", (void *)2);
+    add_record_to_dictionary(dictionary, "third", (void *)3);
+
+    record_ref_t second = get_record_ref(dictionary, get_record_from_dictionary(dictionary, "second"));
+    int result = update_record_in_dictionary_by_ref(dictionary, second, (void *)20) == (void *)2;
+    result &= get_record_from_dictionary_by_value(dictionary, (void *)20) == second.record;
+    result &= remove_record_from_dictionary_by_ref(dictionary, second) == (void *)20;
+    result &= dictionary->size == 2 && dictionary->head->next == dictionary->tail;
+    result &= !contains_key_in_dictionary(dictionary, "second");
+    result &= !contains_value_in_dictionary(dictionary, (void *)20);
+
+    // Stale reference is rejected even after its record is reused.
+    add_record_to_dictionary(dictionary, "fourth", (void *)4);
+    result &= dictionary->tail == second.record && !is_record_ref_valid(dictionary, second);
+    result &= remove_record_from_dictionary_by_ref(dictionary, second) == NULL;
+    result &= update_record_in_dictionary_by_ref(dictionary, second, (void *)5) == NULL;
+    result &= get_value_from_dictionary(dictionary, "fourth") == (void *)4 && dictionary->size == 3;
+    result &= remove_record_from_dictionary_by_ref(dictionary, get_record_ref(dictionary, NULL)) == NULL;
+
+    // Heap records have no generation, so they cannot be referenced.
+    p_dictionary heap = create_dictionary();
+    add_record_to_dictionary(heap, "first", (void *)1);
+    record_ref_t first = get_record_ref(heap, heap->head);
+    result &= !first.record && !is_record_ref_valid(heap, first);
+    result &= remove_record_from_dictionary_by_ref(heap, (record_ref_t){.record = heap->head}) == NULL;
+    result &= heap->size == 1;
+    delete_dictionary(heap);
+
+    delete_dictionary(dictionary);
+
+    return ORDER_RESULT(result, 11);
+}
+
+int dictionary_keyTrie_OK(void) {
+    static char keys[1000][24];
+    p_dictionary dictionary = create_dictionary_with_mode(DICTIONARY_MODE_KEY_TRIE, NULL);
+    p_dictionary plain = create_dictionary();
+    p_dictionary dictionaries[] = {dictionary, plain};
+    for (int d = 0; d < 2; d++) {
+        for (int i = 0; i < 1000; i++) {
+            sprintf(keys[i], "context_event%d_%d", i % 7, i);
+            add_record_to_dictionary(dictionaries[d], keys[i], (void *)(intptr_t)i);
+        }
+        add_record_to_dictionary(dictionaries[d], "context", (void *)-1);
+        add_record_to_dictionary(dictionaries[d], "context_event1_1", (void *)-2);
+        add_record_to_dictionary(dictionaries[d], "", (void *)-3);
+    }
+
+    int result = get_value_from_dictionary(dictionary, "context_event3_500") == (void *)500;
+    result &= get_value_from_dictionary(dictionary, "context_event1_1") == (void *)1;
+    result &= get_value_from_dictionary(dictionary, "context") == (void *)-1;
+    result &= get_value_from_dictionary(dictionary, "") == (void *)-3;
+    result &= !contains_key_in_dictionary(dictionary, "context_event");
+    result &= !contains_key_in_dictionary(dictionary, "context_event3_5000");
+
+    // Trie enumerates the same records as a full scan, ordered by key.
+    const char *prefixes[] = {"context_event1_1", "context_event", "context", "", "missing"};
+    for (int i = 0; i < (int)(sizeof(prefixes) / sizeof(prefixes[0])); i++) {
+        p_dictionary found = create_dictionary();
+        p_dictionary expected = create_dictionary();
+        int count = iterate_over_dictionary_prefix_with_args(dictionary, prefixes[i], collect_record_callback, found);
+        iterate_over_dictionary_prefix_with_args(plain, prefixes[i], collect_record_callback, expected);
+        result &= count == found->size && found->size == expected->size;
+
+        const char *previous = "";
+        for (dictionary_cursor_t cursor = begin_dictionary_cursor(found);
+             !is_dictionary_cursor_done(&cursor); next_dictionary_cursor(&cursor)) {
+            result &= strcmp(previous, cursor.record->key) <= 0;
+            previous = cursor.record->key;
+        }
+        delete_dictionary(found);
+        delete_dictionary(expected);
+    }
+
+    // Removal merges nodes back, remaining keys stay reachable.
+    for (int d = 0; d < 2; d++) {
+        for (int i = 0; i < 1000; i += 3)
+            remove_record_from_dictionary(dictionaries[d], keys[i]);
+        remove_record_from_dictionary(dictionaries[d], "context");
+        remove_record_from_dictionary(dictionaries[d], "context_event1_1");
+    }
+    for (int i = 0; i < 1000; i++)
+        result &= get_value_from_dictionary(dictionary, keys[i]) == get_value_from_dictionary(plain, keys[i]);
+    result &= get_value_from_dictionary(dictionary, "context_event1_1") == (void *)-2;
+    result &= iterate_over_dictionary_prefix_with_args(dictionary, "context", collect_record_callback, NULL) ==
+              iterate_over_dictionary_prefix_with_args(plain, "context", collect_record_callback, NULL);
+
+    delete_dictionary(dictionary);
+    delete_dictionary(plain);
+
+    return ORDER_RESULT(result, 12);
+}
+
+int dictionary_bulkOperations_OK(void) {
+    static record_t records[1000];
+    static char keys[1000][8];
+    for (int i = 0; i < 1000; i++) {
+        sprintf(keys[i], "k%d", i);
+        records[i].key = keys[i];
+        records[i].value = (void *)(intptr_t)i;
+        records[i].metadata = NULL;
+    }
+
+    // Batch lands in one slab of the pool, in order.
+    p_dictionary dictionary = create_dictionary_with_mode(
+        DICTIONARY_MODE_RECORD_POOL | DICTIONARY_MODE_KEY_INDEX | DICTIONARY_MODE_POSITION_INDEX, NULL);
+    add_record_to_dictionary(dictionary, "head", (void *)-1);
+    int result = append_records_to_dictionary(dictionary, records, 1000) == 0;
+    result &= dictionary->size == 1001 && get_index_from_dictionary_by_key(dictionary, "k500") == 501;
+    result &= get_record_from_dictionary(dictionary, "k999") == dictionary->tail;
+    result &= get_record_from_dictionary(dictionary, "k1")->prev == get_record_from_dictionary(dictionary, "k0");
+    result &= append_records_to_dictionary(dictionary, records, 0) == 0 && dictionary->size == 1001;
+
+    // Plain lists are joined without touching the records.
+    p_dictionary first = create_dictionary();
+    p_dictionary second = create_dictionary();
+    append_records_to_dictionary(first, records, 10);
+    append_records_to_dictionary(second, records + 10, 10);
+    p_record joint = second->head;
+    result &= splice_dictionary(first, second) == 0;
+    result &= first->size == 20 && !second->head && !second->tail && second->size == 0;
+    result &= get_record_from_dictionary_by_index(first, 10) == joint;
+    result &= joint->prev->value == (void *)9 && first->tail->value == (void *)19;
+
+    // Indexed destination indexes spliced records one by one.
+    p_dictionary indexed = create_indexed_dictionary();
+    add_record_to_dictionary(indexed, "k5", (void *)-5);
+    result &= splice_dictionary(indexed, first) == 0 && first->size == 0;
+    result &= indexed->size == 21 && get_value_from_dictionary(indexed, "k5") == (void *)-5;
+    result &= get_value_from_dictionary(indexed, "k19") == (void *)19;
+    result &= splice_dictionary(indexed, dictionary) == IPEE_ERROR_CODE__DICTIONARY__INCOMPATIBLE_MODE;
+    result &= splice_dictionary(indexed, indexed) == IPEE_ERROR_CODE__DICTIONARY__INCOMPATIBLE_MODE;
+
+    // Conflicting keys are resolved by the policy.
+    p_dictionary source = create_dictionary();
+    add_record_to_dictionary(source, "k5", (void *)55);
+    add_record_to_dictionary(source, "new", (void *)100);
+    result &= merge_dictionaries(indexed, source, DICTIONARY_MERGE_KEEP) == 0;
+    result &= indexed->size == 22 && get_value_from_dictionary(indexed, "k5") == (void *)-5;
+    result &= merge_dictionaries(indexed, source, DICTIONARY_MERGE_REPLACE) == 0;
+    result &= indexed->size == 22 && get_value_from_dictionary(indexed, "k5") == (void *)55;
+    result &= merge_dictionaries(indexed, source, DICTIONARY_MERGE_APPEND) == 0;
+    result &= indexed->size == 24 && source->size == 2 && is_equal(indexed->tail->key, "new");
+    result &= merge_dictionaries(source, source, DICTIONARY_MERGE_APPEND) == 0 && source->size == 4;
+
+    p_dictionary int_dictionary = create_int_dictionary();
+    result &= merge_dictionaries(int_dictionary, source, DICTIONARY_MERGE_KEEP) ==
+              IPEE_ERROR_CODE__DICTIONARY__INCOMPATIBLE_MODE;
+
+    delete_dictionary(int_dictionary);
+    delete_dictionary(source);
+    delete_dictionary(indexed);
+    delete_dictionary(first);
+    delete_dictionary(second);
+    delete_dictionary(dictionary);
+
+    return ORDER_RESULT(result, 13);
+}
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DEFINITIONS
+ **********************************************************************************************/
+
+static int sort_by_value_callback(const p_record record1, const p_record record2) {
+    return (intptr_t)record1->value > (intptr_t)record2->value;
+}
+
+static int filter_odd_callback(const p_record record, int index, const p_dictionary dict) {
+    return (intptr_t)record->value % 2;
+}
+
+static p_record map_double_callback(
+    const p_record record, int index, const p_dictionary dict, void *args) {
+    p_record mapped = (p_record)args;
+    mapped->key = record->key;
+    mapped->value = (void *)((intptr_t)record->value * 2);
+    mapped->metadata = NULL;
+    return mapped;
+}
+
+static void reduce_sum_callback(void *acc, const p_record record, int index, const p_dictionary dict) {
+    *(intptr_t *)acc += (intptr_t)record->value;
+}
+
+static void collect_record_callback(char *key, void *value, void *args) {
+    if (args)
+        add_record_to_dictionary((p_dictionary)args, key, value);
+}
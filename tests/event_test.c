@@ -34,6 +34,9 @@ static void event_test_callback(void *args, void *captured_args);
 /** @brief Send notification. */
 int event_notify_OK(void);
 
+/** @brief Send notification to a subscriber with a name longer than the key buffer. */
+int event_longName_OK(void);
+
 /*********************************************************************************************
  * FUNCTIONS DEFINITIONS
  ********************************************************************************************/
@@ -42,6 +45,7 @@ int event_test(int argc, char *argv[]) {
     int exit_result = 0;
 
     exit_result |= event_notify_OK();
+    exit_result |= event_longName_OK();
 
     return exit_result;
 }
@@ -59,6 +63,20 @@ int event_notify_OK(void) {
     return ORDER_RESULT(result, 0);
 }
 
+int event_longName_OK(void) {
+    char context[1024];
+    memset(context, 'c', sizeof(context) - 1);
+    context[sizeof(context) - 1] = '\0';
+    char actual[10] = {0};
+    subscribe_with_args(context, "test", event_test_callback, actual);
+
+    notify(context, "test", NULL);
+    unsubscribe(context, "test", event_test_callback);
+
+    const int result = is_equal("testValue", actual);
+    return ORDER_RESULT(result, 1);
+}
+
 /***********************************************************************************************
  * STATIC FUNCTIONS DEFINITIONS
  **********************************************************************************************/
@@ -12,6 +12,7 @@
 
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 #include <hashmap.h>
 
@@ -36,12 +37,24 @@ static str_type_t str_arr[5] = {{.key = "firstKey", .val = "firstValue"},
                                 {.key = "fourthKey", .val = "fourthValue"},
                                 {.key = "fifthKey", .val = "fifthValue"}};
 
+static size_t sized_keys_total = 0;
+
+static uint64_t u64_keys_total = 0;
+
+static int ptr_keys_count = 0;
+
 /***********************************************************************************************
  * STATIC FUNCTIONS DECLARATIONS
  **********************************************************************************************/
 
 static void iterate_str_map_callback(p_key key, void *value);
 
+static void iterate_sized_map_callback(p_key key, size_t ksize, void *value);
+
+static void iterate_u64_map_callback(uint64_t key, void *value);
+
+static void iterate_ptr_map_callback(const void *key, void *value);
+
 /*********************************************************************************************
  * FUNCTIONS DECLARATIONS
  ********************************************************************************************/
@@ -81,6 +94,41 @@ int hashmap_getCount_OK(void);
  */
 int hashmap_iterateCallback_OK(void);
 
+/**
+ * @brief Check hashmap collection with many entries, removals and resizes.
+ * 
+ * @return Error code.
+ */
+int hashmap_manyEntries_OK(void);
+
+/**
+ * @brief Check hashmap collection under sustained insert and remove churn.
+ * 
+ * @return Error code.
+ */
+int hashmap_churn_OK(void);
+
+/**
+ * @brief Check hashmap collection with sized binary keys.
+ * 
+ * @return Error code.
+ */
+int hashmap_sizedKeys_OK(void);
+
+/**
+ * @brief Check integer key hashmap under insert and remove churn.
+ * 
+ * @return Error code.
+ */
+int hashmap_u64Keys_OK(void);
+
+/**
+ * @brief Check pointer key hashmap.
+ * 
+ * @return Error code.
+ */
+int hashmap_ptrKeys_OK(void);
+
 /*********************************************************************************************
  * FUNCTIONS DEFINITIONS
  ********************************************************************************************/
@@ -92,11 +140,17 @@ int hashmap_test(int argc, char *argv[]) {
     exit_result |= hashmap_removeStrValue_OK();
     exit_result |= hashmap_removeAllEntries_OK();
     exit_result |= hashmap_getCount_OK();
+    exit_result |= hashmap_manyEntries_OK();
+    exit_result |= hashmap_churn_OK();
+    exit_result |= hashmap_sizedKeys_OK();
+    exit_result |= hashmap_u64Keys_OK();
+    exit_result |= hashmap_ptrKeys_OK();
     /* SEGFAULT */
     /* FIXME: fix hashmap with callback functions */
     // exit_result |= hashmap_iterateCallback_OK(); 
 
-    return exit_result;
+    // Failures of bits 8 and up would be lost in the 8-bit exit status.
+    return exit_result != 0;
 }
 
 int hashmap_getStrValidValue_OK(void) {
@@ -201,6 +255,190 @@ int hashmap_iterateCallback_OK(void) {
     return ORDER_RESULT(result, 5);
 }
 
+int hashmap_manyEntries_OK(void) {
+    static char keys[5000][16];
+    p_hashmap map = hashmap_create();
+
+    for (int i = 0; i < 5000; i++) {
+        sprintf(keys[i], "key%d", i);
+        hashmap_set_entry(map, keys[i], keys[i]);
+    }
+
+    for (int i = 0; i < 5000; i += 2) {
+        hashmap_remove_entry(map, keys[i]);
+    }
+
+    int result = hashmap_get_count(map) == 2500;
+
+    for (int i = 0; i < 5000; i++) {
+        const char *actual = hashmap_get_entry(map, keys[i]);
+        result &= i % 2 ? actual == keys[i] : actual == NULL;
+    }
+
+    // Removed keys are set again into empty buckets.
+    for (int i = 0; i < 5000; i += 4) {
+        hashmap_set_entry(map, keys[i], keys[4999 - i]);
+    }
+
+    result &= hashmap_get_count(map) == 3750;
+    result &= hashmap_get_entry(map, "key0") == keys[4999];
+    result &= hashmap_get_entry(map, "key2") == NULL;
+    result &= hashmap_get_entry(map, "key") == NULL;
+
+    hashmap_remove(&map);
+
+    return ORDER_RESULT(result, 6);
+}
+
+int hashmap_churn_OK(void) {
+    static char keys[2000][16];
+    static char present[2000];
+    p_hashmap map = hashmap_create();
+    int count = 0;
+
+    for (int i = 0; i < 2000; i++) {
+        sprintf(keys[i], "churn%d", i);
+        present[i] = 0;
+    }
+
+    // Mirror random insertions and removals of a bounded key set.
+    srand(11);
+    for (int i = 0; i < 200000; i++) {
+        int key = rand() % 2000;
+        if (present[key]) {
+            hashmap_remove_entry(map, keys[key]);
+            present[key] = 0;
+            --count;
+        } else {
+            hashmap_set_entry(map, keys[key], keys[key]);
+            present[key] = 1;
+            ++count;
+        }
+    }
+
+    int result = hashmap_get_count(map) == count;
+
+    for (int i = 0; i < 2000; i++) {
+        const char *actual = hashmap_get_entry(map, keys[i]);
+        result &= present[i] ? actual == keys[i] : actual == NULL;
+    }
+
+    hashmap_remove(&map);
+
+    return ORDER_RESULT(result, 7);
+}
+
+int hashmap_sizedKeys_OK(void) {
+    // Packed tuples with embedded zero bytes differ only after the first NUL.
+    static const uint32_t tuples[4][2] = {{0, 1}, {0, 2}, {7, 0}, {7, 0x100}};
+    p_hashmap map = hashmap_create();
+
+    for (int i = 0; i < 4; i++) {
+        hashmap_set_entry_n(map, tuples[i], sizeof(tuples[i]), (void *)tuples[i]);
+    }
+
+    int result = hashmap_get_count(map) == 4;
+
+    for (int i = 0; i < 4; i++) {
+        result &= hashmap_get_entry_n(map, tuples[i], sizeof(tuples[i])) == tuples[i];
+    }
+
+    // Prefix of a key is a different key.
+    result &= hashmap_get_entry_n(map, tuples[2], sizeof(uint32_t)) == NULL;
+
+    // String keys are sized keys without the terminating NUL.
+    hashmap_set_entry(map, "firstKey", "firstValue");
+    result &= is_equal(hashmap_get_entry_n(map, "firstKey!", 8), "firstValue");
+    hashmap_remove_entry_n(map, "firstKey", 8);
+    result &= hashmap_get_entry(map, "firstKey") == NULL;
+
+    hashmap_remove_entry_n(map, tuples[1], sizeof(tuples[1]));
+    result &= hashmap_get_entry_n(map, tuples[1], sizeof(tuples[1])) == NULL;
+
+    hashmap_iterate_n(map, iterate_sized_map_callback);
+    result &= sized_keys_total == 3 * sizeof(tuples[0]) && hashmap_get_count(map) == 3;
+
+    hashmap_remove(&map);
+
+    return ORDER_RESULT(result, 8);
+}
+
+int hashmap_u64Keys_OK(void) {
+    static char present[2000];
+    p_hashmap_u64 map = hashmap_u64_create();
+    int count = 0;
+
+    memset(present, 0, sizeof(present));
+
+    // Keys are multiples of a page size, as aligned addresses and sparse ids are.
+    srand(13);
+    for (int i = 0; i < 200000; i++) {
+        int key = rand() % 2000;
+        if (present[key]) {
+            hashmap_u64_remove_entry(map, (uint64_t)key << 12);
+            present[key] = 0;
+            --count;
+        } else {
+            hashmap_u64_set_entry(map, (uint64_t)key << 12, &present[key]);
+            present[key] = 1;
+            ++count;
+        }
+    }
+
+    int result = hashmap_u64_get_count(map) == count;
+
+    uint64_t expected_total = 0;
+    for (int i = 0; i < 2000; i++) {
+        void *actual = hashmap_u64_get_entry(map, (uint64_t)i << 12);
+        result &= present[i] ? actual == &present[i] : actual == NULL;
+        expected_total += present[i] ? (uint64_t)i << 12 : 0;
+    }
+
+    hashmap_u64_iterate(map, iterate_u64_map_callback);
+    result &= u64_keys_total == expected_total;
+
+    // Zero and the largest key are ordinary keys.
+    hashmap_u64_remove_all_entries(map);
+    hashmap_u64_set_entry(map, 0, "zero");
+    hashmap_u64_set_entry(map, UINT64_MAX, "max");
+    hashmap_u64_set_entry(map, 0, "null");
+    result &= hashmap_u64_get_count(map) == 2;
+    result &= is_equal(hashmap_u64_get_entry(map, 0), "null");
+    result &= is_equal(hashmap_u64_get_entry(map, UINT64_MAX), "max");
+    result &= hashmap_u64_get_entry(map, 1) == NULL;
+
+    hashmap_u64_remove(&map);
+    result &= map == NULL;
+
+    return ORDER_RESULT(result, 9);
+}
+
+int hashmap_ptrKeys_OK(void) {
+    p_hashmap_ptr map = hashmap_ptr_create();
+
+    for (int i = 0; i < 5; i++) {
+        hashmap_ptr_set_entry(map, &str_arr[i], str_arr[i].val);
+    }
+
+    int result = hashmap_ptr_get_count(map) == 5;
+    result &= is_equal(hashmap_ptr_get_entry(map, &str_arr[2]), "thirdValue");
+
+    // Keys are addresses, equal strings at another address are another key.
+    char key[] = "firstKey";
+    result &= hashmap_ptr_get_entry(map, key) == NULL;
+
+    hashmap_ptr_remove_entry(map, &str_arr[0]);
+    result &= hashmap_ptr_get_entry(map, &str_arr[0]) == NULL;
+
+    hashmap_ptr_iterate(map, iterate_ptr_map_callback);
+    result &= ptr_keys_count == 4 && hashmap_ptr_get_count(map) == 4;
+
+    hashmap_ptr_remove(&map);
+    result &= map == NULL;
+
+    return ORDER_RESULT(result, 10);
+}
+
 /***********************************************************************************************
  * STATIC FUNCTIONS DEFINITIONS
  **********************************************************************************************/
@@ -214,4 +452,20 @@ static void iterate_str_map_callback(p_key key, void *value) {
         // sprintf(value, "%s", test);
         str[0] = 'H';
     }
-}
\ No newline at end of file
+}
+
+static void iterate_sized_map_callback(p_key key, size_t ksize, void *value) {
+    sized_keys_total += ksize;
+}
+
+static void iterate_u64_map_callback(uint64_t key, void *value) {
+    u64_keys_total += key;
+}
+
+static void iterate_ptr_map_callback(const void *key, void *value) {
+    str_type_t *entry = (str_type_t *)key;
+
+    if (entry->val == value) {
+        ++ptr_keys_count;
+    }
+}
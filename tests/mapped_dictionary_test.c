@@ -0,0 +1,244 @@
+/**
+ * @file mapped_dictionary.test.c
+ * @author chcp (cmewhou@yandex.ru)
+ * @brief Mapped dictionary tests
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#include "utils/helper.h"
+
+#include <mapped_dictionary.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/*********************************************************************************************
+ * MACROS DECLARATIONS
+ ********************************************************************************************/
+
+#define MAPPED_TEST_PATH "mapped_dictionary_test.bin"
+#define MAPPED_TEST_RECORDS 1000
+#define MAPPED_TEST_HEADER_SIZE 32
+#define MAPPED_TEST_RECORD_HEADER_SIZE 16
+
+/*********************************************************************************************
+ * STRUCTS DECLARATIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Fixed-size test value.
+ */
+typedef struct point_s {
+    int64_t x; // X coordinate.
+    int64_t y; // Y coordinate.
+} point_t;
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ **********************************************************************************************/
+
+/**
+ * @brief Get size of string value with terminator.
+ *
+ * @param record Record.
+ * @return Value size.
+ */
+static size_t string_size_callback(const p_record record);
+
+/**
+ * @brief Sum x coordinates of points.
+ *
+ * @param key Record key.
+ * @param value Record value.
+ * @param args Sum.
+ */
+static void sum_points_callback(char *key, void *value, void *args);
+
+/**
+ * @brief Overwrite bytes of test file.
+ *
+ * @param position File position.
+ * @param bytes Bytes.
+ * @param size Count of bytes.
+ */
+static void patch_file(long position, const void *bytes, size_t size);
+
+/**
+ * @brief Check that the first record of test file is rejected.
+ *
+ * @return 1 if it is rejected, 0 otherwise.
+ */
+static int is_first_record_rejected(void);
+
+/*********************************************************************************************
+ * FUNCTIONS DECLARATIONS
+ ********************************************************************************************/
+
+/** @brief Fixed-size values survive save and load test. */
+int mapped_dictionary_fixedValues_OK(void);
+
+/** @brief Length-prefixed values and duplicate keys test. */
+int mapped_dictionary_sizedValues_OK(void);
+
+/** @brief Corrupt offsets and lengths are rejected test. */
+int mapped_dictionary_corruptRecords_OK(void);
+
+/*********************************************************************************************
+ * FUNCTIONS DEFINITIONS
+ ********************************************************************************************/
+
+int mapped_dictionary_test(int argc, char *argv[]) {
+    int exit_result = 0;
+
+    exit_result |= mapped_dictionary_fixedValues_OK();
+    exit_result |= mapped_dictionary_sizedValues_OK();
+    exit_result |= mapped_dictionary_corruptRecords_OK();
+
+    remove(MAPPED_TEST_PATH);
+    return exit_result;
+}
+
+int mapped_dictionary_fixedValues_OK(void) {
+    static char keys[MAPPED_TEST_RECORDS][16];
+    static point_t points[MAPPED_TEST_RECORDS];
+    p_dictionary dictionary = create_dictionary();
+    for (int i = 0; i < MAPPED_TEST_RECORDS; i++) {
+        sprintf(keys[i], "point%d", i);
+        points[i] = (point_t){.x = i, .y = -i};
+        add_record_to_dictionary(dictionary, keys[i], &points[i]);
+    }
+
+    int result = save_dictionary(dictionary, MAPPED_TEST_PATH, sizeof(point_t)) == 0;
+    delete_dictionary(dictionary);
+
+    p_mapped_dictionary mapped = load_dictionary(MAPPED_TEST_PATH);
+    result &= mapped && get_mapped_dictionary_size(mapped) == MAPPED_TEST_RECORDS;
+
+    size_t length = 0;
+    const point_t *point = get_value_from_mapped_dictionary(mapped, "point777", &length);
+    result &= point && point->x == 777 && point->y == -777 && length == sizeof(point_t);
+    result &= get_value_from_mapped_dictionary(mapped, "point1000", NULL) == NULL;
+
+    record_t record;
+    result &= get_record_from_mapped_dictionary_by_index(mapped, 42, &record, NULL) == 0;
+    result &= is_equal(record.key, "point42") && ((const point_t *)record.value)->y == -42;
+    result &= get_record_from_mapped_dictionary_by_index(mapped, MAPPED_TEST_RECORDS, &record, NULL) ==
+              IPEE_ERROR_CODE__MAPPED_DICTIONARY__INDEX_OUT_OF_RANGE;
+
+    int64_t sum = 0;
+    iterate_over_mapped_dictionary_with_args(mapped, sum_points_callback, &sum);
+    result &= sum == (int64_t)MAPPED_TEST_RECORDS * (MAPPED_TEST_RECORDS - 1) / 2;
+    unload_dictionary(mapped);
+
+    return ORDER_RESULT(result, 0);
+}
+
+int mapped_dictionary_sizedValues_OK(void) {
+    p_dictionary dictionary = create_dictionary();
+    add_record_to_dictionary(dictionary, "name", "first");
+    add_record_to_dictionary(dictionary, "", "empty key");
+    add_record_to_dictionary(dictionary, "name", "second");
+    add_record_to_dictionary(dictionary, "description", "a longer value that spans several blocks");
+
+    int result = save_dictionary_with_sizes(dictionary, MAPPED_TEST_PATH, string_size_callback) == 0;
+    delete_dictionary(dictionary);
+
+    p_mapped_dictionary mapped = load_dictionary(MAPPED_TEST_PATH);
+    size_t length = 0;
+    result &= mapped && get_mapped_dictionary_size(mapped) == 4;
+    result &= is_equal(get_value_from_mapped_dictionary(mapped, "name", &length), "first") && length == 6;
+    result &= is_equal(get_value_from_mapped_dictionary(mapped, "", NULL), "empty key");
+
+    record_t record;
+    get_record_from_mapped_dictionary_by_index(mapped, 2, &record, NULL);
+    result &= is_equal(record.key, "name") && is_equal(record.value, "second");
+    get_record_from_mapped_dictionary_by_index(mapped, 3, &record, &length);
+    result &= is_equal(record.value, "a longer value that spans several blocks") && length == 41;
+    unload_dictionary(mapped);
+
+    // File that is not a dictionary file is rejected.
+    FILE *file = fopen(MAPPED_TEST_PATH, "wb");
+    fputs("definitely not a dictionary file", file);
+    fclose(file);
+    result &= load_dictionary(MAPPED_TEST_PATH) == NULL;
+    result &= load_dictionary("missing_" MAPPED_TEST_PATH) == NULL;
+
+    return ORDER_RESULT(result, 1);
+}
+
+int mapped_dictionary_corruptRecords_OK(void) {
+    p_dictionary dictionary = create_dictionary();
+    add_record_to_dictionary(dictionary, "name", "value");
+
+    int result = save_dictionary_with_sizes(dictionary, MAPPED_TEST_PATH, string_size_callback) == 0;
+    delete_dictionary(dictionary);
+
+    // The only record follows the header, its offset and the hash table of two buckets.
+    const uint64_t offset = MAPPED_TEST_HEADER_SIZE + sizeof(uint64_t) + 2 * sizeof(uint32_t);
+    const long value_length_position = (long)offset + MAPPED_TEST_RECORD_HEADER_SIZE - sizeof(uint64_t);
+    result &= !is_first_record_rejected();
+
+    // Offset near the end of the address space would wrap around the bounds check.
+    const uint64_t far_offset = UINT64_MAX - 7;
+    patch_file(MAPPED_TEST_HEADER_SIZE, &far_offset, sizeof(far_offset));
+    result &= is_first_record_rejected();
+
+    const uint64_t misaligned_offset = offset + 1;
+    patch_file(MAPPED_TEST_HEADER_SIZE, &misaligned_offset, sizeof(misaligned_offset));
+    result &= is_first_record_rejected();
+    patch_file(MAPPED_TEST_HEADER_SIZE, &offset, sizeof(offset));
+
+    // Value length which wraps the end of the record around.
+    const uint64_t huge_length = UINT64_MAX - 15;
+    patch_file(value_length_position, &huge_length, sizeof(huge_length));
+    result &= is_first_record_rejected();
+
+    const uint64_t length = 6;
+    patch_file(value_length_position, &length, sizeof(length));
+    result &= !is_first_record_rejected();
+
+    // Key without terminator.
+    patch_file((long)offset + MAPPED_TEST_RECORD_HEADER_SIZE + strlen("name"), "!", 1);
+    result &= is_first_record_rejected();
+
+    return ORDER_RESULT(result, 2);
+}
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DEFINITIONS
+ **********************************************************************************************/
+
+static size_t string_size_callback(const p_record record) {
+    return strlen(record->value) + 1;
+}
+
+static void sum_points_callback(char *key, void *value, void *args) {
+    *(int64_t *)args += ((const point_t *)value)->x;
+}
+
+static void patch_file(long position, const void *bytes, size_t size) {
+    FILE *file = fopen(MAPPED_TEST_PATH, "r+b");
+    if (!file)
+        return;
+
+    fseek(file, position, SEEK_SET);
+    fwrite(bytes, 1, size, file);
+    fclose(file);
+}
+
+static int is_first_record_rejected(void) {
+    p_mapped_dictionary mapped = load_dictionary(MAPPED_TEST_PATH);
+    if (!mapped)
+        return 0;
+
+    record_t record;
+    int rejected = get_record_from_mapped_dictionary_by_index(mapped, 0, &record, NULL) ==
+                   IPEE_ERROR_CODE__MAPPED_DICTIONARY__INVALID_FORMAT;
+    rejected &= get_value_from_mapped_dictionary(mapped, "name", NULL) == NULL;
+    unload_dictionary(mapped);
+    return rejected;
+}
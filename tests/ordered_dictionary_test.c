@@ -0,0 +1,155 @@
+/**
+ * @file ordered_dictionary.test.c
+ * @author chcp (cmewhou@yandex.ru)
+ * @brief Ordered dictionary tests
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#include "utils/helper.h"
+
+#include <ordered_dictionary.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/*********************************************************************************************
+ * MACROS DECLARATIONS
+ ********************************************************************************************/
+
+#define ORDERED_TEST_KEYS 1000
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ **********************************************************************************************/
+
+/**
+ * @brief Check that keys come in strictly increasing order.
+ *
+ * @param key Record key.
+ * @param value Record value.
+ * @param args Previous key.
+ */
+static void check_order_callback(char *key, void *value, void *args);
+
+/**
+ * @brief Append record key to a string.
+ *
+ * @param key Record key.
+ * @param value Record value.
+ * @param args String buffer.
+ */
+static void append_key_callback(char *key, void *value, void *args);
+
+/*********************************************************************************************
+ * FUNCTIONS DECLARATIONS
+ ********************************************************************************************/
+
+/** @brief Ordered dictionary lookup, replacement and removal test. */
+int ordered_dictionary_lookupOrder_OK(void);
+
+/** @brief Ordered dictionary bounds, range and prefix queries test. */
+int ordered_dictionary_rangeQueries_OK(void);
+
+/*********************************************************************************************
+ * FUNCTIONS DEFINITIONS
+ ********************************************************************************************/
+
+int ordered_dictionary_test(int argc, char *argv[]) {
+    int exit_result = 0;
+
+    exit_result |= ordered_dictionary_lookupOrder_OK();
+    exit_result |= ordered_dictionary_rangeQueries_OK();
+
+    return exit_result;
+}
+
+int ordered_dictionary_lookupOrder_OK(void) {
+    static char keys[ORDERED_TEST_KEYS][8];
+    p_ordered_dictionary dictionary = create_ordered_dictionary();
+
+    // Keys are inserted in a scrambled order.
+    for (int i = 0; i < ORDERED_TEST_KEYS; i++) {
+        int k = (i * 7919) % ORDERED_TEST_KEYS;
+        sprintf(keys[k], "k%04d", k);
+        add_record_to_ordered_dictionary(dictionary, keys[k], (void *)(intptr_t)k);
+    }
+    add_record_to_ordered_dictionary(dictionary, keys[500], (void *)-1);
+
+    int result = get_ordered_dictionary_size(dictionary) == ORDERED_TEST_KEYS;
+    result &= get_value_from_ordered_dictionary(dictionary, "k0777") == (void *)777;
+    result &= get_value_from_ordered_dictionary(dictionary, "k0500") == (void *)-1;
+    result &= get_value_from_ordered_dictionary(dictionary, "k1000") == NULL;
+
+    for (int i = 2; i < ORDERED_TEST_KEYS; i += 2)
+        result &= remove_record_from_ordered_dictionary(dictionary, keys[i]) == (void *)(intptr_t)(i == 500 ? -1 : i);
+    remove_record_from_ordered_dictionary(dictionary, "k0000");
+    result &= get_record_from_ordered_dictionary(dictionary, "k0000") == NULL;
+    result &= get_ordered_dictionary_size(dictionary) == ORDERED_TEST_KEYS / 2;
+    result &= is_equal(get_first_record_from_ordered_dictionary(dictionary)->key, "k0001");
+
+    const char *previous = "";
+    iterate_over_ordered_dictionary_with_args(dictionary, check_order_callback, &previous);
+    result &= previous && is_equal(previous, "k0999");
+    delete_ordered_dictionary(dictionary);
+
+    return ORDER_RESULT(result, 0);
+}
+
+int ordered_dictionary_rangeQueries_OK(void) {
+    p_ordered_dictionary dictionary = create_ordered_dictionary();
+    char *keys[] = {"threadpool_on_complete_1", "container_service_a", "threadpool_on_start_1",
+                    "threadpool_on_complete_2", "threadpool_on_complete_10", "zeta"};
+    for (int i = 0; i < (int)(sizeof(keys) / sizeof(keys[0])); i++)
+        add_record_to_ordered_dictionary(dictionary, keys[i], (void *)(intptr_t)i);
+
+    char buffer[256] = {0};
+    int count = iterate_over_ordered_dictionary_prefix_with_args(
+        dictionary, "threadpool_on_complete_", append_key_callback, buffer);
+    int result = count == 3;
+    result &= is_equal(buffer, "threadpool_on_complete_1 threadpool_on_complete_10 threadpool_on_complete_2 ");
+
+    result &= is_equal(lower_bound_in_ordered_dictionary(dictionary, "threadpool_on_start_1")->key,
+                       "threadpool_on_start_1");
+    result &= is_equal(upper_bound_in_ordered_dictionary(dictionary, "threadpool_on_start_1")->key, "zeta");
+    result &= is_equal(lower_bound_in_ordered_dictionary(dictionary, "a")->key, "container_service_a");
+    result &= lower_bound_in_ordered_dictionary(dictionary, "zz") == NULL;
+    result &= get_next_ordered_record(lower_bound_in_ordered_dictionary(dictionary, "zeta")) == NULL;
+
+    buffer[0] = '\0';
+    count = iterate_over_ordered_dictionary_range_with_args(
+        dictionary, "container", "threadpool_on_complete_2", append_key_callback, buffer);
+    result &= count == 3;
+    result &= is_equal(buffer, "container_service_a threadpool_on_complete_1 threadpool_on_complete_10 ");
+    result &= iterate_over_ordered_dictionary_range_with_args(
+                  dictionary, "threadpool", NULL, append_key_callback, buffer) == 5;
+    result &= iterate_over_ordered_dictionary_prefix_with_args(
+                  dictionary, "missing", append_key_callback, buffer) == 0;
+    result &= iterate_over_ordered_dictionary_prefix_with_args(dictionary, NULL, append_key_callback, buffer) ==
+              IPEE_ERROR_CODE__ORDERED_DICTIONARY__NOT_EXISTS;
+    buffer[0] = '\0';
+    result &= iterate_over_ordered_dictionary_prefix_with_args(dictionary, "", append_key_callback, buffer) == 6;
+    delete_ordered_dictionary(dictionary);
+
+    return ORDER_RESULT(result, 1);
+}
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DEFINITIONS
+ **********************************************************************************************/
+
+static void check_order_callback(char *key, void *value, void *args) {
+    const char **previous = (const char **)args;
+    if (*previous && strcmp(*previous, key) < 0)
+        *previous = key;
+    else
+        *previous = NULL;
+}
+
+static void append_key_callback(char *key, void *value, void *args) {
+    strcat((char *)args, key);
+    strcat((char *)args, " ");
+}
@@ -0,0 +1,187 @@
+/**
+ * @file parallel_dictionary.test.c
+ * @author chcp (cmewhou@yandex.ru)
+ * @brief Parallel dictionary tests
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#include "utils/helper.h"
+
+#include <parallel_dictionary.h>
+#include <threadpool.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/*********************************************************************************************
+ * STRUCTS DECLARATIONS
+ ********************************************************************************************/
+
+/**
+ * @brief Decimal number with its scale.
+ *
+ * @details
+ * Concatenation of digits is associative but not commutative, so it checks
+ * that chunk accumulators are combined in order.
+ */
+typedef struct digits_s {
+    uint64_t number; // Number modulo a prime.
+    uint64_t scale;  // 10 raised to count of digits modulo a prime.
+} digits_t;
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ **********************************************************************************************/
+
+/**
+ * @brief Map record to record with doubled value.
+ *
+ * @param record Record.
+ * @param index Record index.
+ * @param dict Dictionary.
+ * @return Mapped record in thread local storage.
+ */
+static p_record map_double_callback(const p_record record, int index, const p_dictionary dict);
+
+/**
+ * @brief Filter records with values divisible by three.
+ *
+ * @param record Record.
+ * @param index Record index.
+ * @param dict Dictionary.
+ * @return 1 if value is divisible by three, 0 otherwise.
+ */
+static int filter_triple_callback(const p_record record, int index, const p_dictionary dict);
+
+/**
+ * @brief Append record value to a decimal number.
+ *
+ * @param acc Accumulator.
+ * @param record Record.
+ * @param index Record index.
+ * @param dict Dictionary.
+ */
+static void reduce_digits_callback(void *acc, const p_record record, int index, const p_dictionary dict);
+
+/**
+ * @brief Combine decimal numbers with their digit counts.
+ *
+ * @param acc Accumulator.
+ * @param chunk_acc Accumulator of a chunk.
+ */
+static void combine_digits_callback(void *acc, const void *chunk_acc);
+
+/*********************************************************************************************
+ * FUNCTIONS DECLARATIONS
+ ********************************************************************************************/
+
+/** @brief Parallel map keeps order test. */
+int parallel_dictionary_mapOrdered_OK(void);
+
+/** @brief Parallel filter keeps order test. */
+int parallel_dictionary_filterOrdered_OK(void);
+
+/** @brief Parallel reduce combines chunks in order test. */
+int parallel_dictionary_reduceCombined_OK(void);
+
+/*********************************************************************************************
+ * FUNCTIONS DEFINITIONS
+ ********************************************************************************************/
+
+int parallel_dictionary_test(int argc, char *argv[]) {
+    int exit_result = 0;
+    set_threadpool_size(4);
+    init_thread_pool();
+
+    exit_result |= parallel_dictionary_mapOrdered_OK();
+    exit_result |= parallel_dictionary_filterOrdered_OK();
+    exit_result |= parallel_dictionary_reduceCombined_OK();
+
+    destroy_thread_pool();
+    return exit_result;
+}
+
+int parallel_dictionary_mapOrdered_OK(void) {
+    p_dictionary dictionary = create_dictionary();
+    for (int i = 0; i < 1000; i++)
+        add_record_to_dictionary(dictionary, "key", (void *)(intptr_t)i);
+
+    p_dictionary mapped = parallel_map_dictionary(dictionary, map_double_callback);
+
+    int result = mapped && mapped->size == 1000;
+    p_record record = mapped ? mapped->head : NULL;
+    for (int i = 0; record; i++, record = record->next)
+        result &= record->value == (void *)(intptr_t)(2 * i);
+    delete_dictionary(mapped);
+    delete_dictionary(dictionary);
+
+    return ORDER_RESULT(result, 0);
+}
+
+int parallel_dictionary_filterOrdered_OK(void) {
+    p_dictionary dictionary = create_dictionary();
+    for (int i = 0; i < 1000; i++)
+        add_record_to_dictionary(dictionary, "key", (void *)(intptr_t)i);
+
+    p_dictionary filtered = parallel_filter_dictionary(dictionary, filter_triple_callback);
+
+    int result = filtered && filtered->size == 334;
+    p_record record = filtered ? filtered->head : NULL;
+    for (int i = 0; record; i++, record = record->next)
+        result &= record->value == (void *)(intptr_t)(3 * i);
+    delete_dictionary(filtered);
+    delete_dictionary(dictionary);
+
+    return ORDER_RESULT(result, 1);
+}
+
+int parallel_dictionary_reduceCombined_OK(void) {
+    p_dictionary dictionary = create_dictionary();
+    for (int i = 0; i < 1000; i++)
+        add_record_to_dictionary(dictionary, "key", (void *)(intptr_t)(i % 10));
+
+    digits_t expected = {.number = 0, .scale = 1};
+    const digits_t identity = {.number = 0, .scale = 1};
+    for (int i = 0; i < 1000; i++)
+        reduce_digits_callback(&expected, get_record_from_dictionary_by_index(dictionary, i), i, dictionary);
+
+    digits_t actual = identity;
+    parallel_reduce_dictionary(
+        dictionary, reduce_digits_callback, combine_digits_callback, &actual, sizeof(digits_t), &identity);
+
+    const int result = actual.number == expected.number && actual.scale == expected.scale;
+    delete_dictionary(dictionary);
+
+    return ORDER_RESULT(result, 2);
+}
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DEFINITIONS
+ **********************************************************************************************/
+
+static p_record map_double_callback(const p_record record, int index, const p_dictionary dict) {
+    static _Thread_local record_t mapped;
+    mapped.key = record->key;
+    mapped.value = (void *)((intptr_t)record->value * 2);
+    return &mapped;
+}
+
+static int filter_triple_callback(const p_record record, int index, const p_dictionary dict) {
+    return (intptr_t)record->value % 3 == 0;
+}
+
+static void reduce_digits_callback(void *acc, const p_record record, int index, const p_dictionary dict) {
+    digits_t *digits = (digits_t *)acc;
+    digits->number = (digits->number * 10 + (intptr_t)record->value) % 1000000007u;
+    digits->scale = digits->scale * 10 % 1000000007u;
+}
+
+static void combine_digits_callback(void *acc, const void *chunk_acc) {
+    digits_t *digits = (digits_t *)acc;
+    const digits_t *chunk_digits = (const digits_t *)chunk_acc;
+    digits->number = (digits->number * chunk_digits->scale + chunk_digits->number) % 1000000007u;
+    digits->scale = digits->scale * chunk_digits->scale % 1000000007u;
+}
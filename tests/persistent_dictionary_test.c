@@ -0,0 +1,139 @@
+/**
+ * @file persistent_dictionary.test.c
+ * @author chcp (cmewhou@yandex.ru)
+ * @brief Persistent dictionary tests
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#include "utils/helper.h"
+
+#include <persistent_dictionary.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/*********************************************************************************************
+ * MACROS DECLARATIONS
+ ********************************************************************************************/
+
+#define PERSISTENT_TEST_KEYS 256
+#define PERSISTENT_TEST_SNAPSHOTS 8
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ **********************************************************************************************/
+
+/**
+ * @brief Append record key to a string.
+ *
+ * @param key Record key.
+ * @param value Record value.
+ * @param args String buffer.
+ */
+static void append_key_callback(char *key, void *value, void *args);
+
+/*********************************************************************************************
+ * FUNCTIONS DECLARATIONS
+ ********************************************************************************************/
+
+/** @brief Snapshot does not see later mutations test. */
+int persistent_dictionary_snapshotIsolated_OK(void);
+
+/** @brief Many snapshots of interleaved mutations test. */
+int persistent_dictionary_snapshotHistory_OK(void);
+
+/*********************************************************************************************
+ * FUNCTIONS DEFINITIONS
+ ********************************************************************************************/
+
+int persistent_dictionary_test(int argc, char *argv[]) {
+    int exit_result = 0;
+
+    exit_result |= persistent_dictionary_snapshotIsolated_OK();
+    exit_result |= persistent_dictionary_snapshotHistory_OK();
+
+    return exit_result;
+}
+
+int persistent_dictionary_snapshotIsolated_OK(void) {
+    p_persistent_dictionary dictionary = create_persistent_dictionary();
+    add_record_to_persistent_dictionary(dictionary, "b", (void *)2);
+    add_record_to_persistent_dictionary(dictionary, "a", (void *)1);
+    add_record_to_persistent_dictionary(dictionary, "c", (void *)3);
+
+    p_dictionary_snapshot snapshot = snapshot_dictionary(dictionary);
+    add_record_to_persistent_dictionary(dictionary, "a", (void *)10);
+    add_record_to_persistent_dictionary(dictionary, "d", (void *)4);
+    int result = remove_record_from_persistent_dictionary(dictionary, "b") == (void *)2;
+    result &= remove_record_from_persistent_dictionary(dictionary, "missing") == NULL;
+
+    result &= get_value_from_dictionary_snapshot(snapshot, "a") == (void *)1;
+    result &= get_value_from_dictionary_snapshot(snapshot, "b") == (void *)2;
+    result &= get_value_from_dictionary_snapshot(snapshot, "d") == NULL;
+    result &= get_dictionary_snapshot_size(snapshot) == 3;
+    result &= get_value_from_persistent_dictionary(dictionary, "a") == (void *)10;
+    result &= get_value_from_persistent_dictionary(dictionary, "b") == NULL;
+    result &= get_persistent_dictionary_size(dictionary) == 3;
+
+    char keys[8] = {0};
+    iterate_over_dictionary_snapshot_with_args(snapshot, append_key_callback, keys);
+    result &= is_equal(keys, "abc");
+
+    // Snapshot outlives the dictionary.
+    delete_persistent_dictionary(dictionary);
+    result &= get_value_from_dictionary_snapshot(snapshot, "c") == (void *)3;
+    release_dictionary_snapshot(snapshot);
+
+    return ORDER_RESULT(result, 0);
+}
+
+int persistent_dictionary_snapshotHistory_OK(void) {
+    static char keys[PERSISTENT_TEST_KEYS][8];
+    for (int i = 0; i < PERSISTENT_TEST_KEYS; i++)
+        sprintf(keys[i], "k%03d", i);
+
+    // Round r sets every key to r + 1, then removes keys divisible by r + 2.
+    p_persistent_dictionary dictionary = create_persistent_dictionary();
+    p_dictionary_snapshot snapshots[PERSISTENT_TEST_SNAPSHOTS];
+    for (int round = 0; round < PERSISTENT_TEST_SNAPSHOTS; round++) {
+        for (int i = 0; i < PERSISTENT_TEST_KEYS; i++)
+            add_record_to_persistent_dictionary(dictionary, keys[i], (void *)(intptr_t)(round + 1));
+        for (int i = 0; i < PERSISTENT_TEST_KEYS; i += round + 2)
+            remove_record_from_persistent_dictionary(dictionary, keys[i]);
+        snapshots[round] = snapshot_dictionary(dictionary);
+    }
+
+    int result = 1;
+    for (int round = 0; round < PERSISTENT_TEST_SNAPSHOTS; round++) {
+        int size = 0;
+        for (int i = 0; i < PERSISTENT_TEST_KEYS; i++) {
+            void *expected = i % (round + 2) ? (void *)(intptr_t)(round + 1) : NULL;
+            result &= get_value_from_dictionary_snapshot(snapshots[round], keys[i]) == expected;
+            size += expected != NULL;
+        }
+        result &= get_dictionary_snapshot_size(snapshots[round]) == size;
+    }
+
+    // Release out of order, remaining snapshots stay intact.
+    for (int round = 0; round < PERSISTENT_TEST_SNAPSHOTS; round += 2)
+        release_dictionary_snapshot(snapshots[round]);
+    delete_persistent_dictionary(dictionary);
+    for (int round = 1; round < PERSISTENT_TEST_SNAPSHOTS; round += 2) {
+        result &= get_value_from_dictionary_snapshot(snapshots[round], keys[1]) == (void *)(intptr_t)(round + 1);
+        release_dictionary_snapshot(snapshots[round]);
+    }
+
+    return ORDER_RESULT(result, 1);
+}
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DEFINITIONS
+ **********************************************************************************************/
+
+static void append_key_callback(char *key, void *value, void *args) {
+    strcat((char *)args, key);
+}
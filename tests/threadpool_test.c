@@ -14,6 +14,14 @@
 
 #include <string.h>
 #include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+/*********************************************************************************************
+* STATIC VARIABLES
+********************************************************************************************/
+
+static volatile int hold_workers = 0;
 
 /***********************************************************************************************
 * STATIC FUNCTIONS DECLARATIONS
@@ -44,6 +52,14 @@ static void threadpool_complete_function_callback(void *result, void *args);
 */
 static void *threadpool_exceeding_callback(void *args);
 
+/**
+* @brief Task which keeps its thread busy while workers are held.
+* 
+* @param args Arguments.
+* @return Arguments.
+*/
+static void *threadpool_holding_callback(void *args);
+
 /*********************************************************************************************
 * FUNCTIONS DECLARATIONS
 ********************************************************************************************/
@@ -60,6 +76,9 @@ int threadpool_exceedingThreads_OK(void);
 /** @brief Threadpool test. */
 int threadpool_cancelTask_OK(void);
 
+/** @brief Threadpool test. */
+int threadpool_tryRunTask_OK(void);
+
 /*********************************************************************************************
 * FUNCTIONS DEFINITIONS
 ********************************************************************************************/
@@ -73,6 +92,7 @@ int threadpool_test(int argc, char *argv[]) {
     exit_result |= threadpool_onComplete_OK();
     exit_result |= threadpool_exceedingThreads_OK();
     exit_result |= threadpool_cancelTask_OK();
+    exit_result |= threadpool_tryRunTask_OK();
     
     destroy_thread_pool();
     return exit_result;
@@ -134,6 +154,29 @@ int threadpool_cancelTask_OK(void) {
     return ORDER_RESULT(1, 3);
 }
 
+int threadpool_tryRunTask_OK(void) {
+    p_task workers[4];
+
+    hold_workers = 1;
+    for (int i = 0; i < 4; i++)
+        workers[i] = run_task(make_task(threadpool_holding_callback, "held"));
+
+    // Every thread is busy, so the task is refused at once instead of waiting.
+    p_task task = make_task(threadpool_exceeding_callback, "actual");
+    time_t before = time(NULL);
+    int result = try_run_task(task) == NULL && time(NULL) - before < 2;
+    result &= release_task(task) == 0;
+
+    hold_workers = 0;
+    for (int i = 0; i < 4; i++)
+        result &= workers[i] && is_equal(await_task(workers[i]), "held");
+
+    task = make_task(threadpool_exceeding_callback, "actual");
+    result &= try_run_task(task) == task && is_equal(await_task(task), "actual");
+
+    return ORDER_RESULT(result, 4);
+}
+
 /***********************************************************************************************
 * STATIC FUNCTIONS DEFINITIONS
 **********************************************************************************************/
@@ -149,4 +192,10 @@ static void threadpool_complete_function_callback(void *result, void *args) {
 
 static void *threadpool_exceeding_callback(void *args) {
     return args;
-}
\ No newline at end of file
+}
+
+static void *threadpool_holding_callback(void *args) {
+    while (hold_workers)
+        usleep(1000);
+    return args;
+}
@@ -0,0 +1,200 @@
+/**
+ * @file unrolled_dictionary.test.c
+ * @author chcp (cmewhou@yandex.ru)
+ * @brief Unrolled dictionary tests
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#include "utils/helper.h"
+
+#include <unrolled_dictionary.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*********************************************************************************************
+ * MACROS DECLARATIONS
+ ********************************************************************************************/
+
+#define UNROLLED_TEST_RECORDS 1000
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ **********************************************************************************************/
+
+/**
+ * @brief Check that values are consecutive integers.
+ *
+ * @param value Record value.
+ * @param args Expected next value.
+ */
+static void check_order_callback(void *value, void *args);
+
+/**
+ * @brief Filter records with even values.
+ *
+ * @param record Record.
+ * @param index Record index.
+ * @param dict Unrolled dictionary.
+ * @return 1 if value is even, 0 otherwise.
+ */
+static int filter_even_callback(const p_record record, int index, const p_unrolled_dictionary dict);
+
+/**
+ * @brief Sum record values.
+ *
+ * @param acc Accumulator.
+ * @param record Record.
+ * @param index Record index.
+ * @param dict Unrolled dictionary.
+ */
+static void reduce_sum_callback(
+    void *acc, const p_record record, int index, const p_unrolled_dictionary dict);
+
+/*********************************************************************************************
+ * FUNCTIONS DECLARATIONS
+ ********************************************************************************************/
+
+/** @brief Unrolled dictionary append and ordered iteration test. */
+int unrolled_dictionary_appendIterate_OK(void);
+
+/** @brief Unrolled dictionary insertion and removal by index test. */
+int unrolled_dictionary_insertRemove_OK(void);
+
+/** @brief Unrolled dictionary keyed access, filter and reduce test. */
+int unrolled_dictionary_filterReduce_OK(void);
+
+/*********************************************************************************************
+ * FUNCTIONS DEFINITIONS
+ ********************************************************************************************/
+
+int unrolled_dictionary_test(int argc, char *argv[]) {
+    int exit_result = 0;
+
+    exit_result |= unrolled_dictionary_appendIterate_OK();
+    exit_result |= unrolled_dictionary_insertRemove_OK();
+    exit_result |= unrolled_dictionary_filterReduce_OK();
+
+    return exit_result;
+}
+
+int unrolled_dictionary_appendIterate_OK(void) {
+    p_unrolled_dictionary dictionary = create_unrolled_dictionary();
+    for (int i = 0; i < UNROLLED_TEST_RECORDS; i++)
+        add_record_to_unrolled_dictionary(dictionary, "key", (void *)(intptr_t)i);
+
+    // Appending fills every block before starting the next one.
+    int result = dictionary->size == UNROLLED_TEST_RECORDS;
+    result &= dictionary->nodes ==
+              (UNROLLED_TEST_RECORDS + UNROLLED_DICTIONARY_BLOCK_SIZE - 1) / UNROLLED_DICTIONARY_BLOCK_SIZE;
+
+    intptr_t expected = 0;
+    iterate_over_unrolled_dictionary_values_with_args(dictionary, check_order_callback, &expected);
+    result &= expected == UNROLLED_TEST_RECORDS;
+    result &= get_value_from_unrolled_dictionary_by_index(dictionary, 0) == (void *)0;
+    result &= get_value_from_unrolled_dictionary_by_index(dictionary, 517) == (void *)517;
+    result &= get_value_from_unrolled_dictionary_by_index(dictionary, UNROLLED_TEST_RECORDS - 1) ==
+              (void *)(UNROLLED_TEST_RECORDS - 1);
+    result &= get_value_from_unrolled_dictionary_by_index(dictionary, UNROLLED_TEST_RECORDS) == NULL;
+    delete_unrolled_dictionary(dictionary);
+
+    return ORDER_RESULT(result, 0);
+}
+
+int unrolled_dictionary_insertRemove_OK(void) {
+    static intptr_t reference[UNROLLED_TEST_RECORDS];
+    int size = 0;
+
+    // Mirror random insertions and removals in a plain array.
+    srand(7);
+    p_unrolled_dictionary dictionary = create_unrolled_dictionary();
+    for (int i = 0; i < 4 * UNROLLED_TEST_RECORDS; i++) {
+        if (size < UNROLLED_TEST_RECORDS && (size < 100 || rand() % 3)) {
+            int index = rand() % (size + 1);
+            memmove(&reference[index + 1], &reference[index], (size - index) * sizeof(intptr_t));
+            reference[index] = i;
+            size++;
+            add_record_to_unrolled_dictionary_by_index(dictionary, index, "key", (void *)(intptr_t)i);
+        } else {
+            int index = rand() % size;
+            void *removed = remove_record_from_unrolled_dictionary_by_index(dictionary, index);
+            if (removed != (void *)reference[index])
+                return ORDER_RESULT(0, 1);
+            memmove(&reference[index], &reference[index + 1], (size - index - 1) * sizeof(intptr_t));
+            size--;
+        }
+    }
+
+    int result = dictionary->size == size;
+    for (int i = 0; i < size; i++)
+        result &= get_value_from_unrolled_dictionary_by_index(dictionary, i) == (void *)reference[i];
+
+    // Nodes stay at least half full, except the tail.
+    int records = 0;
+    for (p_unrolled_dictionary_node node = dictionary->head; node; node = node->next) {
+        result &= node->count > 0 && node->count <= UNROLLED_DICTIONARY_BLOCK_SIZE;
+        result &= node == dictionary->tail || node->count >= UNROLLED_DICTIONARY_BLOCK_SIZE / 2 - 1;
+        records += node->count;
+    }
+    result &= records == size;
+
+    while (dictionary->size)
+        remove_record_from_unrolled_dictionary_by_index(dictionary, dictionary->size / 2);
+    result &= !dictionary->head && !dictionary->tail && dictionary->nodes == 0;
+    result &= add_record_to_unrolled_dictionary_by_index(dictionary, 1, "key", NULL) ==
+              IPEE_ERROR_CODE__UNROLLED_DICTIONARY__INDEX_OUT_OF_RANGE;
+    delete_unrolled_dictionary(dictionary);
+
+    return ORDER_RESULT(result, 1);
+}
+
+int unrolled_dictionary_filterReduce_OK(void) {
+    p_unrolled_dictionary dictionary = create_unrolled_dictionary();
+    add_record_to_unrolled_dictionary(dictionary, "secondKey", (void *)2);
+    add_record_to_unrolled_dictionary(dictionary, "thirdKey", (void *)3);
+    emplace_record_to_unrolled_dictionary(dictionary, "firstKey", (void *)1);
+    for (int i = 0; i < 40; i++)
+        add_record_to_unrolled_dictionary(dictionary, "filler", (void *)(intptr_t)(i + 4));
+
+    int result = get_index_from_unrolled_dictionary_by_key(dictionary, "thirdKey") == 2;
+    result &= is_equal(get_key_from_unrolled_dictionary_by_index(dictionary, 0), "firstKey");
+    result &= update_record_in_unrolled_dictionary(dictionary, "secondKey", (void *)20) == (void *)2;
+    result &= remove_record_from_unrolled_dictionary(dictionary, "firstKey") == (void *)1;
+    result &= get_value_from_unrolled_dictionary(dictionary, "secondKey") == (void *)20;
+    result &= !contains_key_in_unrolled_dictionary(dictionary, "firstKey");
+    result &= contains_value_in_unrolled_dictionary(dictionary, (void *)43);
+
+    p_unrolled_dictionary even = filter_unrolled_dictionary(dictionary, filter_even_callback);
+    intptr_t sum = 0;
+    reduce_unrolled_dictionary(even, reduce_sum_callback, &sum);
+
+    // Even values are 20 and 4, 6, ..., 42.
+    result &= even->size == 21 && sum == 20 + 460;
+    delete_unrolled_dictionary(even);
+    delete_unrolled_dictionary(dictionary);
+
+    return ORDER_RESULT(result, 2);
+}
+
+/***********************************************************************************************
+ * STATIC FUNCTIONS DEFINITIONS
+ **********************************************************************************************/
+
+static void check_order_callback(void *value, void *args) {
+    intptr_t *expected = (intptr_t *)args;
+    if ((intptr_t)value == *expected)
+        (*expected)++;
+}
+
+static int filter_even_callback(const p_record record, int index, const p_unrolled_dictionary dict) {
+    return ((intptr_t)record->value & 1) == 0;
+}
+
+static void reduce_sum_callback(
+    void *acc, const p_record record, int index, const p_unrolled_dictionary dict) {
+    *(intptr_t *)acc += (intptr_t)record->value;
+}